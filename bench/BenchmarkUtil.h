@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include "IReader.h"
+#include "fx/Loop.h"
+#include "util/Buffer.h"
+#include "util/StreamBuffer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+
+/**
+ * Creates deterministic white noise.
+ * \param specs The specification of the noise.
+ * \param length The length of the noise in samples.
+ * \return The noise buffer.
+ */
+inline std::shared_ptr<aud::StreamBuffer> createNoiseBuffer(aud::Specs specs, int length = 48000)
+{
+	auto buffer = std::make_shared<aud::Buffer>(length * specs.channels * sizeof(aud::sample_t));
+
+	std::mt19937 random(0);
+	std::uniform_real_distribution<float> distribution(-1, 1);
+
+	for(int i = 0; i < length * specs.channels; i++)
+		buffer->getBuffer()[i] = distribution(random);
+
+	return std::make_shared<aud::StreamBuffer>(buffer, specs);
+}
+
+/**
+ * Creates an endlessly looping sound of deterministic white noise.
+ * \param specs The specification of the noise.
+ * \return The noise sound.
+ */
+inline std::shared_ptr<aud::ISound> createNoise(aud::Specs specs)
+{
+	return std::make_shared<aud::Loop>(createNoiseBuffer(specs));
+}
+
+/**
+ * Reads blocks from a reader for every benchmark iteration and reports the
+ * processed sample frames as items.
+ * \param state The benchmark state.
+ * \param reader The reader to benchmark.
+ * \param blocksize The number of samples per read.
+ */
+inline void readBlocks(benchmark::State& state, aud::IReader& reader, int blocksize)
+{
+	aud::Buffer buffer(blocksize * reader.getSpecs().channels * sizeof(aud::sample_t));
+	int64_t samples = 0;
+
+	for(auto _ : state)
+	{
+		int length = blocksize;
+		bool eos = false;
+
+		reader.read(length, eos, buffer.getBuffer());
+		benchmark::DoNotOptimize(buffer.getBuffer());
+
+		samples += length;
+	}
+
+	state.SetItemsProcessed(samples);
+	state.counters["realtime"] = benchmark::Counter(double(samples) / reader.getSpecs().rate, benchmark::Counter::kIsRate);
+}
@@ -0,0 +1,45 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "BenchmarkUtil.h"
+
+#include "respec/ChannelMapperReader.h"
+
+using namespace aud;
+
+/// Maps noise between channel layouts. Arguments: source channels, target channels, block size.
+static void BM_ChannelMapper(benchmark::State& state)
+{
+	auto noise = createNoise(Specs{RATE_48000, Channels(state.range(0))});
+
+	ChannelMapperReader reader(noise->createReader(), Channels(state.range(1)));
+
+	readBlocks(state, reader, state.range(2));
+}
+
+BENCHMARK(BM_ChannelMapper)->ArgNames({"from", "to", "block"})->ArgsProduct({{1, 2, 6, 8}, {1, 2, 6, 8}, {256, 4096}});
+
+/// Maps noise in blocks of 1024 samples between the layouts the mapping kernels specialize. Arguments: source channels, target channels.
+static void BM_ChannelMapperKernel(benchmark::State& state)
+{
+	auto noise = createNoise(Specs{RATE_48000, Channels(state.range(0))});
+
+	ChannelMapperReader reader(noise->createReader(), Channels(state.range(1)));
+
+	readBlocks(state, reader, 1024);
+}
+
+BENCHMARK(BM_ChannelMapperKernel)->ArgNames({"from", "to"})->Args({2, 6})->Args({1, 8})->Args({8, 2})->Args({6, 6});
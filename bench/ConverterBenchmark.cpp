@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "BenchmarkUtil.h"
+
+#include "respec/ConverterFunctions.h"
+#include "respec/Specification.h"
+
+using namespace aud;
+
+/// Converts noise between sample formats. Arguments: samples per call.
+static void BM_Convert(benchmark::State& state, convert_f convert, SampleFormat from, SampleFormat to)
+{
+	int length = state.range(0);
+
+	auto noise = createNoiseBuffer(Specs{RATE_48000, CHANNELS_MONO}, length)->getBuffer();
+
+	Buffer source_buffer(length * AUD_FORMAT_SIZE(from));
+	Buffer target_buffer(length * AUD_FORMAT_SIZE(to));
+
+	data_t* samples = reinterpret_cast<data_t*>(noise->getBuffer());
+	data_t* source = reinterpret_cast<data_t*>(source_buffer.getBuffer());
+	data_t* target = reinterpret_cast<data_t*>(target_buffer.getBuffer());
+
+	switch(from)
+	{
+	case FORMAT_U8:
+		convert_float_u8(source, samples, length);
+		break;
+	case FORMAT_S16:
+		convert_float_s16(source, samples, length);
+		break;
+	case FORMAT_S24:
+		convert_float_s24_le(source, samples, length);
+		break;
+	case FORMAT_S32:
+		convert_float_s32(source, samples, length);
+		break;
+	case FORMAT_FLOAT64:
+		convert_float_double(source, samples, length);
+		break;
+	default:
+		std::memcpy(source, samples, length * sizeof(sample_t));
+	}
+
+	for(auto _ : state)
+	{
+		convert(target, source, length);
+		benchmark::DoNotOptimize(target);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * length);
+	state.SetBytesProcessed(state.iterations() * length * (AUD_FORMAT_SIZE(from) + AUD_FORMAT_SIZE(to)));
+}
+
+#define BENCHMARK_CONVERSION(function, from, to) BENCHMARK_CAPTURE(BM_Convert, function, function, from, to)->ArgName("samples")->Arg(4096)
+
+BENCHMARK_CONVERSION(convert_u8_s16, FORMAT_U8, FORMAT_S16);
+BENCHMARK_CONVERSION(convert_u8_s24_be, FORMAT_U8, FORMAT_S24);
+BENCHMARK_CONVERSION(convert_u8_s24_le, FORMAT_U8, FORMAT_S24);
+BENCHMARK_CONVERSION(convert_u8_s32, FORMAT_U8, FORMAT_S32);
+BENCHMARK_CONVERSION(convert_u8_float, FORMAT_U8, FORMAT_FLOAT32);
+BENCHMARK_CONVERSION(convert_u8_double, FORMAT_U8, FORMAT_FLOAT64);
+
+BENCHMARK_CONVERSION(convert_s16_u8, FORMAT_S16, FORMAT_U8);
+BENCHMARK_CONVERSION(convert_s16_s24_be, FORMAT_S16, FORMAT_S24);
+BENCHMARK_CONVERSION(convert_s16_s24_le, FORMAT_S16, FORMAT_S24);
+BENCHMARK_CONVERSION(convert_s16_s32, FORMAT_S16, FORMAT_S32);
+BENCHMARK_CONVERSION(convert_s16_float, FORMAT_S16, FORMAT_FLOAT32);
+BENCHMARK_CONVERSION(convert_s16_double, FORMAT_S16, FORMAT_FLOAT64);
+
+BENCHMARK_CONVERSION(convert_s24_u8_be, FORMAT_S24, FORMAT_U8);
+BENCHMARK_CONVERSION(convert_s24_u8_le, FORMAT_S24, FORMAT_U8);
+BENCHMARK_CONVERSION(convert_s24_s16_be, FORMAT_S24, FORMAT_S16);
+BENCHMARK_CONVERSION(convert_s24_s16_le, FORMAT_S24, FORMAT_S16);
+BENCHMARK_CONVERSION(convert_s24_s24, FORMAT_S24, FORMAT_S24);
+BENCHMARK_CONVERSION(convert_s24_s32_be, FORMAT_S24, FORMAT_S32);
+BENCHMARK_CONVERSION(convert_s24_s32_le, FORMAT_S24, FORMAT_S32);
+BENCHMARK_CONVERSION(convert_s24_float_be, FORMAT_S24, FORMAT_FLOAT32);
+BENCHMARK_CONVERSION(convert_s24_float_le, FORMAT_S24, FORMAT_FLOAT32);
+BENCHMARK_CONVERSION(convert_s24_double_be, FORMAT_S24, FORMAT_FLOAT64);
+BENCHMARK_CONVERSION(convert_s24_double_le, FORMAT_S24, FORMAT_FLOAT64);
+
+BENCHMARK_CONVERSION(convert_s32_u8, FORMAT_S32, FORMAT_U8);
+BENCHMARK_CONVERSION(convert_s32_s16, FORMAT_S32, FORMAT_S16);
+BENCHMARK_CONVERSION(convert_s32_s24_be, FORMAT_S32, FORMAT_S24);
+BENCHMARK_CONVERSION(convert_s32_s24_le, FORMAT_S32, FORMAT_S24);
+BENCHMARK_CONVERSION(convert_s32_float, FORMAT_S32, FORMAT_FLOAT32);
+BENCHMARK_CONVERSION(convert_s32_double, FORMAT_S32, FORMAT_FLOAT64);
+
+BENCHMARK_CONVERSION(convert_float_u8, FORMAT_FLOAT32, FORMAT_U8);
+BENCHMARK_CONVERSION(convert_float_s16, FORMAT_FLOAT32, FORMAT_S16);
+BENCHMARK_CONVERSION(convert_float_s24_be, FORMAT_FLOAT32, FORMAT_S24);
+BENCHMARK_CONVERSION(convert_float_s24_le, FORMAT_FLOAT32, FORMAT_S24);
+BENCHMARK_CONVERSION(convert_float_s32, FORMAT_FLOAT32, FORMAT_S32);
+BENCHMARK_CONVERSION(convert_float_u8_dither, FORMAT_FLOAT32, FORMAT_U8);
+BENCHMARK_CONVERSION(convert_float_s16_dither, FORMAT_FLOAT32, FORMAT_S16);
+BENCHMARK_CONVERSION(convert_float_s24_be_dither, FORMAT_FLOAT32, FORMAT_S24);
+BENCHMARK_CONVERSION(convert_float_s24_le_dither, FORMAT_FLOAT32, FORMAT_S24);
+BENCHMARK_CONVERSION(convert_float_double, FORMAT_FLOAT32, FORMAT_FLOAT64);
+
+BENCHMARK_CONVERSION(convert_double_u8, FORMAT_FLOAT64, FORMAT_U8);
+BENCHMARK_CONVERSION(convert_double_s16, FORMAT_FLOAT64, FORMAT_S16);
+BENCHMARK_CONVERSION(convert_double_s24_be, FORMAT_FLOAT64, FORMAT_S24);
+BENCHMARK_CONVERSION(convert_double_s24_le, FORMAT_FLOAT64, FORMAT_S24);
+BENCHMARK_CONVERSION(convert_double_s32, FORMAT_FLOAT64, FORMAT_S32);
+BENCHMARK_CONVERSION(convert_double_float, FORMAT_FLOAT64, FORMAT_FLOAT32);
@@ -0,0 +1,42 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "BenchmarkUtil.h"
+
+#include "fx/ConvolverReader.h"
+#include "fx/ImpulseResponse.h"
+#include "util/FFTPlan.h"
+#include "util/ThreadPool.h"
+
+#include <thread>
+
+using namespace aud;
+
+/// Convolves noise with a noise impulse response. Arguments: channels, impulse response length.
+static void BM_Convolver(benchmark::State& state)
+{
+	Specs specs{RATE_48000, Channels(state.range(0))};
+
+	auto plan = std::make_shared<FFTPlan>(4096);
+	auto threadPool = std::make_shared<ThreadPool>(std::thread::hardware_concurrency());
+	auto ir = std::make_shared<ImpulseResponse>(createNoiseBuffer(Specs{RATE_48000, CHANNELS_MONO}, state.range(1)), plan);
+
+	ConvolverReader reader(createNoise(specs)->createReader(), ir, threadPool, plan);
+
+	readBlocks(state, reader, 1024);
+}
+
+BENCHMARK(BM_Convolver)->ArgNames({"channels", "ir"})->ArgsProduct({{1, 2}, {1024, 16384, 65536}})->UseRealTime();
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "BenchmarkUtil.h"
+
+#include "devices/ReadDevice.h"
+#include "sequence/Sequence.h"
+#include "sequence/SequenceEntry.h"
+
+#include <vector>
+
+using namespace aud;
+
+/// Mixes looping mono voices on a stereo read device. Arguments: voices, block size, source rate.
+static void BM_ReadDevice(benchmark::State& state)
+{
+	DeviceSpecs specs;
+	specs.rate = RATE_48000;
+	specs.channels = CHANNELS_STEREO;
+	specs.format = FORMAT_FLOAT32;
+
+	const int voices = state.range(0);
+	const int blocksize = state.range(1);
+
+	ReadDevice device(specs);
+	auto noise = createNoise(Specs{SampleRate(state.range(2)), CHANNELS_MONO});
+
+	for(int voice = 0; voice < voices; voice++)
+		device.play(noise)->setVolume(0.1f);
+
+	std::vector<sample_t> buffer(blocksize * specs.channels);
+
+	for(auto _ : state)
+	{
+		device.read(reinterpret_cast<data_t*>(buffer.data()), blocksize);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * blocksize);
+	state.counters["realtime"] = benchmark::Counter(double(state.iterations()) * blocksize / specs.rate, benchmark::Counter::kIsRate);
+}
+
+/// Renders a sequence of overlapping looping mono entries. Arguments: voices.
+static void BM_Sequence(benchmark::State& state)
+{
+	Sequence sequence(Specs{RATE_48000, CHANNELS_STEREO}, 30, false);
+	auto noise = createNoise(Specs{RATE_44100, CHANNELS_MONO});
+	float volume = 0.1f;
+
+	for(int voice = 0; voice < state.range(0); voice++)
+		sequence.add(noise, 0, 1e6, 0)->getAnimProperty(AP_VOLUME)->write(&volume);
+
+	readBlocks(state, *sequence.createReader(), 1024);
+}
+
+BENCHMARK(BM_ReadDevice)->ArgNames({"voices", "block", "rate"})->ArgsProduct({{1, 16, 64, 256}, {256, 1024}, {44100, 48000}});
+BENCHMARK(BM_Sequence)->ArgNames({"voices"})->Arg(1)->Arg(16)->Arg(64);
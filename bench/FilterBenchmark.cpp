@@ -0,0 +1,51 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "BenchmarkUtil.h"
+
+#include "fx/Butterworth.h"
+#include "fx/Highpass.h"
+#include "fx/Lowpass.h"
+
+using namespace aud;
+
+/// Filters noise with a biquad lowpass. Arguments: channels, block size.
+static void BM_Lowpass(benchmark::State& state)
+{
+	Lowpass filter(createNoise(Specs{RATE_48000, Channels(state.range(0))}), 1000);
+
+	readBlocks(state, *filter.createReader(), state.range(1));
+}
+
+/// Filters noise with a biquad highpass. Arguments: channels, block size.
+static void BM_Highpass(benchmark::State& state)
+{
+	Highpass filter(createNoise(Specs{RATE_48000, Channels(state.range(0))}), 1000);
+
+	readBlocks(state, *filter.createReader(), state.range(1));
+}
+
+/// Filters noise with a fourth order butterworth lowpass. Arguments: channels, block size.
+static void BM_Butterworth(benchmark::State& state)
+{
+	Butterworth filter(createNoise(Specs{RATE_48000, Channels(state.range(0))}), 1000);
+
+	readBlocks(state, *filter.createReader(), state.range(1));
+}
+
+BENCHMARK(BM_Lowpass)->ArgNames({"channels", "block"})->ArgsProduct({{1, 2, 8}, {256, 4096}});
+BENCHMARK(BM_Highpass)->ArgNames({"channels", "block"})->ArgsProduct({{1, 2, 8}, {256, 4096}});
+BENCHMARK(BM_Butterworth)->ArgNames({"channels", "block"})->ArgsProduct({{1, 2, 8}, {256, 4096}});
@@ -0,0 +1,54 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "BenchmarkUtil.h"
+
+#include "respec/Mixer.h"
+
+#include <vector>
+
+using namespace aud;
+
+/// Superposes voices into the mixer. Arguments: channels, block size, voices.
+static void BM_Mixer(benchmark::State& state)
+{
+	DeviceSpecs specs;
+	specs.rate = RATE_48000;
+	specs.channels = Channels(state.range(0));
+	specs.format = FORMAT_FLOAT32;
+
+	const int blocksize = state.range(1);
+	const int voices = state.range(2);
+
+	Mixer mixer(specs);
+	std::vector<sample_t> input(blocksize * specs.channels, 0.5f);
+	std::vector<sample_t> output(blocksize * specs.channels);
+
+	for(auto _ : state)
+	{
+		mixer.clear(blocksize);
+
+		for(int voice = 0; voice < voices; voice++)
+			mixer.mix(input.data(), 0, blocksize, 0.5f, 0.25f);
+
+		mixer.read(reinterpret_cast<data_t*>(output.data()), 1.0f);
+		benchmark::DoNotOptimize(output.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * blocksize * voices);
+}
+
+BENCHMARK(BM_Mixer)->ArgNames({"channels", "block", "voices"})->ArgsProduct({{1, 2, 8}, {256, 1024, 4096}, {1, 16, 64}});
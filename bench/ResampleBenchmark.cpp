@@ -0,0 +1,45 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "BenchmarkUtil.h"
+
+#include "respec/JOSResampleReader.h"
+#include "respec/LinearResampleReader.h"
+
+using namespace aud;
+
+/// Resamples 48 kHz noise. Arguments: channels, target rate, quality.
+static void BM_JOSResample(benchmark::State& state)
+{
+	auto noise = createNoise(Specs{RATE_48000, Channels(state.range(0))});
+
+	JOSResampleReader reader(noise->createReader(), SampleRate(state.range(1)), ResampleQuality(state.range(2)));
+
+	readBlocks(state, reader, 1024);
+}
+
+/// Resamples 48 kHz noise. Arguments: channels, target rate.
+static void BM_LinearResample(benchmark::State& state)
+{
+	auto noise = createNoise(Specs{RATE_48000, Channels(state.range(0))});
+
+	LinearResampleReader reader(noise->createReader(), SampleRate(state.range(1)));
+
+	readBlocks(state, reader, 1024);
+}
+
+BENCHMARK(BM_JOSResample)->ArgNames({"channels", "rate", "quality"})->ArgsProduct({{1, 2, 8}, {44100, 96000}, {int(ResampleQuality::LOW), int(ResampleQuality::MEDIUM), int(ResampleQuality::HIGH)}});
+BENCHMARK(BM_LinearResample)->ArgNames({"channels", "rate"})->ArgsProduct({{1, 2, 8}, {44100, 96000}});
@@ -15,12 +15,15 @@
  ******************************************************************************/
 
 #include "devices/DeviceManager.h"
+#include "devices/HandleUpdate.h"
 #include "devices/I3DDevice.h"
 #include "devices/IDeviceFactory.h"
 #include "devices/ReadDevice.h"
+#include "devices/SoftwareDevice.h"
 #include "Exception.h"
 
 #include <cassert>
+#include <vector>
 
 using namespace aud;
 
@@ -53,7 +56,9 @@ AUD_API AUD_Device* AUD_Device_open(const char* type, AUD_DeviceSpecs specs, int
 		dspecs.format = FORMAT_FLOAT32;
 	if(dspecs.rate == RATE_INVALID)
 		dspecs.rate = RATE_48000;
-	if(buffersize < 128)
+	// only JACK and PipeWire mix directly in the audio callback for a buffer size of 0
+	bool direct = buffersize == 0 && type && (type == std::string("JACK") || type == std::string("PipeWire"));
+	if(!direct && buffersize < 128)
 		buffersize = AUD_DEFAULT_BUFFER_SIZE;
 	if(name == nullptr)
 		name = "";
@@ -121,6 +126,178 @@ AUD_API AUD_Handle* AUD_Device_play(AUD_Device* device, AUD_Sound* sound, int ke
 	return nullptr;
 }
 
+AUD_API AUD_Handle* AUD_Device_playAt(AUD_Device* device, AUD_Sound* sound, double time, int keep)
+{
+	assert(sound);
+	auto dev = std::dynamic_pointer_cast<SoftwareDevice>(device ? *device : DeviceManager::getDevice());
+
+	if(!dev)
+		return nullptr;
+
+	try
+	{
+		AUD_Handle handle = dev->playAt(*sound, time, keep);
+		if(handle.get())
+		{
+			return new AUD_Handle(handle);
+		}
+	}
+	catch(Exception&)
+	{
+	}
+	return nullptr;
+}
+
+AUD_API int AUD_Device_stopAt(AUD_Device* device, AUD_Handle* handle, double time)
+{
+	assert(handle);
+	auto dev = std::dynamic_pointer_cast<SoftwareDevice>(device ? *device : DeviceManager::getDevice());
+
+	if(!dev)
+		return false;
+
+	return dev->stopAt(*handle, time);
+}
+
+static int getProfileEntries(const std::shared_ptr<ProfileNode>& node, int depth, AUD_ProfileEntry* entries, int count, int index)
+{
+	if(index < count)
+	{
+		AUD_ProfileEntry& entry = entries[index];
+		std::shared_ptr<ProfileNode> type = node->getType();
+
+		// the type nodes are kept alive, so their names remain valid
+		entry.name = (type ? type : node)->getName().c_str();
+		entry.depth = depth;
+		entry.calls = node->getCalls();
+		entry.samples = node->getSamples();
+		entry.time = node->getTime();
+		entry.self_time = node->getSelfTime();
+	}
+
+	index++;
+
+	for(auto& child : node->getChildren())
+		index = getProfileEntries(child, depth + 1, entries, count, index);
+
+	return index;
+}
+
+AUD_API int AUD_Device_getHandleProfile(AUD_Device* device, AUD_Handle* handle, AUD_ProfileEntry* entries, int count)
+{
+	assert(handle);
+	auto dev = std::dynamic_pointer_cast<SoftwareDevice>(device ? *device : DeviceManager::getDevice());
+
+	if(!dev)
+		return 0;
+
+	std::shared_ptr<ProfileNode> profile = dev->getProfile(*handle);
+
+	if(!profile)
+		return 0;
+
+	return getProfileEntries(profile, 0, entries, count, 0);
+}
+
+AUD_API double AUD_Device_getClock(AUD_Device* device)
+{
+	auto dev = std::dynamic_pointer_cast<SoftwareDevice>(device ? *device : DeviceManager::getDevice());
+
+	if(!dev)
+		return 0;
+
+	return dev->getClock();
+}
+
+AUD_API double AUD_Device_getLatency(AUD_Device* device)
+{
+	auto dev = std::dynamic_pointer_cast<SoftwareDevice>(device ? *device : DeviceManager::getDevice());
+
+	if(!dev)
+		return 0;
+
+	return dev->getLatency();
+}
+
+AUD_API int AUD_Device_setStatsEnabled(AUD_Device* device, int enabled)
+{
+	auto dev = std::dynamic_pointer_cast<SoftwareDevice>(device ? *device : DeviceManager::getDevice());
+
+	if(!dev)
+		return false;
+
+	dev->setStatisticsEnabled(enabled);
+
+	return true;
+}
+
+AUD_API int AUD_Device_getStats(AUD_Device* device, AUD_DeviceStats* stats)
+{
+	assert(stats);
+	auto dev = std::dynamic_pointer_cast<SoftwareDevice>(device ? *device : DeviceManager::getDevice());
+
+	if(!dev)
+		return false;
+
+	DeviceStatistics statistics = dev->getStatistics();
+
+	stats->mixes = statistics.mixes;
+	stats->mix_time_mean = statistics.mix_time_mean;
+	stats->mix_time_median = statistics.mix_time_median;
+	stats->mix_time_p99 = statistics.mix_time_p99;
+	stats->mix_time_max = statistics.mix_time_max;
+	stats->voices_mean = statistics.voices_mean;
+	stats->voices_max = statistics.voices_max;
+	stats->callbacks = statistics.callbacks;
+	stats->interval_mean = statistics.interval_mean;
+	stats->jitter_p99 = statistics.jitter_p99;
+	stats->jitter_max = statistics.jitter_max;
+	stats->fill_mean = statistics.fill_mean;
+	stats->fill_min = statistics.fill_min;
+	stats->underruns = statistics.underruns;
+
+	return true;
+}
+
+AUD_API void AUD_Device_resetStats(AUD_Device* device)
+{
+	auto dev = std::dynamic_pointer_cast<SoftwareDevice>(device ? *device : DeviceManager::getDevice());
+
+	if(dev)
+		dev->resetStatistics();
+}
+
+AUD_API int AUD_Device_updateHandles(AUD_Device* device, const AUD_HandleUpdate* updates, int count)
+{
+	assert(updates || count <= 0);
+
+	if(count <= 0)
+		return 0;
+
+	auto dev = device ? *device : DeviceManager::getDevice();
+
+	if(!dev)
+		return 0;
+
+	std::vector<HandleUpdate> batch(count);
+
+	for(int i = 0; i < count; i++)
+	{
+		const AUD_HandleUpdate& update = updates[i];
+		HandleUpdate& target = batch[i];
+
+		target.handle = update.handle ? update.handle->get() : nullptr;
+		target.flags = update.flags;
+		target.location = Vector3(update.location[0], update.location[1], update.location[2]);
+		target.velocity = Vector3(update.velocity[0], update.velocity[1], update.velocity[2]);
+		target.orientation = Quaternion(update.orientation[3], update.orientation[0], update.orientation[1], update.orientation[2]);
+		target.volume = update.volume;
+		target.pitch = update.pitch;
+	}
+
+	return applyHandleUpdates(*dev, batch.data(), count);
+}
+
 AUD_API void AUD_Device_stopAll(AUD_Device* device)
 {
 	auto dev = device ? *device : DeviceManager::getDevice();
@@ -44,6 +44,8 @@ typedef void (*AUD_syncFunction)(void*, int, float);
  *                   Can be "read" to open a readable device.
  * \param specs      Specification of the device parameters.
  * \param buffersize Size of the mixing buffer.
+ *                   0 mixes directly in the audio callback for the "JACK" and
+ *                   "PipeWire" types, other devices use the default size.
  * \param name       Custom name of the device.
  * \return A handle to the opened device or NULL on failure.
  */
@@ -63,6 +65,87 @@ extern AUD_API void AUD_Device_lock(AUD_Device* device);
  */
 extern AUD_API AUD_Handle* AUD_Device_play(AUD_Device* device, AUD_Sound* sound, int keep);
 
+/**
+ * Schedules a sound to start at a sample accurate position on the device timeline.
+ * \param device The device to play back on, only software mixing devices support scheduling.
+ * \param sound The handle of the sound file.
+ * \param time The device time in seconds to start playback at, see AUD_Device_getClock.
+ * \param keep When keep is true the sound source will not be deleted but set to
+ *             paused when its end has been reached.
+ * \return A handle to the played back sound or NULL on failure.
+ */
+extern AUD_API AUD_Handle* AUD_Device_playAt(AUD_Device* device, AUD_Sound* sound, double time, int keep);
+
+/**
+ * Schedules a playing sound to stop at a sample accurate position on the device timeline.
+ * \param device The device the sound is playing on.
+ * \param handle The playback handle.
+ * \param time The device time in seconds to stop playback at, see AUD_Device_getClock.
+ * \return Whether the stop could be scheduled.
+ */
+extern AUD_API int AUD_Device_stopAt(AUD_Device* device, AUD_Handle* handle, double time);
+
+/**
+ * Retrieves the profile of a playback handle, see AUD_setProfilingEnabled.
+ * \param device The device the sound is playing on.
+ * \param handle The playback handle.
+ * \param entries The array to fill with the nodes of the profile tree in
+ *        depth-first order, the root has depth 0.
+ * \param count The size of the array.
+ * \return The number of nodes, which may be larger than count, or 0 if the
+ *         handle is not profiled.
+ */
+extern AUD_API int AUD_Device_getHandleProfile(AUD_Device* device, AUD_Handle* handle, AUD_ProfileEntry* entries, int count);
+
+/**
+ * Retrieves the current time of the device timeline.
+ * \param device The device to get the clock from.
+ * \return The time in seconds of all samples mixed so far or 0 if the device
+ *         is not a software mixing device.
+ */
+extern AUD_API double AUD_Device_getClock(AUD_Device* device);
+
+/**
+ * Retrieves the output latency of a device.
+ * \param device The device to get the latency from.
+ * \return The time in seconds between mixing a sample and its playback or 0
+ *         if it is unknown.
+ */
+extern AUD_API double AUD_Device_getLatency(AUD_Device* device);
+
+/**
+ * Enables or disables recording of the timing statistics of a device.
+ * \param device The device to record statistics for.
+ * \param enabled Whether to record statistics.
+ * \return Whether the device supports statistics.
+ */
+extern AUD_API int AUD_Device_setStatsEnabled(AUD_Device* device, int enabled);
+
+/**
+ * Retrieves the timing statistics of a device since they were last reset.
+ * \param device The device to get the statistics from.
+ * \param stats The structure to fill with the statistics.
+ * \return Whether the device supports statistics.
+ */
+extern AUD_API int AUD_Device_getStats(AUD_Device* device, AUD_DeviceStats* stats);
+
+/**
+ * Clears the timing statistics of a device.
+ * \param device The device to reset the statistics of.
+ */
+extern AUD_API void AUD_Device_resetStats(AUD_Device* device);
+
+/**
+ * Updates the properties of many playback handles at once.
+ * All updates are applied under a single device lock, so they take effect in
+ * the same mixing cycle and avoid the overhead of the individual setters.
+ * \param device The device the handles are playing on.
+ * \param updates The array of updates.
+ * \param count The number of updates.
+ * \return The number of updates whose properties could all be set.
+ */
+extern AUD_API int AUD_Device_updateHandles(AUD_Device* device, const AUD_HandleUpdate* updates, int count);
+
 /**
  * Stops all sounds playing.
  */
@@ -35,10 +35,12 @@
 #include "devices/DeviceManager.h"
 #include "devices/IDeviceFactory.h"
 #include "devices/NULLDevice.h"
+#include "util/Profiler.h"
 
 #include <cassert>
 #include <cstring>
 #include <cmath>
+#include <fstream>
 #include <sstream>
 
 using namespace aud;
@@ -277,7 +279,7 @@ AUD_API int AUD_mixdown(AUD_Sound* sound, unsigned int start, unsigned int lengt
 		Sequence* f = dynamic_cast<Sequence *>(sound->get());
 
 		f->setSpecs(convCToSpec(specs.specs));
-		std::shared_ptr<IReader> reader = f->createQualityReader(static_cast<ResampleQuality>(quality));
+		std::shared_ptr<IReader> reader = f->createQualityReader(static_cast<ResampleQuality>(quality), true);
 		reader->seek(start);
 		std::shared_ptr<IWriter> writer = FileWriter::createWriter(filename, convCToDSpec(specs), static_cast<Container>(format), static_cast<Codec>(codec), bitrate);
 		FileWriter::writeReader(reader, writer, length, buffersize, callback, data);
@@ -329,7 +331,7 @@ AUD_API int AUD_mixdown_per_channel(AUD_Sound* sound, unsigned int start, unsign
 			writers.push_back(FileWriter::createWriter(stream.str(), convCToDSpec(specs), static_cast<Container>(format), static_cast<Codec>(codec), bitrate));
 		}
 
-		std::shared_ptr<IReader> reader = f->createQualityReader(static_cast<ResampleQuality>(quality));
+		std::shared_ptr<IReader> reader = f->createQualityReader(static_cast<ResampleQuality>(quality), true);
 		reader->seek(start);
 		FileWriter::writeReader(reader, writers, length, buffersize, callback, data);
 
@@ -358,7 +360,7 @@ AUD_API AUD_Device* AUD_openMixdownDevice(AUD_DeviceSpecs specs, AUD_Sound* sequ
 
 		f->setSpecs(convCToSpec(specs.specs));
 
-		AUD_Handle handle = device->play(f->createQualityReader(static_cast<ResampleQuality>(quality)));
+		AUD_Handle handle = device->play(f->createQualityReader(static_cast<ResampleQuality>(quality), true));
 		if(handle.get())
 		{
 			handle->seek(start);
@@ -428,3 +430,52 @@ AUD_API char** AUD_getDeviceNames()
 
 	return names;
 }
+
+AUD_API void AUD_setProfilingEnabled(int enabled)
+{
+	Profiler::setEnabled(enabled);
+}
+
+AUD_API int AUD_getProfile(AUD_ProfileEntry* entries, int count)
+{
+	std::vector<std::shared_ptr<ProfileNode>> profile = Profiler::getProfile();
+
+	for(int i = 0; i < count && i < int(profile.size()); i++)
+	{
+		entries[i].name = profile[i]->getName().c_str();
+		entries[i].depth = 0;
+		entries[i].calls = profile[i]->getCalls();
+		entries[i].samples = profile[i]->getSamples();
+		entries[i].time = profile[i]->getTime();
+		entries[i].self_time = profile[i]->getSelfTime();
+	}
+
+	return profile.size();
+}
+
+AUD_API void AUD_resetProfile()
+{
+	Profiler::reset();
+}
+
+AUD_API void AUD_startProfileTrace(int events)
+{
+	Profiler::startTrace(events);
+}
+
+AUD_API void AUD_stopProfileTrace()
+{
+	Profiler::stopTrace();
+}
+
+AUD_API int AUD_writeProfileTrace(const char* filename)
+{
+	std::ofstream stream(filename);
+
+	if(!stream)
+		return false;
+
+	Profiler::writeTrace(stream);
+
+	return bool(stream);
+}
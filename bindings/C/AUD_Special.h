@@ -150,6 +150,43 @@ extern AUD_API void AUD_exit(AUD_Device* device);
  */
 extern AUD_API char** AUD_getDeviceNames();
 
+/**
+ * Enables or disables profiling of the readers of sounds played afterwards.
+ * \param enabled Whether to profile readers.
+ */
+extern AUD_API void AUD_setProfilingEnabled(int enabled);
+
+/**
+ * Retrieves the profile of all readers aggregated by sound type.
+ * \param entries The array to fill with one entry per type, all with depth 0.
+ * \param count The size of the array.
+ * \return The number of types, which may be larger than count.
+ */
+extern AUD_API int AUD_getProfile(AUD_ProfileEntry* entries, int count);
+
+/**
+ * Clears the profile aggregated by sound type.
+ */
+extern AUD_API void AUD_resetProfile();
+
+/**
+ * Starts recording a trace of all profiled reads.
+ * \param events The maximum number of reads to record.
+ */
+extern AUD_API void AUD_startProfileTrace(int events);
+
+/**
+ * Stops recording the trace of profiled reads.
+ */
+extern AUD_API void AUD_stopProfileTrace();
+
+/**
+ * Writes the recorded trace of profiled reads as Chrome trace event JSON.
+ * \param filename The file to write to.
+ * \return Whether the file could be written.
+ */
+extern AUD_API int AUD_writeProfileTrace(const char* filename);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,8 @@
 
 #include "Audaspace.h"
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 using namespace aud;
 #endif
@@ -181,6 +183,89 @@ typedef struct
 	};
 } AUD_DeviceSpecs;
 
+/// Profile of a node of a reader graph.
+typedef struct
+{
+	/// Type of the node, valid until the library is unloaded.
+	const char* name;
+
+	/// Depth of the node in the tree, 0 for roots.
+	int depth;
+
+	/// Number of reads.
+	uint64_t calls;
+
+	/// Number of samples produced.
+	uint64_t samples;
+
+	/// Time spent in the node including and excluding its children in seconds.
+	double time;
+	double self_time;
+} AUD_ProfileEntry;
+
+/// Timing statistics of a device.
+typedef struct
+{
+	/// Number of mixes.
+	uint64_t mixes;
+
+	/// Mean, median, 99th percentile and longest mix time in seconds.
+	double mix_time_mean;
+	double mix_time_median;
+	double mix_time_p99;
+	double mix_time_max;
+
+	/// Mean and most rendered voices per mix.
+	double voices_mean;
+	int voices_max;
+
+	/// Number of measured intervals between audio callbacks.
+	uint64_t callbacks;
+
+	/// Mean interval between audio callbacks in seconds.
+	double interval_mean;
+
+	/// 99th percentile and largest deviation of the callback interval from the buffer period in seconds.
+	double jitter_p99;
+	double jitter_max;
+
+	/// Mean and lowest ring buffer fill level between 0 and 1.
+	float fill_mean;
+	float fill_min;
+
+	/// Number of callbacks that could not be filled completely.
+	uint64_t underruns;
+} AUD_DeviceStats;
+
+/// Properties set by a handle update.
+typedef enum
+{
+	AUD_HANDLE_UPDATE_LOCATION    = 1 << 0,	/// Sets the location.
+	AUD_HANDLE_UPDATE_VELOCITY    = 1 << 1,	/// Sets the velocity.
+	AUD_HANDLE_UPDATE_ORIENTATION = 1 << 2,	/// Sets the orientation.
+	AUD_HANDLE_UPDATE_VOLUME      = 1 << 3,	/// Sets the volume.
+	AUD_HANDLE_UPDATE_PITCH       = 1 << 4	/// Sets the pitch.
+} AUD_HandleUpdateFlags;
+
+/// Update of the properties of a playback handle.
+typedef struct
+{
+	/// The handle to update.
+	AUD_Handle* handle;
+
+	/// Combination of AUD_HandleUpdateFlags which properties to set.
+	int flags;
+
+	/// The new location, velocity and orientation as quaternion (x, y, z, w).
+	float location[3];
+	float velocity[3];
+	float orientation[4];
+
+	/// The new volume and pitch.
+	float volume;
+	float pitch;
+} AUD_HandleUpdate;
+
 /// Sound information structure.
 typedef struct
 {
@@ -25,6 +25,7 @@
 #include "PyDynamicMusic.h"
 #include "PyThreadPool.h"
 #include "PySource.h"
+#include "PyReader.h"
 
 #ifdef WITH_CONVOLUTION
 #include "PyImpulseResponse.h"
@@ -41,8 +42,10 @@
 #include "file/IWriter.h"
 #include "plugin/PluginManager.h"
 #include "sequence/AnimateableProperty.h"
+#include "util/Profiler.h"
 #include "ISound.h"
 
+#include <fstream>
 #include <memory>
 
 #include <structmember.h>
@@ -59,6 +62,162 @@ PyObject* AUDError = nullptr;
 
 // ====================================================================
 
+static PyObject* buildProfileEntry(const ProfileNode& node)
+{
+	return Py_BuildValue("{s:s,s:K,s:K,s:d,s:d}",
+						 "name", node.getName().c_str(),
+						 "calls", (unsigned long long)node.getCalls(),
+						 "samples", (unsigned long long)node.getSamples(),
+						 "time", node.getTime(),
+						 "self_time", node.getSelfTime());
+}
+
+PyDoc_STRVAR(M_aud_getProfile_doc,
+			 ".. function:: getProfile()\n\n"
+			 "   Returns the profile of all readers aggregated by sound type,\n"
+			 "   see :func:`setProfilingEnabled`.\n\n"
+			 "   :return: One dict per type with the keys name, calls, samples,\n"
+			 "      time and self_time, times are in seconds.\n"
+			 "   :rtype: list");
+
+static PyObject *
+aud_getProfile(PyObject* self)
+{
+	std::vector<std::shared_ptr<ProfileNode>> profile = Profiler::getProfile();
+
+	PyObject* list = PyList_New(profile.size());
+
+	if(!list)
+		return nullptr;
+
+	for(size_t i = 0; i < profile.size(); i++)
+	{
+		PyObject* entry = buildProfileEntry(*profile[i]);
+
+		if(!entry)
+		{
+			Py_DECREF(list);
+			return nullptr;
+		}
+
+		PyList_SET_ITEM(list, i, entry);
+	}
+
+	return list;
+}
+
+PyDoc_STRVAR(M_aud_resetProfile_doc,
+			 ".. function:: resetProfile()\n\n"
+			 "   Clears the profile aggregated by sound type.");
+
+static PyObject *
+aud_resetProfile(PyObject* self)
+{
+	Profiler::reset();
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(M_aud_setProfilingEnabled_doc,
+			 ".. function:: setProfilingEnabled(enabled)\n\n"
+			 "   Enables or disables profiling of the readers of sounds that\n"
+			 "   are played afterwards. Profiled readers accumulate their time,\n"
+			 "   samples and calls, see :func:`getProfile` and\n"
+			 "   :meth:`Device.getProfile`.\n\n"
+			 "   :arg enabled: Whether to profile readers.\n"
+			 "   :type enabled: bool");
+
+static PyObject *
+aud_setProfilingEnabled(PyObject* self, PyObject* args)
+{
+	PyObject* enabled;
+
+	if(!PyArg_ParseTuple(args, "O!:setProfilingEnabled", &PyBool_Type, &enabled))
+		return nullptr;
+
+	Profiler::setEnabled(enabled == Py_True);
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(M_aud_startProfileTrace_doc,
+			 ".. function:: startProfileTrace(events=65536)\n\n"
+			 "   Starts recording a trace of all profiled reads.\n\n"
+			 "   :arg events: The maximum number of reads to record.\n"
+			 "   :type events: int");
+
+static PyObject *
+aud_startProfileTrace(PyObject* self, PyObject* args)
+{
+	int events = 65536;
+
+	if(!PyArg_ParseTuple(args, "|i:startProfileTrace", &events))
+		return nullptr;
+
+	Profiler::startTrace(events);
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(M_aud_stopProfileTrace_doc,
+			 ".. function:: stopProfileTrace()\n\n"
+			 "   Stops recording the trace of profiled reads.");
+
+static PyObject *
+aud_stopProfileTrace(PyObject* self)
+{
+	Profiler::stopTrace();
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(M_aud_writeProfileTrace_doc,
+			 ".. function:: writeProfileTrace(filename)\n\n"
+			 "   Writes the recorded trace of profiled reads as Chrome trace\n"
+			 "   event JSON, which can be opened in chrome://tracing or Perfetto.\n\n"
+			 "   :arg filename: The file to write to.\n"
+			 "   :type filename: string");
+
+static PyObject *
+aud_writeProfileTrace(PyObject* self, PyObject* args)
+{
+	const char* filename = nullptr;
+
+	if(!PyArg_ParseTuple(args, "s:writeProfileTrace", &filename))
+		return nullptr;
+
+	std::ofstream stream(filename);
+
+	if(stream)
+		Profiler::writeTrace(stream);
+
+	if(!stream)
+	{
+		PyErr_SetString(AUDError, "Couldn't write the trace file!");
+		return nullptr;
+	}
+
+	Py_RETURN_NONE;
+}
+
+static PyMethodDef aud_methods[] = {
+	{"getProfile", (PyCFunction)aud_getProfile, METH_NOARGS,
+	 M_aud_getProfile_doc
+	},
+	{"resetProfile", (PyCFunction)aud_resetProfile, METH_NOARGS,
+	 M_aud_resetProfile_doc
+	},
+	{"setProfilingEnabled", (PyCFunction)aud_setProfilingEnabled, METH_VARARGS,
+	 M_aud_setProfilingEnabled_doc
+	},
+	{"startProfileTrace", (PyCFunction)aud_startProfileTrace, METH_VARARGS,
+	 M_aud_startProfileTrace_doc
+	},
+	{"stopProfileTrace", (PyCFunction)aud_stopProfileTrace, METH_NOARGS,
+	 M_aud_stopProfileTrace_doc
+	},
+	{"writeProfileTrace", (PyCFunction)aud_writeProfileTrace, METH_VARARGS,
+	 M_aud_writeProfileTrace_doc
+	},
+	{nullptr}  /* Sentinel */
+};
+
 PyDoc_STRVAR(M_aud_doc,
 			 "Audaspace (pronounced \"outer space\") is a high level audio library.");
 
@@ -68,7 +227,7 @@ static struct PyModuleDef audmodule = {
 	M_aud_doc, /* module documentation */
 	-1,        /* size of per-interpreter state of the module,
 				  or -1 if the module keeps state in global variables. */
-   nullptr, nullptr, nullptr, nullptr, nullptr
+   aud_methods, nullptr, nullptr, nullptr, nullptr
 };
 
 PyMODINIT_FUNC
@@ -108,6 +267,9 @@ PyInit_aud()
 	if(!initializeAnimateableProperty())
 		return nullptr;
 
+	if(!initializeReader())
+		return nullptr;
+
 #ifdef WITH_CONVOLUTION
 	if(!initializeImpulseResponse())
 		return nullptr;
@@ -130,6 +292,7 @@ PyInit_aud()
 	addPlaybackManagerToModule(module);
 	addThreadPoolToModule(module);
 	addSourceToModule(module);
+	addReaderToModule(module);
 
 #ifdef WITH_CONVOLUTION
 	addImpulseResponseToModule(module);
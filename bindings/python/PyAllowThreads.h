@@ -0,0 +1,52 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+
+/**
+ * Releases the global interpreter lock during its lifetime, so that other
+ * Python threads can run during long native work. No Python API may be used
+ * while the scope is active, exceptions leaving the scope reacquire the lock.
+ */
+class PyAllowThreads
+{
+private:
+	/// The state of the thread that released the lock.
+	PyThreadState* m_state;
+
+	// delete copy constructor and operator=
+	PyAllowThreads(const PyAllowThreads&) = delete;
+	PyAllowThreads& operator=(const PyAllowThreads&) = delete;
+
+public:
+	/**
+	 * Releases the global interpreter lock.
+	 */
+	inline PyAllowThreads() :
+		m_state(PyEval_SaveThread())
+	{
+	}
+
+	/**
+	 * Reacquires the global interpreter lock.
+	 */
+	inline ~PyAllowThreads()
+	{
+		PyEval_RestoreThread(m_state);
+	}
+};
@@ -16,6 +16,7 @@
 
 #include "PyDevice.h"
 
+#include "PyAllowThreads.h"
 #include "PySound.h"
 #include "PyHandle.h"
 
@@ -24,13 +25,20 @@
 #include "devices/I3DDevice.h"
 #include "devices/DeviceManager.h"
 #include "devices/IDeviceFactory.h"
+#include "devices/HandleUpdate.h"
+#include "devices/SoftwareDevice.h"
 
 #include <structmember.h>
+#include <vector>
+
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <numpy/ndarrayobject.h>
 
 using namespace aud;
 
 extern PyObject* AUDError;
 static const char* device_not_3d_error = "Device is not a 3D device!";
+static const char* device_not_software_error = "Device is not a software mixing device!";
 
 // ====================================================================
 
@@ -59,9 +67,12 @@ Device_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
 									&device, &rate, &channels, &format, &buffersize, &name))
 		return nullptr;
 
-	if(buffersize < 128)
+	// only JACK and PipeWire mix directly in the audio callback for a buffer size of 0
+	bool direct = buffersize == 0 && device && (device == std::string("JACK") || device == std::string("PipeWire"));
+
+	if(!direct && buffersize < 128)
 	{
-		PyErr_SetString(PyExc_ValueError, "buffer_size must be at least 128!");
+		PyErr_SetString(PyExc_ValueError, "buffer_size must be at least 128 or 0 for JACK and PipeWire!");
 		return nullptr;
 	}
 
@@ -78,6 +89,8 @@ Device_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
 
 		try
 		{
+			PyAllowThreads allow;
+
 			if(!device)
 			{
 				auto dev = DeviceManager::getDevice();
@@ -123,6 +136,80 @@ Device_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
 	return (PyObject *)self;
 }
 
+static PyObject* buildProfile(const std::shared_ptr<ProfileNode>& node)
+{
+	std::vector<std::shared_ptr<ProfileNode>> children = node->getChildren();
+
+	PyObject* list = PyList_New(children.size());
+
+	if(!list)
+		return nullptr;
+
+	for(size_t i = 0; i < children.size(); i++)
+	{
+		PyObject* child = buildProfile(children[i]);
+
+		if(!child)
+		{
+			Py_DECREF(list);
+			return nullptr;
+		}
+
+		PyList_SET_ITEM(list, i, child);
+	}
+
+	std::shared_ptr<ProfileNode> type = node->getType();
+
+	return Py_BuildValue("{s:s,s:K,s:K,s:d,s:d,s:N}",
+						 "name", (type ? type : node)->getName().c_str(),
+						 "calls", (unsigned long long)node->getCalls(),
+						 "samples", (unsigned long long)node->getSamples(),
+						 "time", node->getTime(),
+						 "self_time", node->getSelfTime(),
+						 "children", list);
+}
+
+PyDoc_STRVAR(M_aud_Device_getProfile_doc,
+			 ".. method:: getProfile(handle)\n\n"
+			 "   Returns the profile of a handle that was played while\n"
+			 "   profiling was enabled, see :func:`setProfilingEnabled`.\n\n"
+			 "   :arg handle: The playback handle.\n"
+			 "   :type handle: :class:`Handle`\n"
+			 "   :return: The root of the profile tree as dict with the keys\n"
+			 "      name, calls, samples, time, self_time and children, a list of\n"
+			 "      the profiles of the input readers, or None if the handle is\n"
+			 "      not profiled. Times are in seconds.\n"
+			 "   :rtype: dict");
+
+static PyObject *
+Device_getProfile(Device* self, PyObject* args)
+{
+	PyObject* object;
+
+	if(!PyArg_ParseTuple(args, "O:getProfile", &object))
+		return nullptr;
+
+	Handle* handle = checkHandle(object);
+
+	if(!handle)
+		return nullptr;
+
+	SoftwareDevice* device = dynamic_cast<SoftwareDevice*>(reinterpret_cast<std::shared_ptr<IDevice>*>(self->device)->get());
+
+	if(!device)
+	{
+		PyErr_SetString(AUDError, device_not_software_error);
+		return nullptr;
+	}
+
+	std::shared_ptr<ProfileNode> profile = device->getProfile(*reinterpret_cast<std::shared_ptr<IHandle>*>(handle->handle));
+
+	if(!profile)
+		Py_RETURN_NONE;
+
+	return buildProfile(profile);
+}
+
 PyDoc_STRVAR(M_aud_Device_lock_doc,
 			 ".. method:: lock()\n\n"
 			 "   Locks the device so that it's guaranteed, that no samples are\n"
@@ -211,6 +298,98 @@ Device_play(Device* self, PyObject* args, PyObject* kwds)
 	return (PyObject *)handle;
 }
 
+PyDoc_STRVAR(M_aud_Device_playAt_doc,
+			 ".. method:: playAt(sound, time, keep=False)\n\n"
+			 "   Schedules a sound to start at a sample accurate position on\n"
+			 "   the device timeline, see :attr:`clock`.\n\n"
+			 "   :arg sound: The sound to play.\n"
+			 "   :type sound: :class:`Sound`\n"
+			 "   :arg time: The device time in seconds to start playback at.\n"
+			 "      Times that already passed start playback immediately.\n"
+			 "   :type time: float\n"
+			 "   :arg keep: See :attr:`Handle.keep`.\n"
+			 "   :type keep: bool\n"
+			 "   :return: The playback handle with which playback can be\n"
+			 "      controlled with.\n"
+			 "   :rtype: :class:`Handle`");
+
+static PyObject *
+Device_playAt(Device* self, PyObject* args, PyObject* kwds)
+{
+	PyObject* object;
+	PyObject* keepo = nullptr;
+	double time;
+
+	bool keep = false;
+
+	static const char* kwlist[] = {"sound", "time", "keep", nullptr};
+
+	if(!PyArg_ParseTupleAndKeywords(args, kwds, "Od|O:playAt", const_cast<char**>(kwlist), &object, &time, &keepo))
+		return nullptr;
+
+	Sound* sound = checkSound(object);
+
+	if(!sound)
+		return nullptr;
+
+	if(keepo != nullptr)
+	{
+		if(!PyBool_Check(keepo))
+		{
+			PyErr_SetString(PyExc_TypeError, "keep is not a boolean!");
+			return nullptr;
+		}
+
+		keep = keepo == Py_True;
+	}
+
+	SoftwareDevice* device = dynamic_cast<SoftwareDevice*>(reinterpret_cast<std::shared_ptr<IDevice>*>(self->device)->get());
+
+	if(!device)
+	{
+		PyErr_SetString(AUDError, device_not_software_error);
+		return nullptr;
+	}
+
+	Handle* handle;
+
+	handle = (Handle*)Handle_empty();
+	if(handle != nullptr)
+	{
+		try
+		{
+			handle->handle = new std::shared_ptr<IHandle>(device->playAt(*reinterpret_cast<std::shared_ptr<ISound>*>(sound->sound), time, keep));
+		}
+		catch(Exception& e)
+		{
+			Py_DECREF(handle);
+			PyErr_SetString(AUDError, e.what());
+			return nullptr;
+		}
+	}
+
+	return (PyObject *)handle;
+}
+
+PyDoc_STRVAR(M_aud_Device_resetStats_doc,
+			 ".. method:: resetStats()\n\n"
+			 "   Clears the timing statistics, see :attr:`stats`.");
+
+static PyObject *
+Device_resetStats(Device* self)
+{
+	SoftwareDevice* device = dynamic_cast<SoftwareDevice*>(reinterpret_cast<std::shared_ptr<IDevice>*>(self->device)->get());
+
+	if(!device)
+	{
+		PyErr_SetString(AUDError, device_not_software_error);
+		return nullptr;
+	}
+
+	device->resetStatistics();
+	Py_RETURN_NONE;
+}
+
 PyDoc_STRVAR(M_aud_Device_stopAll_doc,
 			 ".. method:: stopAll()\n\n"
 			 "   Stops all playing and paused sounds.");
@@ -230,6 +409,50 @@ Device_stopAll(Device* self)
 	}
 }
 
+PyDoc_STRVAR(M_aud_Device_stopAt_doc,
+			 ".. method:: stopAt(handle, time)\n\n"
+			 "   Schedules a playing sound to stop at a sample accurate\n"
+			 "   position on the device timeline, see :attr:`clock`.\n\n"
+			 "   :arg handle: The playback handle to stop.\n"
+			 "   :type handle: :class:`Handle`\n"
+			 "   :arg time: The device time in seconds to stop playback at.\n"
+			 "   :type time: float\n"
+			 "   :return: Whether the stop could be scheduled.\n"
+			 "   :rtype: bool");
+
+static PyObject *
+Device_stopAt(Device* self, PyObject* args)
+{
+	PyObject* object;
+	double time;
+
+	if(!PyArg_ParseTuple(args, "Od:stopAt", &object, &time))
+		return nullptr;
+
+	Handle* handle = checkHandle(object);
+
+	if(!handle)
+		return nullptr;
+
+	SoftwareDevice* device = dynamic_cast<SoftwareDevice*>(reinterpret_cast<std::shared_ptr<IDevice>*>(self->device)->get());
+
+	if(!device)
+	{
+		PyErr_SetString(AUDError, device_not_software_error);
+		return nullptr;
+	}
+
+	try
+	{
+		return PyBool_FromLong((long)device->stopAt(*reinterpret_cast<std::shared_ptr<IHandle>*>(handle->handle), time));
+	}
+	catch(Exception& e)
+	{
+		PyErr_SetString(AUDError, e.what());
+		return nullptr;
+	}
+}
+
 PyDoc_STRVAR(M_aud_Device_unlock_doc,
 			 ".. method:: unlock()\n\n"
 			 "   Unlocks the device after a lock call, see :meth:`lock` for\n"
@@ -250,19 +473,212 @@ Device_unlock(Device* self)
 	}
 }
 
+/**
+ * Returns a field of a structured array as contiguous float array.
+ * \param array The structured array.
+ * \param name The name of the field.
+ * \param width The number of floats per element in the field.
+ * \param field Set to the new reference to the float array or nullptr if the
+ *        array doesn't have the field.
+ * \return Whether no error occured.
+ */
+static bool getUpdateField(PyObject* array, const char* name, npy_intp width, PyArrayObject*& field)
+{
+	field = nullptr;
+
+	PyObject* fields = PyObject_GetAttrString(reinterpret_cast<PyObject*>(PyArray_DESCR(reinterpret_cast<PyArrayObject*>(array))), "fields");
+
+	if(!fields)
+		return false;
+
+	int has_field = fields != Py_None && PyMapping_HasKeyString(fields, name);
+	Py_DECREF(fields);
+
+	if(!has_field)
+		return true;
+
+	PyObject* view = PyMapping_GetItemString(array, name);
+
+	if(!view)
+		return false;
+
+	field = reinterpret_cast<PyArrayObject*>(PyArray_FROM_OTF(view, NPY_FLOAT, NPY_ARRAY_IN_ARRAY | NPY_ARRAY_FORCECAST));
+	Py_DECREF(view);
+
+	if(!field)
+		return false;
+
+	if(PyArray_SIZE(field) != PyArray_SIZE(reinterpret_cast<PyArrayObject*>(array)) * width)
+	{
+		PyErr_Format(PyExc_ValueError, "The field %s needs %d values per update!", name, int(width));
+		Py_CLEAR(field);
+		return false;
+	}
+
+	return true;
+}
+
+PyDoc_STRVAR(M_aud_Device_updateHandles_doc,
+			 ".. method:: updateHandles(handles, updates)\n\n"
+			 "   Updates the properties of many playback handles at once.\n"
+			 "   All updates are applied under a single device lock, so they\n"
+			 "   take effect in the same mixing cycle, which is a lot faster than\n"
+			 "   setting the properties of the handles one by one.\n\n"
+			 "   :arg handles: The handles to update.\n"
+			 "   :type handles: sequence of :class:`Handle`\n"
+			 "   :arg updates: A structured numpy array with an element per\n"
+			 "      handle. The fields present in the array are set, they can be\n"
+			 "      location and velocity with 3 floats, orientation with 4\n"
+			 "      floats as quaternion (w, x, y, z), volume and pitch.\n"
+			 "   :type updates: :class:`numpy.ndarray`\n"
+			 "   :return: The number of handles whose properties could all be set.\n"
+			 "   :rtype: int\n\n"
+			 "   .. note:: A suitable array can be created with\n"
+			 "      ``numpy.zeros(len(handles), dtype=[('location', 'f4', 3), ('volume', 'f4')])``.");
+
+static PyObject *
+Device_updateHandles(Device* self, PyObject* args)
+{
+	PyObject* handles_object;
+	PyObject* array;
+
+	if(!PyArg_ParseTuple(args, "OO:updateHandles", &handles_object, &array))
+		return nullptr;
+
+	if(!PyArray_Check(array) || !PyDataType_HASFIELDS(PyArray_DESCR(reinterpret_cast<PyArrayObject*>(array))))
+	{
+		PyErr_SetString(PyExc_TypeError, "The updates need to be supplied as structured numpy array!");
+		return nullptr;
+	}
+
+	PyObject* handles = PySequence_Fast(handles_object, "The handles need to be supplied as sequence!");
+
+	if(!handles)
+		return nullptr;
+
+	Py_ssize_t count = PySequence_Fast_GET_SIZE(handles);
+
+	if(PyArray_SIZE(reinterpret_cast<PyArrayObject*>(array)) != count)
+	{
+		Py_DECREF(handles);
+		PyErr_SetString(PyExc_ValueError, "The number of updates has to match the number of handles!");
+		return nullptr;
+	}
+
+	static const char* names[] = {"location", "velocity", "orientation", "volume", "pitch"};
+	static const int flags[] = {HANDLE_UPDATE_LOCATION, HANDLE_UPDATE_VELOCITY, HANDLE_UPDATE_ORIENTATION, HANDLE_UPDATE_VOLUME, HANDLE_UPDATE_PITCH};
+	static const npy_intp widths[] = {3, 3, 4, 1, 1};
+
+	PyArrayObject* fields[5];
+	float* data[5];
+	int update_flags = 0;
+	bool valid = true;
+
+	for(int i = 0; i < 5; i++)
+	{
+		if(valid)
+			valid = getUpdateField(array, names[i], widths[i], fields[i]);
+		else
+			fields[i] = nullptr;
+
+		if(fields[i])
+		{
+			update_flags |= flags[i];
+			data[i] = reinterpret_cast<float*>(PyArray_DATA(fields[i]));
+		}
+	}
+
+	std::vector<HandleUpdate> updates;
+	std::vector<std::shared_ptr<IHandle>> references;
+
+	if(valid)
+	{
+		updates.resize(count);
+		references.reserve(count);
+
+		for(Py_ssize_t i = 0; i < count; i++)
+		{
+			Handle* handle = checkHandle(PySequence_Fast_GET_ITEM(handles, i));
+
+			if(!handle)
+			{
+				valid = false;
+				break;
+			}
+
+			HandleUpdate& update = updates[i];
+
+			references.push_back(*reinterpret_cast<std::shared_ptr<IHandle>*>(handle->handle));
+			update.handle = references.back().get();
+			update.flags = update_flags;
+
+			if(fields[0])
+				update.location = Vector3(data[0][i * 3], data[0][i * 3 + 1], data[0][i * 3 + 2]);
+			if(fields[1])
+				update.velocity = Vector3(data[1][i * 3], data[1][i * 3 + 1], data[1][i * 3 + 2]);
+			if(fields[2])
+				update.orientation = Quaternion(data[2][i * 4], data[2][i * 4 + 1], data[2][i * 4 + 2], data[2][i * 4 + 3]);
+			if(fields[3])
+				update.volume = data[3][i];
+			if(fields[4])
+				update.pitch = data[4][i];
+		}
+	}
+
+	for(int i = 0; i < 5; i++)
+		Py_XDECREF(fields[i]);
+
+	Py_DECREF(handles);
+
+	if(!valid)
+		return nullptr;
+
+	int applied;
+
+	try
+	{
+		// the device may be locked by another Python thread
+		PyAllowThreads allow;
+
+		applied = applyHandleUpdates(**reinterpret_cast<std::shared_ptr<IDevice>*>(self->device), updates.data(), int(count));
+	}
+	catch(Exception& e)
+	{
+		PyErr_SetString(AUDError, e.what());
+		return nullptr;
+	}
+
+	return Py_BuildValue("i", applied);
+}
+
 static PyMethodDef Device_methods[] = {
+	{"getProfile", (PyCFunction)Device_getProfile, METH_VARARGS,
+	 M_aud_Device_getProfile_doc
+	},
 	{"lock", (PyCFunction)Device_lock, METH_NOARGS,
 	 M_aud_Device_lock_doc
 	},
 	{"play", (PyCFunction)Device_play, METH_VARARGS | METH_KEYWORDS,
 	 M_aud_Device_play_doc
 	},
+	{"playAt", (PyCFunction)Device_playAt, METH_VARARGS | METH_KEYWORDS,
+	 M_aud_Device_playAt_doc
+	},
+	{"resetStats", (PyCFunction)Device_resetStats, METH_NOARGS,
+	 M_aud_Device_resetStats_doc
+	},
 	{"stopAll", (PyCFunction)Device_stopAll, METH_NOARGS,
 	 M_aud_Device_stopAll_doc
 	},
+	{"stopAt", (PyCFunction)Device_stopAt, METH_VARARGS,
+	 M_aud_Device_stopAt_doc
+	},
 	{"unlock", (PyCFunction)Device_unlock, METH_NOARGS,
 	 M_aud_Device_unlock_doc
 	},
+	{"updateHandles", (PyCFunction)Device_updateHandles, METH_VARARGS,
+	 M_aud_Device_updateHandles_doc
+	},
 	{nullptr}  /* Sentinel */
 };
 
@@ -284,6 +700,25 @@ Device_get_channels(Device* self, void* nothing)
 	}
 }
 
+PyDoc_STRVAR(M_aud_Device_clock_doc,
+			 "The current time of the device timeline in seconds, which counts\n"
+			 "all samples mixed so far and is the reference for\n"
+			 ":meth:`playAt` and :meth:`stopAt`.");
+
+static PyObject *
+Device_get_clock(Device* self, void* nothing)
+{
+	SoftwareDevice* device = dynamic_cast<SoftwareDevice*>(reinterpret_cast<std::shared_ptr<IDevice>*>(self->device)->get());
+
+	if(!device)
+	{
+		PyErr_SetString(AUDError, device_not_software_error);
+		return nullptr;
+	}
+
+	return Py_BuildValue("d", device->getClock());
+}
+
 PyDoc_STRVAR(M_aud_Device_distance_model_doc,
 			 "The distance model of the device.\n\n"
 			 ".. seealso:: `OpenAL Documentation <https://www.openal.org/documentation/>`__");
@@ -412,6 +847,21 @@ Device_get_format(Device* self, void* nothing)
 	}
 }
 
+PyDoc_STRVAR(M_aud_Device_latency_doc,
+			 "The output latency of the device in seconds, the time between\n"
+			 "mixing a sample and its playback or 0 if it is unknown.");
+
+static PyObject *
+Device_get_latency(Device* self, void* nothing)
+{
+	SoftwareDevice* device = dynamic_cast<SoftwareDevice*>(reinterpret_cast<std::shared_ptr<IDevice>*>(self->device)->get());
+
+	if(!device)
+		return Py_BuildValue("d", 0.0);
+
+	return Py_BuildValue("d", device->getLatency());
+}
+
 PyDoc_STRVAR(M_aud_Device_listener_location_doc,
 			 "The listeners's location in 3D space, a 3D tuple of floats.");
 
@@ -649,6 +1099,78 @@ Device_set_speed_of_sound(Device* self, PyObject* args, void* nothing)
 	return -1;
 }
 
+PyDoc_STRVAR(M_aud_Device_stats_doc,
+			 "The timing statistics of the device since they were last reset as\n"
+			 "a dict, see :attr:`stats_enabled`. Times are in seconds, the\n"
+			 "jitter is the deviation of the interval between audio callbacks\n"
+			 "from the buffer period and the fill level of the ring buffer is\n"
+			 "between 0 and 1.");
+
+static PyObject *
+Device_get_stats(Device* self, void* nothing)
+{
+	SoftwareDevice* device = dynamic_cast<SoftwareDevice*>(reinterpret_cast<std::shared_ptr<IDevice>*>(self->device)->get());
+
+	if(!device)
+	{
+		PyErr_SetString(AUDError, device_not_software_error);
+		return nullptr;
+	}
+
+	DeviceStatistics stats = device->getStatistics();
+
+	return Py_BuildValue("{s:K,s:d,s:d,s:d,s:d,s:d,s:i,s:K,s:d,s:d,s:d,s:f,s:f,s:K}",
+						 "mixes", (unsigned long long)stats.mixes,
+						 "mix_time_mean", stats.mix_time_mean,
+						 "mix_time_median", stats.mix_time_median,
+						 "mix_time_p99", stats.mix_time_p99,
+						 "mix_time_max", stats.mix_time_max,
+						 "voices_mean", stats.voices_mean,
+						 "voices_max", stats.voices_max,
+						 "callbacks", (unsigned long long)stats.callbacks,
+						 "interval_mean", stats.interval_mean,
+						 "jitter_p99", stats.jitter_p99,
+						 "jitter_max", stats.jitter_max,
+						 "fill_mean", stats.fill_mean,
+						 "fill_min", stats.fill_min,
+						 "underruns", (unsigned long long)stats.underruns);
+}
+
+PyDoc_STRVAR(M_aud_Device_stats_enabled_doc,
+			 "Whether the device records timing statistics, see :attr:`stats`.");
+
+static PyObject *
+Device_get_stats_enabled(Device* self, void* nothing)
+{
+	SoftwareDevice* device = dynamic_cast<SoftwareDevice*>(reinterpret_cast<std::shared_ptr<IDevice>*>(self->device)->get());
+
+	if(!device)
+		Py_RETURN_FALSE;
+
+	return PyBool_FromLong((long)device->isStatisticsEnabled());
+}
+
+static int
+Device_set_stats_enabled(Device* self, PyObject* args, void* nothing)
+{
+	if(!PyBool_Check(args))
+	{
+		PyErr_SetString(PyExc_TypeError, "stats_enabled is not a boolean!");
+		return -1;
+	}
+
+	SoftwareDevice* device = dynamic_cast<SoftwareDevice*>(reinterpret_cast<std::shared_ptr<IDevice>*>(self->device)->get());
+
+	if(!device)
+	{
+		PyErr_SetString(AUDError, device_not_software_error);
+		return -1;
+	}
+
+	device->setStatisticsEnabled(args == Py_True);
+	return 0;
+}
+
 PyDoc_STRVAR(M_aud_Device_volume_doc,
 			 "The overall volume of the device.");
 
@@ -689,12 +1211,16 @@ Device_set_volume(Device* self, PyObject* args, void* nothing)
 static PyGetSetDef Device_properties[] = {
 	{(char*)"channels", (getter)Device_get_channels, nullptr,
 	 M_aud_Device_channels_doc, nullptr },
+	{(char*)"clock", (getter)Device_get_clock, nullptr,
+	 M_aud_Device_clock_doc, nullptr },
 	{(char*)"distance_model", (getter)Device_get_distance_model, (setter)Device_set_distance_model,
 	 M_aud_Device_distance_model_doc, nullptr },
 	{(char*)"doppler_factor", (getter)Device_get_doppler_factor, (setter)Device_set_doppler_factor,
 	 M_aud_Device_doppler_factor_doc, nullptr },
 	{(char*)"format", (getter)Device_get_format, nullptr,
 	 M_aud_Device_format_doc, nullptr },
+	{(char*)"latency", (getter)Device_get_latency, nullptr,
+	 M_aud_Device_latency_doc, nullptr },
 	{(char*)"listener_location", (getter)Device_get_listener_location, (setter)Device_set_listener_location,
 	 M_aud_Device_listener_location_doc, nullptr },
 	{(char*)"listener_orientation", (getter)Device_get_listener_orientation, (setter)Device_set_listener_orientation,
@@ -705,6 +1231,10 @@ static PyGetSetDef Device_properties[] = {
 	 M_aud_Device_rate_doc, nullptr },
 	{(char*)"speed_of_sound", (getter)Device_get_speed_of_sound, (setter)Device_set_speed_of_sound,
 	 M_aud_Device_speed_of_sound_doc, nullptr },
+	{(char*)"stats", (getter)Device_get_stats, nullptr,
+	 M_aud_Device_stats_doc, nullptr },
+	{(char*)"stats_enabled", (getter)Device_get_stats_enabled, (setter)Device_set_stats_enabled,
+	 M_aud_Device_stats_enabled_doc, nullptr },
 	{(char*)"volume", (getter)Device_get_volume, (setter)Device_set_volume,
 	 M_aud_Device_volume_doc, nullptr },
 	{nullptr}  /* Sentinel */
@@ -724,6 +1254,8 @@ PyDoc_STRVAR(M_aud_Device_doc,
 			 "   :arg format: The sample format.\n"
 			 "   :type format: int\n"
 			 "   :arg buffer_size: The size of the audio buffer in samples.\n"
+			 "      0 mixes directly in the audio callback for the lowest\n"
+			 "      latency, which only the JACK and PipeWire devices support.\n"
 			 "   :type buffer_size: int\n"
 			 "   :arg name: The name of the device.\n"
 			 "   :type name: string\n");
@@ -789,6 +1321,8 @@ AUD_API Device* checkDevice(PyObject* device)
 
 bool initializeDevice()
 {
+	import_array1(false);
+
 	return PyType_Ready(&DeviceType) >= 0;
 }
 
@@ -16,6 +16,7 @@
 
 #include "PyHRTF.h"
 #include "PySound.h"
+#include "PyAllowThreads.h"
 
 #include "Exception.h"
 #include "fx/HRTF.h"
@@ -80,7 +81,16 @@ HRTF_addImpulseResponseFromSound(HRTFP* self, PyObject* args)
 
 	try
 	{
-		return PyBool_FromLong((long)(*reinterpret_cast<std::shared_ptr<aud::HRTF>*>(self->hrtf))->addImpulseResponse(std::make_shared<aud::StreamBuffer>(*reinterpret_cast<std::shared_ptr<aud::ISound>*>(ir->sound)), azimuth, elevation));
+		std::shared_ptr<aud::HRTF> hrtf = *reinterpret_cast<std::shared_ptr<aud::HRTF>*>(self->hrtf);
+		std::shared_ptr<aud::ISound> sound = *reinterpret_cast<std::shared_ptr<aud::ISound>*>(ir->sound);
+		bool added;
+
+		{
+			PyAllowThreads allow;
+			added = hrtf->addImpulseResponse(std::make_shared<aud::StreamBuffer>(sound), azimuth, elevation);
+		}
+
+		return PyBool_FromLong((long)added);
 	}
 	catch(aud::Exception& e)
 	{
@@ -113,6 +123,7 @@ HRTF_loadLeftHrtfSet(PyTypeObject* type, PyObject* args)
 
 	try
 	{
+		PyAllowThreads allow;
 		self->hrtf = new std::shared_ptr<aud::HRTF>(aud::HRTFLoader::loadLeftHRTFs(ext, dir));
 	}
 	catch(aud::Exception& e)
@@ -148,6 +159,7 @@ HRTF_loadRightHrtfSet(PyTypeObject* type, PyObject* args)
 
 	try
 	{
+		PyAllowThreads allow;
 		self->hrtf = new std::shared_ptr<aud::HRTF>(aud::HRTFLoader::loadRightHRTFs(ext, dir));
 	}
 	catch(aud::Exception& e)
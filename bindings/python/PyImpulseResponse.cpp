@@ -16,6 +16,7 @@
 
 #include "PyImpulseResponse.h"
 #include "PySound.h"
+#include "PyAllowThreads.h"
 
 #include "Exception.h"
 #include "fx/ImpulseResponse.h"
@@ -37,7 +38,10 @@ ImpulseResponse_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
 
 		try
 		{
-			self->impulseResponse = new std::shared_ptr<aud::ImpulseResponse>(new aud::ImpulseResponse(std::make_shared<aud::StreamBuffer>(*reinterpret_cast<std::shared_ptr<aud::ISound>*>(sound->sound))));
+			std::shared_ptr<aud::ISound> ir = *reinterpret_cast<std::shared_ptr<aud::ISound>*>(sound->sound);
+
+			PyAllowThreads allow;
+			self->impulseResponse = new std::shared_ptr<aud::ImpulseResponse>(new aud::ImpulseResponse(std::make_shared<aud::StreamBuffer>(ir)));
 		}
 		catch(aud::Exception& e)
 		{
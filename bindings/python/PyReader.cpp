@@ -0,0 +1,405 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "PyAllowThreads.h"
+#include "PyReader.h"
+#include "PySound.h"
+
+#include "Exception.h"
+#include "IReader.h"
+#include "ISound.h"
+#include "fx/PrefetchReader.h"
+#include "util/Buffer.h"
+
+#include <memory>
+#include <mutex>
+
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <numpy/ndarrayobject.h>
+
+using namespace aud;
+
+extern PyObject* AUDError;
+
+/**
+ * The native state of a Reader object.
+ */
+struct ReaderState
+{
+	/// The reader of the sound.
+	std::shared_ptr<IReader> reader;
+
+	/// The buffer reused for every block.
+	Buffer buffer;
+
+	/// The specification of the reader.
+	Specs specs;
+
+	/// The number of samples per block.
+	int block_size;
+
+	/// Serializes reads and seeks of different Python threads.
+	std::mutex mutex;
+};
+
+static ReaderState* Reader_state(Reader* self)
+{
+	return reinterpret_cast<ReaderState*>(self->reader);
+}
+
+static PyObject *
+Reader_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+	PyObject* object;
+	int block_size = 4096;
+	int prefetch = 0;
+
+	static const char* kwlist[] = {"sound", "block_size", "prefetch", nullptr};
+
+	if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|ii:Reader", const_cast<char**>(kwlist), &object, &block_size, &prefetch))
+		return nullptr;
+
+	Sound* sound = checkSound(object);
+
+	if(!sound)
+		return nullptr;
+
+	if(block_size <= 0)
+	{
+		PyErr_SetString(PyExc_ValueError, "block_size must be positive!");
+		return nullptr;
+	}
+
+	if(prefetch < 0)
+	{
+		PyErr_SetString(PyExc_ValueError, "prefetch must not be negative!");
+		return nullptr;
+	}
+
+	Reader* self = (Reader*)type->tp_alloc(type, 0);
+
+	if(self != nullptr)
+	{
+		try
+		{
+			ReaderState* state = new ReaderState();
+			self->reader = state;
+			state->block_size = block_size;
+
+			std::shared_ptr<ISound> isound = *reinterpret_cast<std::shared_ptr<ISound>*>(sound->sound);
+
+			PyAllowThreads allow;
+
+			state->reader = isound->createReader();
+			state->specs = state->reader->getSpecs();
+
+			if(prefetch > 0)
+				state->reader = std::make_shared<PrefetchReader>(state->reader, prefetch * block_size, block_size);
+
+			state->buffer.resize(block_size * AUD_SAMPLE_SIZE(state->specs));
+		}
+		catch(Exception& e)
+		{
+			Py_DECREF(self);
+			PyErr_SetString(AUDError, e.what());
+			return nullptr;
+		}
+	}
+
+	return (PyObject *)self;
+}
+
+static void
+Reader_dealloc(Reader* self)
+{
+	if(self->reader)
+	{
+		// stopping a prefetching thread may have to wait for a read
+		PyAllowThreads allow;
+		delete Reader_state(self);
+	}
+
+	Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+Reader_iter(Reader* self)
+{
+	Py_INCREF(self);
+	return (PyObject *)self;
+}
+
+static PyObject *
+Reader_iternext(Reader* self)
+{
+	ReaderState* state = Reader_state(self);
+
+	int length = state->block_size;
+	bool eos = false;
+
+	try
+	{
+		PyAllowThreads allow;
+
+		std::lock_guard<std::mutex> lock(state->mutex);
+
+		state->reader->read(length, eos, state->buffer.getBuffer());
+	}
+	catch(Exception& e)
+	{
+		PyErr_SetString(AUDError, e.what());
+		return nullptr;
+	}
+	catch(std::exception& e)
+	{
+		// the prefetching thread passes on any exception of the reader
+		PyErr_SetString(AUDError, e.what());
+		return nullptr;
+	}
+
+	// returning without an exception set stops the iteration
+	if(length <= 0)
+		return nullptr;
+
+	npy_intp dimensions[2];
+	dimensions[0] = length;
+	dimensions[1] = state->specs.channels;
+
+	PyObject* array = PyArray_SimpleNewFromData(2, dimensions, NPY_FLOAT, state->buffer.getBuffer());
+
+	if(!array)
+		return nullptr;
+
+	// the array keeps the reader and thus the buffer alive
+	Py_INCREF(self);
+
+	if(PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(array), (PyObject *)self) < 0)
+	{
+		Py_DECREF(array);
+		return nullptr;
+	}
+
+	return array;
+}
+
+PyDoc_STRVAR(M_aud_Reader_seek_doc,
+			 ".. method:: seek(position)\n\n"
+			 "   Seeks to a position in the sound, the next block starts there.\n\n"
+			 "   :arg position: The position in samples.\n"
+			 "   :type position: int");
+
+static PyObject *
+Reader_seek(Reader* self, PyObject* args)
+{
+	int position;
+
+	if(!PyArg_ParseTuple(args, "i:seek", &position))
+		return nullptr;
+
+	ReaderState* state = Reader_state(self);
+
+	try
+	{
+		PyAllowThreads allow;
+
+		std::lock_guard<std::mutex> lock(state->mutex);
+
+		state->reader->seek(position);
+	}
+	catch(Exception& e)
+	{
+		PyErr_SetString(AUDError, e.what());
+		return nullptr;
+	}
+
+	Py_RETURN_NONE;
+}
+
+static PyMethodDef Reader_methods[] = {
+	{"seek", (PyCFunction)Reader_seek, METH_VARARGS,
+	 M_aud_Reader_seek_doc
+	},
+	{nullptr}  /* Sentinel */
+};
+
+PyDoc_STRVAR(M_aud_Reader_position_doc,
+			 "The position of the next block in samples.");
+
+static PyObject *
+Reader_get_position(Reader* self, void* nothing)
+{
+	ReaderState* state = Reader_state(self);
+
+	int position;
+
+	{
+		PyAllowThreads allow;
+
+		std::lock_guard<std::mutex> lock(state->mutex);
+
+		position = state->reader->getPosition();
+	}
+
+	return Py_BuildValue("i", position);
+}
+
+PyDoc_STRVAR(M_aud_Reader_length_doc,
+			 "The length of the sound in samples or a negative value if unknown.");
+
+static PyObject *
+Reader_get_length(Reader* self, void* nothing)
+{
+	ReaderState* state = Reader_state(self);
+
+	int length;
+
+	{
+		PyAllowThreads allow;
+
+		std::lock_guard<std::mutex> lock(state->mutex);
+
+		length = state->reader->getLength();
+	}
+
+	return Py_BuildValue("i", length);
+}
+
+PyDoc_STRVAR(M_aud_Reader_specs_doc,
+			 "The sample specification of the blocks as a tuple with rate and channel count.");
+
+static PyObject *
+Reader_get_specs(Reader* self, void* nothing)
+{
+	ReaderState* state = Reader_state(self);
+
+	return Py_BuildValue("(di)", state->specs.rate, state->specs.channels);
+}
+
+PyDoc_STRVAR(M_aud_Reader_block_size_doc,
+			 "The number of samples per block, only the last block may be shorter.");
+
+static PyObject *
+Reader_get_block_size(Reader* self, void* nothing)
+{
+	return Py_BuildValue("i", Reader_state(self)->block_size);
+}
+
+static PyGetSetDef Reader_properties[] = {
+	{(char*)"position", (getter)Reader_get_position, nullptr,
+	 M_aud_Reader_position_doc, nullptr },
+	{(char*)"length", (getter)Reader_get_length, nullptr,
+	 M_aud_Reader_length_doc, nullptr },
+	{(char*)"specs", (getter)Reader_get_specs, nullptr,
+	 M_aud_Reader_specs_doc, nullptr },
+	{(char*)"block_size", (getter)Reader_get_block_size, nullptr,
+	 M_aud_Reader_block_size_doc, nullptr },
+	{nullptr}  /* Sentinel */
+};
+
+PyDoc_STRVAR(M_aud_Reader_doc,
+			 ".. class:: Reader(sound, block_size=4096, prefetch=0)\n\n"
+			 "   Reader objects stream a sound in blocks of samples, so that long\n"
+			 "   sounds can be analyzed without loading them into memory at once.\n"
+			 "   Iterating over a reader yields two dimensional numpy float arrays\n"
+			 "   with the shape (samples, channels).\n\n"
+			 "   :arg sound: The sound to read.\n"
+			 "   :type sound: :class:`Sound`\n"
+			 "   :arg block_size: The number of samples per block.\n"
+			 "   :type block_size: int\n"
+			 "   :arg prefetch: The number of blocks a background thread reads\n"
+			 "      ahead while Python processes the current block, 0 disables\n"
+			 "      prefetching.\n"
+			 "   :type prefetch: int\n\n"
+			 "   .. warning:: All blocks share the same memory, which is\n"
+			 "      overwritten by reading the next block, copy a block to keep it.");
+
+PyTypeObject ReaderType = {
+	PyVarObject_HEAD_INIT(nullptr, 0)
+	"aud.Reader",							/* tp_name */
+	sizeof(Reader),							/* tp_basicsize */
+	0,										/* tp_itemsize */
+	(destructor)Reader_dealloc,				/* tp_dealloc */
+	0,										/* tp_print */
+	0,										/* tp_getattr */
+	0,										/* tp_setattr */
+	0,										/* tp_reserved */
+	0,										/* tp_repr */
+	0,										/* tp_as_number */
+	0,										/* tp_as_sequence */
+	0,										/* tp_as_mapping */
+	0,										/* tp_hash  */
+	0,										/* tp_call */
+	0,										/* tp_str */
+	0,										/* tp_getattro */
+	0,										/* tp_setattro */
+	0,										/* tp_as_buffer */
+	Py_TPFLAGS_DEFAULT,						/* tp_flags */
+	M_aud_Reader_doc,						/* tp_doc */
+	0,										/* tp_traverse */
+	0,										/* tp_clear */
+	0,										/* tp_richcompare */
+	0,										/* tp_weaklistoffset */
+	(getiterfunc)Reader_iter,				/* tp_iter */
+	(iternextfunc)Reader_iternext,			/* tp_iternext */
+	Reader_methods,							/* tp_methods */
+	0,										/* tp_members */
+	Reader_properties,						/* tp_getset */
+	0,										/* tp_base */
+	0,										/* tp_dict */
+	0,										/* tp_descr_get */
+	0,										/* tp_descr_set */
+	0,										/* tp_dictoffset */
+	0,										/* tp_init */
+	0,										/* tp_alloc */
+	Reader_new,								/* tp_new */
+};
+
+AUD_API PyObject* Reader_create(PyObject* sound, int block_size, int prefetch)
+{
+	PyObject* args = Py_BuildValue("(Oii)", sound, block_size, prefetch);
+
+	if(!args)
+		return nullptr;
+
+	PyObject* reader = Reader_new(&ReaderType, args, nullptr);
+	Py_DECREF(args);
+
+	return reader;
+}
+
+AUD_API Reader* checkReader(PyObject* reader)
+{
+	if(!PyObject_TypeCheck(reader, &ReaderType))
+	{
+		PyErr_SetString(PyExc_TypeError, "Object is not of type Reader!");
+		return nullptr;
+	}
+
+	return (Reader*)reader;
+}
+
+bool initializeReader()
+{
+	import_array1(false);
+
+	return PyType_Ready(&ReaderType) >= 0;
+}
+
+void addReaderToModule(PyObject* module)
+{
+	Py_INCREF(&ReaderType);
+	PyModule_AddObject(module, "Reader", (PyObject *)&ReaderType);
+}
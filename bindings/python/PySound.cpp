@@ -14,7 +14,9 @@
  * limitations under the License.
  ******************************************************************************/
 
+#include "PyAllowThreads.h"
 #include "PyAnimateableProperty.h"
+#include "PyReader.h"
 #include "PySound.h"
 #include "PySource.h"
 #include "PyThreadPool.h"
@@ -110,6 +112,7 @@ Sound_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
 
 		try
 		{
+			PyAllowThreads allow;
 			self->sound = new std::shared_ptr<ISound>(new File(filename, stream));
 		}
 		catch(Exception& e)
@@ -126,9 +129,16 @@ Sound_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
 PyDoc_STRVAR(M_aud_Sound_data_doc,
 			 ".. method:: data()\n\n"
 			 "   Retrieves the data of the sound as numpy array.\n\n"
-			 "   :return: A two dimensional numpy float array.\n"
+			 "   :return: A two dimensional read-only numpy float array.\n"
 			 "   :rtype: :class:`numpy.ndarray`\n\n"
-			 "   .. note:: Best efficiency with cached sounds.");
+			 "   .. note:: Best efficiency with cached sounds, whose data is\n"
+			 "      shared with the array instead of being copied.");
+
+static void
+Sound_releaseBuffer(PyObject* capsule)
+{
+	delete reinterpret_cast<std::shared_ptr<Buffer>*>(PyCapsule_GetPointer(capsule, nullptr));
+}
 
 static PyObject *
 Sound_data(Sound* self)
@@ -139,7 +149,10 @@ Sound_data(Sound* self)
 
 		auto stream_buffer = std::dynamic_pointer_cast<StreamBuffer>(sound);
 		if(!stream_buffer)
+		{
+			PyAllowThreads allow;
 			stream_buffer = std::make_shared<StreamBuffer>(sound);
+		}
 		Specs specs = stream_buffer->getSpecs();
 		auto buffer = stream_buffer->getBuffer();
 
@@ -147,13 +160,32 @@ Sound_data(Sound* self)
 		dimensions[0] = buffer->getSize() / AUD_SAMPLE_SIZE(specs);
 		dimensions[1] = specs.channels;
 
-		PyArrayObject* array = reinterpret_cast<PyArrayObject*>(PyArray_SimpleNew(2, dimensions, NPY_FLOAT));
+		PyObject* array = PyArray_SimpleNewFromData(2, dimensions, NPY_FLOAT, buffer->getBuffer());
+
+		if(!array)
+			return nullptr;
+
+		// the array keeps the buffer alive
+		std::shared_ptr<Buffer>* owner = new std::shared_ptr<Buffer>(buffer);
+		PyObject* capsule = PyCapsule_New(owner, nullptr, Sound_releaseBuffer);
+
+		if(!capsule)
+		{
+			delete owner;
+			Py_DECREF(array);
+			return nullptr;
+		}
 
-		sample_t* data = reinterpret_cast<sample_t*>(PyArray_DATA(array));
+		if(PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(array), capsule) < 0)
+		{
+			Py_DECREF(array);
+			return nullptr;
+		}
 
-		std::memcpy(data, buffer->getBuffer(), buffer->getSize());
+		// the data may be shared with other sounds
+		PyArray_CLEARFLAGS(reinterpret_cast<PyArrayObject*>(array), NPY_ARRAY_WRITEABLE);
 
-		return reinterpret_cast<PyObject*>(array);
+		return array;
 	}
 	catch(Exception& e)
 	{
@@ -162,6 +194,35 @@ Sound_data(Sound* self)
 	}
 }
 
+PyDoc_STRVAR(M_aud_Sound_blocks_doc,
+			 ".. method:: blocks(block_size=4096, prefetch=0)\n\n"
+			 "   Streams the data of the sound in blocks of samples.\n\n"
+			 "   Unlike :meth:`data` this doesn't load the whole sound into memory,\n"
+			 "   which makes it suitable for the analysis of long recordings.\n\n"
+			 "   :arg block_size: The number of samples per block.\n"
+			 "   :type block_size: int\n"
+			 "   :arg prefetch: The number of blocks a background thread reads\n"
+			 "      ahead, 0 disables prefetching.\n"
+			 "   :type prefetch: int\n"
+			 "   :return: An iterator over two dimensional numpy float arrays.\n"
+			 "   :rtype: :class:`Reader`\n\n"
+			 "   .. warning:: All blocks share the same memory, which is\n"
+			 "      overwritten by reading the next block, copy a block to keep it.");
+
+static PyObject *
+Sound_blocks(Sound* self, PyObject* args, PyObject* kwds)
+{
+	int block_size = 4096;
+	int prefetch = 0;
+
+	static const char* kwlist[] = {"block_size", "prefetch", nullptr};
+
+	if(!PyArg_ParseTupleAndKeywords(args, kwds, "|ii:blocks", const_cast<char**>(kwlist), &block_size, &prefetch))
+		return nullptr;
+
+	return Reader_create((PyObject *)self, block_size, prefetch);
+}
+
 PyDoc_STRVAR(M_aud_Sound_write_doc,
 			 ".. method:: write(filename, rate, channels, format, container, codec, bitrate, buffersize)\n\n"
 			 "   Writes the sound to a file.\n\n"
@@ -201,26 +262,8 @@ Sound_write(Sound* self, PyObject* args, PyObject* kwds)
 
 	try
 	{
-		std::shared_ptr<IReader> reader = (*reinterpret_cast<std::shared_ptr<ISound>*>(self->sound))->createReader();
-
-		DeviceSpecs specs;
-		specs.specs = reader->getSpecs();
-
-		if((rate != RATE_INVALID) && (specs.rate != rate))
-		{
-			specs.rate = rate;
-			reader = std::make_shared<JOSResampleReader>(reader, rate);
-		}
-
-		if((channels != CHANNELS_INVALID) && (specs.channels != channels))
-		{
-			specs.channels = channels;
-			reader = std::make_shared<ChannelMapperReader>(reader, channels);
-		}
-
 		if(format == FORMAT_INVALID)
 			format = FORMAT_S16;
-		specs.format = format;
 
 		const char* invalid_container_error = "Container could not be determined from filename.";
 
@@ -296,6 +339,29 @@ Sound_write(Sound* self, PyObject* args, PyObject* kwds)
 		if(buffersize <= 0)
 			buffersize = AUD_DEFAULT_BUFFER_SIZE;
 
+		std::shared_ptr<ISound> sound = *reinterpret_cast<std::shared_ptr<ISound>*>(self->sound);
+
+		PyAllowThreads allow;
+
+		std::shared_ptr<IReader> reader = sound->createReader();
+
+		DeviceSpecs specs;
+		specs.specs = reader->getSpecs();
+
+		if((rate != RATE_INVALID) && (specs.rate != rate))
+		{
+			specs.rate = rate;
+			reader = std::make_shared<JOSResampleReader>(reader, rate);
+		}
+
+		if((channels != CHANNELS_INVALID) && (specs.channels != channels))
+		{
+			specs.channels = channels;
+			reader = std::make_shared<ChannelMapperReader>(reader, channels);
+		}
+
+		specs.format = format;
+
 		std::shared_ptr<IWriter> writer = FileWriter::createWriter(filename, specs, container, codec, bitrate);
 		FileWriter::writeReader(reader, writer, 0, buffersize);
 	}
@@ -311,6 +377,8 @@ Sound_write(Sound* self, PyObject* args, PyObject* kwds)
 PyDoc_STRVAR(M_aud_Sound_buffer_doc,
 			 ".. classmethod:: buffer(data, rate)\n\n"
 			 "   Creates a sound from a data buffer.\n\n"
+			 "   A C-contiguous array is used without copying, so later changes\n"
+			 "   to the array change the sound.\n\n"
 			 "   :arg data: The data as two dimensional numpy array.\n"
 			 "   :type data: :class:`numpy.ndarray`\n"
 			 "   :arg rate: The sample rate.\n"
@@ -318,6 +386,29 @@ PyDoc_STRVAR(M_aud_Sound_buffer_doc,
 			 "   :return: The created :class:`Sound` object.\n"
 			 "   :rtype: :class:`Sound`");
 
+static int
+Sound_decrefArray(void* array)
+{
+	Py_DECREF(reinterpret_cast<PyObject*>(array));
+	return 0;
+}
+
+static void
+Sound_releaseArray(PyObject* array)
+{
+	if(!Py_IsInitialized())
+		return;
+
+	if(PyGILState_Check())
+	{
+		Py_DECREF(array);
+		return;
+	}
+
+	// the buffer may be released on the mixing thread, which must not wait for the interpreter
+	Py_AddPendingCall(Sound_decrefArray, array);
+}
+
 static PyObject *
 Sound_buffer(PyTypeObject* type, PyObject* args)
 {
@@ -352,11 +443,18 @@ Sound_buffer(PyTypeObject* type, PyObject* args)
 	if(PyArray_NDIM(array) == 2)
 		specs.channels = static_cast<Channels>(PyArray_DIM(array, 1));
 
-	int size = PyArray_DIM(array, 0) * AUD_SAMPLE_SIZE(specs);
+	// only copies the data if the array is not contiguous
+	PyObject* contiguous = PyArray_FROM_OTF(reinterpret_cast<PyObject*>(array), NPY_FLOAT, NPY_ARRAY_IN_ARRAY);
 
-	std::shared_ptr<Buffer> buffer = std::make_shared<Buffer>(size);
+	if(!contiguous)
+		return nullptr;
 
-	std::memcpy(buffer->getBuffer(), PyArray_DATA(array), size);
+	long long size = static_cast<long long>(PyArray_DIM(array, 0)) * AUD_SAMPLE_SIZE(specs);
+
+	std::shared_ptr<Buffer> buffer = std::make_shared<Buffer>(reinterpret_cast<sample_t*>(PyArray_DATA(reinterpret_cast<PyArrayObject*>(contiguous))), size, [contiguous]()
+	{
+		Sound_releaseArray(contiguous);
+	});
 
 	Sound* self;
 
@@ -401,7 +499,10 @@ Sound_cache(Sound* self)
 	{
 		try
 		{
-			parent->sound = new std::shared_ptr<ISound>(new StreamBuffer(*reinterpret_cast<std::shared_ptr<ISound>*>(self->sound)));
+			std::shared_ptr<ISound> sound = *reinterpret_cast<std::shared_ptr<ISound>*>(self->sound);
+
+			PyAllowThreads allow;
+			parent->sound = new std::shared_ptr<ISound>(new StreamBuffer(sound));
 		}
 		catch(Exception& e)
 		{
@@ -442,6 +543,7 @@ Sound_file(PyTypeObject* type, PyObject* args)
 	{
 		try
 		{
+			PyAllowThreads allow;
 			self->sound = new std::shared_ptr<ISound>(new File(filename, stream));
 		}
 		catch(Exception& e)
@@ -2012,6 +2114,9 @@ static PyMethodDef Sound_methods[] = {
 	{"data", (PyCFunction)Sound_data, METH_NOARGS,
 	 M_aud_Sound_data_doc
 	},
+	{"blocks", (PyCFunction)Sound_blocks, METH_VARARGS | METH_KEYWORDS,
+	 M_aud_Sound_blocks_doc
+	},
 	{"write", (PyCFunction)Sound_write, METH_VARARGS | METH_KEYWORDS,
 	 M_aud_Sound_write_doc
 	},
@@ -0,0 +1,309 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "devices/I3DHandle.h"
+#include "devices/IHandle.h"
+#include "devices/ReadDevice.h"
+#include "file/File.h"
+#include "fx/Butterworth.h"
+#include "fx/Highpass.h"
+#include "fx/Lowpass.h"
+#include "fx/Volume.h"
+#include "generator/Sawtooth.h"
+#include "plugin/PluginManager.h"
+#include "util/Buffer.h"
+#include "util/StreamBuffer.h"
+#include "Exception.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace aud;
+
+struct Scene
+{
+	int voices = 64;
+	std::string type = "cached";
+	std::string file;
+	bool spatial = false;
+	std::vector<std::string> effects;
+	ResampleQuality quality = ResampleQuality::HIGH;
+	int buffersize = 512;
+	double duration = 10;
+	SampleRate rate = RATE_44100;
+};
+
+struct Result
+{
+	double realtime;
+	double period;
+	double p50;
+	double p90;
+	double p99;
+	double max;
+};
+
+static std::shared_ptr<ISound> createSound(const Scene& scene, int voice, std::shared_ptr<ISound> source)
+{
+	std::shared_ptr<ISound> sound = source;
+
+	// generated voices are cheap to create, so every voice gets its own pitch
+	if(scene.type == "generated")
+		sound = std::make_shared<Sawtooth>(110 + 10 * (voice % 64), scene.rate);
+
+	for(auto& effect : scene.effects)
+	{
+		if(effect == "lowpass")
+			sound = std::make_shared<Lowpass>(sound, 2000);
+		else if(effect == "highpass")
+			sound = std::make_shared<Highpass>(sound, 200);
+		else if(effect == "butterworth")
+			sound = std::make_shared<Butterworth>(sound, 1000);
+		else if(effect == "volume")
+			sound = std::make_shared<Volume>(sound, 0.5f);
+	}
+
+	return sound;
+}
+
+static Result run(const Scene& scene, int voices, std::shared_ptr<ISound> source)
+{
+	DeviceSpecs specs;
+	specs.format = FORMAT_FLOAT32;
+	specs.rate = RATE_48000;
+	specs.channels = CHANNELS_STEREO;
+
+	ReadDevice device(specs);
+	device.setQuality(scene.quality);
+
+	std::mt19937 random(0);
+	std::uniform_real_distribution<float> angle(0, 2 * M_PI);
+	std::uniform_real_distribution<float> distance(1, 20);
+
+	struct Emitter { std::shared_ptr<I3DHandle> handle; float angle; float distance; };
+	std::vector<Emitter> emitters;
+
+	device.lock();
+
+	for(int i = 0; i < voices; i++)
+	{
+		auto handle = device.play(createSound(scene, i, source));
+		handle->setLoopCount(-1);
+		handle->setVolume(1.0f / voices);
+
+		if(scene.spatial)
+		{
+			auto handle3d = std::dynamic_pointer_cast<I3DHandle>(handle);
+			handle3d->setRelative(false);
+			emitters.push_back({handle3d, angle(random), distance(random)});
+		}
+	}
+
+	device.unlock();
+
+	const int mixes = std::max(1, int(scene.duration * specs.rate / scene.buffersize));
+	const double period = double(scene.buffersize) / specs.rate;
+
+	std::vector<float> buffer(scene.buffersize * specs.channels);
+	std::vector<double> times(mixes);
+	double total = 0;
+
+	for(int i = 0; i < mixes; i++)
+	{
+		// the emitters circle around the listener
+		if(scene.spatial)
+		{
+			device.lock();
+
+			for(auto& emitter : emitters)
+			{
+				emitter.angle += period;
+				emitter.handle->setLocation(Vector3(std::cos(emitter.angle) * emitter.distance, 0, std::sin(emitter.angle) * emitter.distance));
+				emitter.handle->setVelocity(Vector3(-std::sin(emitter.angle) * emitter.distance, 0, std::cos(emitter.angle) * emitter.distance));
+			}
+
+			device.unlock();
+		}
+
+		auto start = std::chrono::steady_clock::now();
+
+		device.read(reinterpret_cast<data_t*>(buffer.data()), scene.buffersize);
+
+		times[i] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		total += times[i];
+	}
+
+	std::sort(times.begin(), times.end());
+
+	auto percentile = [&times](double p) { return times[std::min(times.size() - 1, size_t(p * times.size()))]; };
+
+	return Result{mixes * period / total, period, percentile(0.5), percentile(0.9), percentile(0.99), times.back()};
+}
+
+// a voice count is sustained if 99 % of the mixes finish within the buffer period
+static bool sustains(const Result& result)
+{
+	return result.p99 <= result.period;
+}
+
+static void printUsage(const char* name)
+{
+	std::cerr << "Usage: " << name << " [options]" << std::endl
+			  << "  --voices <count>          voices to play (default 64)" << std::endl
+			  << "  --type <type>             cached, streamed or generated (default cached)" << std::endl
+			  << "  --file <file>             sound file for cached and streamed voices" << std::endl
+			  << "  --3d                      move the voices around the listener" << std::endl
+			  << "  --effect <effect>         add lowpass, highpass, butterworth or volume, repeatable" << std::endl
+			  << "  --quality <quality>       fastest, low, medium or high resampling (default high)" << std::endl
+			  << "  --buffer <samples>        samples per mix (default 512)" << std::endl
+			  << "  --duration <seconds>      audio time to render per run (default 10)" << std::endl
+			  << "  --rate <rate>             sample rate of generated sounds (default 44100)" << std::endl
+			  << "  --max                     search the most voices that run in real time" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	Scene scene;
+	bool search = false;
+
+	for(int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool value = i + 1 < argc;
+
+		if(arg == "--voices" && value)
+			scene.voices = std::atoi(argv[++i]);
+		else if(arg == "--type" && value)
+			scene.type = argv[++i];
+		else if(arg == "--file" && value)
+			scene.file = argv[++i];
+		else if(arg == "--3d")
+			scene.spatial = true;
+		else if(arg == "--effect" && value)
+			scene.effects.push_back(argv[++i]);
+		else if(arg == "--quality" && value)
+		{
+			std::string quality = argv[++i];
+
+			if(quality == "fastest")
+				scene.quality = ResampleQuality::FASTEST;
+			else if(quality == "low")
+				scene.quality = ResampleQuality::LOW;
+			else if(quality == "medium")
+				scene.quality = ResampleQuality::MEDIUM;
+			else if(quality == "high")
+				scene.quality = ResampleQuality::HIGH;
+			else
+				scene.voices = -1;
+		}
+		else if(arg == "--buffer" && value)
+			scene.buffersize = std::atoi(argv[++i]);
+		else if(arg == "--duration" && value)
+			scene.duration = std::atof(argv[++i]);
+		else if(arg == "--rate" && value)
+			scene.rate = SampleRate(std::atof(argv[++i]));
+		else if(arg == "--max")
+			search = true;
+		else
+			scene.voices = -1;
+	}
+
+	bool valid = scene.type == "cached" || scene.type == "generated" || (scene.type == "streamed" && !scene.file.empty());
+
+	for(auto& effect : scene.effects)
+		valid = valid && (effect == "lowpass" || effect == "highpass" || effect == "butterworth" || effect == "volume");
+
+	if(scene.voices <= 0 || scene.buffersize <= 0 || scene.duration <= 0 || scene.rate <= 0 || !valid)
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	std::shared_ptr<ISound> source;
+
+	try
+	{
+		if(!scene.file.empty())
+		{
+			PluginManager::loadPlugins("");
+
+			source = std::make_shared<File>(scene.file);
+
+			if(scene.type == "cached")
+				source = std::make_shared<StreamBuffer>(source);
+		}
+		else
+		{
+			// two seconds of deterministic noise so that runs are comparable without audio files
+			Specs specs{scene.rate, CHANNELS_MONO};
+			int length = int(2 * scene.rate);
+			auto noise = std::make_shared<Buffer>(length * AUD_SAMPLE_SIZE(specs));
+
+			std::mt19937 random(0);
+			std::uniform_real_distribution<float> distribution(-1, 1);
+
+			for(int i = 0; i < length; i++)
+				noise->getBuffer()[i] = distribution(random);
+
+			source = std::make_shared<StreamBuffer>(noise, specs);
+		}
+
+		Result result = run(scene, scene.voices, source);
+
+		std::cout << "Voices: " << scene.voices << std::endl;
+		std::cout << "Real time factor: " << result.realtime << std::endl;
+		std::cout << "Mix period: " << result.period * 1e6 << " us" << std::endl;
+		std::cout << "Mix time p50/p90/p99/max: " << result.p50 * 1e6 << " / " << result.p90 * 1e6 << " / " << result.p99 * 1e6 << " / " << result.max * 1e6 << " us" << std::endl;
+
+		if(search)
+		{
+			// grow exponentially until the real time limit is hit, then bisect
+			int low = 0;
+			int high = 1;
+
+			while(high <= (1 << 16) && sustains(run(scene, high, source)))
+			{
+				low = high;
+				high *= 2;
+			}
+
+			while(high - low > 1)
+			{
+				int middle = (low + high) / 2;
+
+				if(sustains(run(scene, middle, source)))
+					low = middle;
+				else
+					high = middle;
+			}
+
+			std::cout << "Max real time voices: " << low << std::endl;
+		}
+	}
+	catch(Exception& e)
+	{
+		std::cerr << "Error: " << e.getMessage() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
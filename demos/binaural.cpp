@@ -18,6 +18,7 @@
 #include "fx/BinauralSound.h"
 #include "fx/Source.h"
 #include "fx/HRTFLoader.h"
+#include "fx/ImpulseResponseBank.h"
 #include "util/ThreadPool.h"
 #include "devices/DeviceManager.h"
 #include "devices/IDevice.h"
@@ -41,7 +42,7 @@ int main(int argc, char* argv[])
 	/*This demo uses KEMAR HRTFs.*/
 	if(argc != 3 && argc != 4)
 	{
-		std::cerr << "Usage: " << argv[0] << " <sound>"  << " <HRTFs path>" << " [inverse speaker impulse response]" << std::endl;
+		std::cerr << "Usage: " << argv[0] << " <sound>"  << " <HRTFs path or bank>" << " [inverse speaker impulse response]" << std::endl;
 		return 1;
 	}
 
@@ -56,7 +57,13 @@ int main(int argc, char* argv[])
 	std::shared_ptr<HRTF> hrtfs;
 	try
 	{
-		hrtfs = HRTFLoader::loadRightHRTFs(plan, ".wav", argv[2]);
+		std::string path = argv[2];
+
+		// banks created with irbank load without processing the HRTFs
+		if(path.size() > 4 && path.substr(path.size() - 4) == ".irb")
+			hrtfs = ImpulseResponseBank::readHRTF(path, plan);
+		else
+			hrtfs = HRTFLoader::loadRightHRTFs(plan, ".wav", path);
 	}
 	catch (Exception& e)
 	{
@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "util/FFTPlan.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace aud;
+
+// measures only the FFT backend the library was built with, comparing the
+// built-in FFT with FFTW needs a build of each
+int main(int argc, char* argv[])
+{
+	double measureTime = 0;
+
+	if(argc > 1)
+		measureTime = std::atof(argv[1]);
+
+#ifdef WITH_BUILTIN_FFT
+	std::cout << "Backend: built-in FFT" << std::endl;
+#else
+	std::cout << "Backend: FFTW, measure time " << measureTime << " s" << std::endl;
+#endif
+
+	std::mt19937 random(0);
+	std::uniform_real_distribution<float> distribution(-1, 1);
+
+	std::cout << "Size\tns per FFT\tns per IFFT\tmax round trip error" << std::endl;
+
+	for(int n : {256, 512, 1024, 2048, 4096, 8192, 16384})
+	{
+		FFTPlan plan(n, measureTime);
+
+		float* buffer = static_cast<float*>(plan.getBuffer());
+		std::vector<float> input(n);
+
+		for(auto& sample : input)
+			sample = distribution(random);
+
+		const int iterations = (1 << 24) / n;
+
+		std::chrono::duration<double> fft_time(0);
+		std::chrono::duration<double> ifft_time(0);
+		double error = 0;
+
+		for(int i = 0; i < iterations; i++)
+		{
+			std::copy(input.begin(), input.end(), buffer);
+
+			auto start = std::chrono::steady_clock::now();
+			plan.FFT(buffer);
+			auto middle = std::chrono::steady_clock::now();
+			plan.IFFT(buffer);
+			auto end = std::chrono::steady_clock::now();
+
+			fft_time += middle - start;
+			ifft_time += end - middle;
+		}
+
+		for(int i = 0; i < n; i++)
+			error = std::max(error, double(std::fabs(buffer[i] / n - input[i])));
+
+		plan.freeBuffer(buffer);
+
+		std::cout << n << "\t" << fft_time.count() * 1e9 / iterations << "\t\t" << ifft_time.count() * 1e9 / iterations << "\t\t" << error << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "fx/HRTFLoader.h"
+#include "fx/ImpulseResponseBank.h"
+#include "file/File.h"
+#include "plugin/PluginManager.h"
+#include "util/StreamBuffer.h"
+#include "Exception.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace aud;
+
+int main(int argc, char* argv[])
+{
+	if(argc < 5 || argc > 6 || (std::string(argv[3]) != "hrtf" && std::string(argv[3]) != "ir"))
+	{
+		std::cerr << "Usage: " << argv[0] << " <FFT size> <bank> hrtf <HRTFs path> [L|R]" << std::endl;
+		std::cerr << "       " << argv[0] << " <FFT size> <bank> ir <impulse response>" << std::endl;
+		return 1;
+	}
+
+	PluginManager::loadPlugins("");
+
+	std::shared_ptr<FFTPlan> plan(std::make_shared<FFTPlan>(std::stoi(argv[1])));
+	std::string bank = argv[2];
+	bool hrtf = std::string(argv[3]) == "hrtf";
+
+	try
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		if(hrtf)
+		{
+			std::shared_ptr<HRTF> hrtfs;
+
+			if(argc == 6 && std::string(argv[5]) == "L")
+				hrtfs = HRTFLoader::loadLeftHRTFs(plan, ".wav", argv[4]);
+			else
+				hrtfs = HRTFLoader::loadRightHRTFs(plan, ".wav", argv[4]);
+
+			if(hrtfs->isEmpty())
+			{
+				std::cerr << "No HRTFs found in " << argv[4] << std::endl;
+				return 2;
+			}
+
+			std::cout << "Loaded " << hrtfs->getCount() << " HRTFs in " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms" << std::endl;
+
+			ImpulseResponseBank::writeHRTF(hrtfs, bank);
+		}
+		else
+		{
+			std::shared_ptr<ImpulseResponse> ir(std::make_shared<ImpulseResponse>(std::make_shared<StreamBuffer>(std::make_shared<File>(argv[4])), plan));
+
+			std::cout << "Loaded the impulse response in " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms" << std::endl;
+
+			ImpulseResponseBank::writeImpulseResponse(ir, bank);
+		}
+
+		start = std::chrono::steady_clock::now();
+
+		if(hrtf)
+			ImpulseResponseBank::readHRTF(bank, plan);
+		else
+			ImpulseResponseBank::readImpulseResponse(bank, plan);
+
+		std::cout << "Loaded the bank " << bank << " in " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms" << std::endl;
+	}
+	catch(Exception& e)
+	{
+		std::cerr << "Error: " << e.getMessage() << std::endl;
+		return 3;
+	}
+
+	return 0;
+}
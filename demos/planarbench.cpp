@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "fx/Butterworth.h"
+#include "fx/Highpass.h"
+#include "fx/Lowpass.h"
+#include "fx/Volume.h"
+#include "generator/Sine.h"
+#include "fx/Limiter.h"
+#include "respec/ChannelMapper.h"
+#include "util/PlanarBuffer.h"
+#include "util/StreamBuffer.h"
+#include "IReader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace aud;
+
+static std::shared_ptr<ISound> createChain(std::shared_ptr<ISound> sound)
+{
+	sound = std::make_shared<Lowpass>(sound, 8000);
+	sound = std::make_shared<Highpass>(sound, 40);
+	sound = std::make_shared<Butterworth>(sound, 4000);
+	return std::make_shared<Volume>(sound, 0.5f);
+}
+
+int main(int argc, char* argv[])
+{
+	int length = 512;
+
+	if(argc > 1)
+		length = std::atoi(argv[1]);
+
+	if(length <= 0)
+	{
+		std::cerr << "Usage: " << argv[0] << " [block length]" << std::endl;
+		return 1;
+	}
+
+	const int blocks = 2000;
+
+	DeviceSpecs specs;
+	specs.rate = RATE_48000;
+	specs.channels = CHANNELS_SURROUND71;
+	specs.format = FORMAT_FLOAT32;
+
+	// the source is mixed to 7.1 once, so the benchmark measures the effect chain
+	auto source = std::make_shared<StreamBuffer>(std::make_shared<ChannelMapper>(std::make_shared<Limiter>(std::make_shared<Sine>(440, RATE_48000), 0, 10), specs));
+	auto chain = createChain(source);
+
+	auto interleavedReader = chain->createReader();
+	auto convertedReader = chain->createReader();
+	auto planarReader = chain->createReader();
+
+	std::vector<sample_t> buffer(length * specs.channels);
+	std::vector<sample_t> reference(length * specs.channels);
+	PlanarBuffer converted(length, specs.channels);
+	PlanarBuffer planar(length, specs.channels);
+
+	std::chrono::duration<double> interleavedTime(0);
+	std::chrono::duration<double> convertedTime(0);
+	std::chrono::duration<double> planarTime(0);
+	double difference = 0;
+
+	for(int i = 0; i < blocks; i++)
+	{
+		int len = length;
+		bool eos;
+
+		// interleaved output, as consumed by devices
+		auto start = std::chrono::steady_clock::now();
+		interleavedReader->read(len, eos, buffer.data());
+		interleavedTime += std::chrono::steady_clock::now() - start;
+
+		// planar output from an interleaved chain, as before planar reading
+		len = length;
+		start = std::chrono::steady_clock::now();
+		convertedReader->read(len, eos, reference.data());
+		PlanarBuffer::deinterleave(reference.data(), converted.getChannels(), len, specs.channels);
+		convertedTime += std::chrono::steady_clock::now() - start;
+
+		// planar output passed through the chain
+		len = length;
+		start = std::chrono::steady_clock::now();
+		planar.read(*planarReader, len, eos);
+		planarTime += std::chrono::steady_clock::now() - start;
+
+		for(int channel = 0; channel < specs.channels; channel++)
+			for(int j = 0; j < len; j++)
+				difference = std::max(difference, double(std::fabs(buffer[j * specs.channels + channel] - planar.getChannel(channel)[j])));
+
+		if(eos)
+		{
+			interleavedReader->seek(0);
+			convertedReader->seek(0);
+			planarReader->seek(0);
+		}
+	}
+
+	double samples = double(blocks) * length * specs.channels;
+
+	std::cout << "7.1 chain: lowpass, highpass, butterworth, volume; " << length << " samples per block" << std::endl;
+	std::cout << "Output			us per block	ns per sample" << std::endl;
+	std::cout << "interleaved		" << interleavedTime.count() * 1e6 / blocks << "		" << interleavedTime.count() * 1e9 / samples << std::endl;
+	std::cout << "planar (converted)	" << convertedTime.count() * 1e6 / blocks << "		" << convertedTime.count() * 1e9 / samples << std::endl;
+	std::cout << "planar (negotiated)	" << planarTime.count() * 1e6 / blocks << "		" << planarTime.count() * 1e9 / samples << std::endl;
+	std::cout << "Maximum difference: " << difference << std::endl;
+
+	return 0;
+}
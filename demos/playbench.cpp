@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "devices/ReadDevice.h"
+#include "devices/IHandle.h"
+#include "fx/Limiter.h"
+#include "generator/Sine.h"
+#include "util/StreamBuffer.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace aud;
+
+int main(int argc, char* argv[])
+{
+	int plays = 16;
+	int prewarm = 256;
+
+	if(argc > 1)
+		plays = std::atoi(argv[1]);
+	if(argc > 2)
+		prewarm = std::atoi(argv[2]);
+
+	if(plays <= 0 || prewarm < 0)
+	{
+		std::cerr << "Usage: " << argv[0] << " [plays per mix] [prewarmed handles]" << std::endl;
+		return 1;
+	}
+
+	const int length = 512;
+	const int mixes = 20000;
+
+	DeviceSpecs specs;
+	specs.format = FORMAT_FLOAT32;
+	specs.rate = RATE_48000;
+	specs.channels = CHANNELS_STEREO;
+
+	ReadDevice device(specs);
+
+	// a short sound in memory, like a footstep or a shot
+	auto sound = std::make_shared<StreamBuffer>(std::make_shared<Limiter>(std::make_shared<Sine>(440, RATE_48000), 0, 0.05));
+
+	std::vector<float> buffer(length * specs.channels);
+
+	device.prewarm(prewarm);
+
+	std::chrono::duration<double> play_time(0);
+	auto start = std::chrono::steady_clock::now();
+
+	for(int i = 0; i < mixes; i++)
+	{
+		auto play_start = std::chrono::steady_clock::now();
+
+		device.lock();
+
+		for(int j = 0; j < plays; j++)
+			device.play(sound);
+
+		device.unlock();
+
+		play_time += std::chrono::steady_clock::now() - play_start;
+
+		device.read(reinterpret_cast<data_t*>(buffer.data()), length);
+	}
+
+	std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+
+	std::cout << "Plays: " << plays * mixes << std::endl;
+	std::cout << "Plays per second: " << plays * mixes / play_time.count() << std::endl;
+	std::cout << "Real time factor: " << mixes * length / (time.count() * specs.rate) << std::endl;
+	std::cout << "Pooled handles: " << device.getPooledHandleCount() << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "devices/ReadDevice.h"
+#include "devices/I3DHandle.h"
+#include "devices/IHandle.h"
+#include "generator/Sine.h"
+#include "fx/Limiter.h"
+#include "util/StreamBuffer.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace aud;
+
+int main(int argc, char* argv[])
+{
+	int voices = 64;
+
+	if(argc > 1)
+		voices = std::atoi(argv[1]);
+
+	if(voices < 0)
+	{
+		std::cerr << "Usage: " << argv[0] << " [rendered voices]" << std::endl;
+		return 1;
+	}
+
+	const int length = 512;
+	const int mixes = 200;
+
+	Specs specs;
+	specs.rate = RATE_48000;
+	specs.channels = CHANNELS_STEREO;
+
+	auto sound = std::make_shared<StreamBuffer>(std::make_shared<Limiter>(std::make_shared<Sine>(440, RATE_48000), 0, 1));
+
+	std::mt19937 random(0);
+	std::uniform_real_distribution<float> position(-100, 100);
+	std::uniform_real_distribution<float> velocity(-10, 10);
+
+	std::vector<float> buffer(length * specs.channels);
+
+	std::cout << "Emitters\tus per mix\tns per emitter" << std::endl;
+
+	for(int emitters : {1000, 2000, 5000, 10000})
+	{
+		ReadDevice device(specs);
+		device.setMaximumVoices(voices);
+
+		std::vector<std::shared_ptr<I3DHandle>> handles;
+
+		device.lock();
+
+		for(int i = 0; i < emitters; i++)
+		{
+			auto handle = device.play(sound);
+			handle->setLoopCount(-1);
+
+			auto handle3d = std::dynamic_pointer_cast<I3DHandle>(handle);
+			handle3d->setRelative(false);
+			handle3d->setLocation(Vector3(position(random), position(random), position(random)));
+			handle3d->setVelocity(Vector3(velocity(random), velocity(random), velocity(random)));
+			handles.push_back(handle3d);
+		}
+
+		device.unlock();
+
+		std::chrono::duration<double> time(0);
+
+		for(int i = 0; i < mixes; i++)
+		{
+			// the emitters move every mix
+			device.lock();
+
+			for(auto& handle : handles)
+				handle->setLocation(handle->getLocation() + handle->getVelocity() * (float(length) / specs.rate));
+
+			device.unlock();
+
+			auto start = std::chrono::steady_clock::now();
+			device.read(reinterpret_cast<data_t*>(buffer.data()), length);
+			time += std::chrono::steady_clock::now() - start;
+		}
+
+		double mix_time = time.count() / mixes;
+
+		std::cout << emitters << "\t\t" << mix_time * 1e6 << "\t\t" << mix_time * 1e9 / emitters << std::endl;
+	}
+
+	return 0;
+}
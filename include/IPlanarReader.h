@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file IPlanarReader.h
+ * @ingroup general
+ * The IPlanarReader interface.
+ */
+
+#include "Audaspace.h"
+
+AUD_NAMESPACE_BEGIN
+
+/**
+ * @interface IPlanarReader
+ * This interface is implemented by readers in addition to IReader if they can
+ * read non-interleaved samples without converting them first.
+ *
+ * Readers that process their channels separately query their input for this
+ * interface and use it if available, so that a chain of such readers passes
+ * channel pointers along and only converts between the interleaved and planar
+ * layout at its boundaries. PlanarBuffer::read() implements this negotiation.
+ */
+class AUD_API IPlanarReader
+{
+public:
+	/**
+	 * Destroys the reader.
+	 */
+	virtual ~IPlanarReader() {}
+
+	/**
+	 * Request to read the next length samples out of the source as separate
+	 * channels. This behaves like IReader::read() otherwise.
+	 * \param[in,out] length The count of samples that should be read. Shall
+	 *                contain the real count of samples after reading, in case
+	 *                there were only fewer samples available.
+	 *                A smaller value also indicates the end of the reader.
+	 * \param[out] eos End of stream, whether the end is reached or not.
+	 * \param[in] buffers One pointer per channel of the reader's specs, each
+	 *            pointing to a buffer for length samples.
+	 */
+	virtual void readPlanar(int& length, bool& eos, sample_t* const* buffers)=0;
+};
+
+AUD_NAMESPACE_END
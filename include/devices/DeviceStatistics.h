@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file DeviceStatistics.h
+ * @ingroup devices
+ * The DeviceStatistics structure.
+ */
+
+#include "Audaspace.h"
+
+#include <cstdint>
+
+AUD_NAMESPACE_BEGIN
+
+/**
+ * Timing statistics of a software mixing device since they were last reset.
+ * Percentiles are estimated from logarithmic histograms, see Histogram.
+ */
+struct DeviceStatistics
+{
+	/// The number of mixes.
+	uint64_t mixes;
+
+	/// The mean time of a mix in seconds.
+	double mix_time_mean;
+
+	/// The median time of a mix in seconds.
+	double mix_time_median;
+
+	/// The 99th percentile of the mix time in seconds.
+	double mix_time_p99;
+
+	/// The longest mix in seconds.
+	double mix_time_max;
+
+	/// The mean number of rendered voices per mix.
+	double voices_mean;
+
+	/// The most rendered voices in a mix.
+	int voices_max;
+
+	/// The number of measured intervals between audio callbacks of the backend.
+	uint64_t callbacks;
+
+	/// The mean interval between audio callbacks in seconds.
+	double interval_mean;
+
+	/// The 99th percentile of the deviation of the callback interval from the buffer period in seconds.
+	double jitter_p99;
+
+	/// The largest deviation of the callback interval from the buffer period in seconds.
+	double jitter_max;
+
+	/// The mean fill level of the ring buffer in the callbacks between 0 and 1, 1 without ring buffer.
+	float fill_mean;
+
+	/// The lowest fill level of the ring buffer in the callbacks between 0 and 1, 1 without ring buffer.
+	float fill_min;
+
+	/// The number of callbacks that could not be filled completely with mixed samples.
+	uint64_t underruns;
+};
+
+AUD_NAMESPACE_END
@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file HandleUpdate.h
+ * @ingroup devices
+ * The HandleUpdate structure and functions to apply batches of them.
+ */
+
+#include "devices/IHandle.h"
+#include "util/Math3D.h"
+
+AUD_NAMESPACE_BEGIN
+
+class IDevice;
+
+/// The properties a HandleUpdate sets.
+enum HandleUpdateFlags
+{
+	HANDLE_UPDATE_LOCATION    = 1 << 0,	/// Sets the location, needs a 3D handle.
+	HANDLE_UPDATE_VELOCITY    = 1 << 1,	/// Sets the velocity, needs a 3D handle.
+	HANDLE_UPDATE_ORIENTATION = 1 << 2,	/// Sets the orientation, needs a 3D handle.
+	HANDLE_UPDATE_VOLUME      = 1 << 3,	/// Sets the volume.
+	HANDLE_UPDATE_PITCH       = 1 << 4	/// Sets the pitch.
+};
+
+/**
+ * An update of the properties of a playback handle, which is applied together
+ * with others by applyHandleUpdates().
+ */
+struct HandleUpdate
+{
+	/// The handle to update, updates without handle are skipped.
+	IHandle* handle;
+
+	/// Which properties to set as combination of HandleUpdateFlags.
+	int flags;
+
+	/// The new location.
+	Vector3 location;
+
+	/// The new velocity.
+	Vector3 velocity;
+
+	/// The new orientation.
+	Quaternion orientation;
+
+	/// The new volume.
+	float volume;
+
+	/// The new pitch.
+	float pitch;
+};
+
+/**
+ * Applies a batch of handle updates while holding the device lock once, so
+ * that all of them take effect in the same mixing cycle and the per handle
+ * locking of the devices is only done recursively.
+ * \param device The device the handles belong to.
+ * \param updates The updates to apply.
+ * \param count The number of updates.
+ * \return The number of updates whose properties could all be set.
+ */
+extern AUD_API int applyHandleUpdates(IDevice& device, const HandleUpdate* updates, int count);
+
+AUD_NAMESPACE_END
@@ -62,7 +62,8 @@ public:
 	/**
 	 * Sets the size for the internal playback buffers.
 	 * The bigger the buffersize, the less likely clicks happen,
-	 * but the latency increases too.
+	 * but the latency increases too. The JACK and PipeWire devices mix
+	 * directly in the audio callback if the size is 0.
 	 * \param buffersize The size of the internal buffer.
 	 */
 	virtual void setBufferSize(int buffersize)=0;
@@ -22,6 +22,7 @@
  * The MixingThreadDevice class.
  */
 
+#include <atomic>
 #include <condition_variable>
 #include <thread>
 
@@ -56,6 +57,17 @@ private:
 	 */
 	bool m_valid{false};
 
+	/**
+	 * Whether the audio callback mixes directly instead of the mixing thread.
+	 */
+	bool m_direct{false};
+
+	/**
+	 * The size in bytes of the last period of the audio callback, which is
+	 * kept mixed ahead when mixing directly.
+	 */
+	std::atomic<size_t> m_reserve{0};
+
 	/**
 	 * The mixing thread.
 	 */
@@ -84,8 +96,20 @@ protected:
 	/**
 	 * Starts the streaming thread.
 	 * @param buffersize Size of the ring buffer in bytes.
+	 * @param direct Whether the audio callback mixes directly with mixDirect().
+	 *               The ring buffer then only holds the reserve of one period
+	 *               and the thread only refills it if the callback couldn't.
+	 */
+	void startMixingThread(size_t buffersize, bool direct = false);
+
+	/**
+	 * Mixes into the ring buffer from the audio callback, so that it holds
+	 * the period to read plus the reserve of another period. The device lock
+	 * is never waited for. If another thread holds it, the callback plays
+	 * from the reserve and the mixing thread refills it.
+	 * @param length The length of the period in samples.
 	 */
-	void startMixingThread(size_t buffersize);
+	void mixDirect(int length);
 
 	/**
 	 * Notify the mixing thread.
@@ -100,6 +124,21 @@ protected:
 		return m_ringBuffer;
 	}
 
+	/**
+	 * Records an audio callback that reads from the ring buffer for the
+	 * statistics, has to be called before reading.
+	 * \param length The length of the callback in samples.
+	 */
+	void recordRingBufferCallback(int length);
+
+	/**
+	 * Returns whether the audio callback mixes directly.
+	 */
+	inline bool isDirectMixing()
+	{
+		return m_direct;
+	}
+
 	/**
 	 * Returns whether the thread is running or not.
 	 */
@@ -126,6 +165,9 @@ protected:
 	 * \warning The device has to be unlocked to not run into a deadlock.
 	 */
 	void stopMixingThread();
+
+public:
+	virtual double getLatency();
 };
 
 AUD_NAMESPACE_END
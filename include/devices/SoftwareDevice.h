@@ -26,15 +26,26 @@
 #include "devices/IHandle.h"
 #include "devices/I3DDevice.h"
 #include "devices/I3DHandle.h"
+#include "devices/DeviceStatistics.h"
+#include "fx/AmbisonicsDecoder.h"
 #include "util/Buffer.h"
+#include "util/Histogram.h"
+#include "util/ProfileNode.h"
 
+#include <atomic>
+#include <chrono>
 #include <list>
 #include <mutex>
+#include <vector>
 
 AUD_NAMESPACE_BEGIN
 
+class BufferReader;
+class DeviceBuffer;
 class Mixer;
 class PitchReader;
+class StreamBuffer;
+class SubmixBus;
 class ResampleReader;
 class ChannelMapperReader;
 
@@ -71,6 +82,12 @@ protected:
 		/// The channel mapper reader in between.
 		std::shared_ptr<ChannelMapperReader> m_mapper;
 
+		/// The source if it is a buffer in memory, otherwise nullptr.
+		std::shared_ptr<BufferReader> m_buffer_source;
+
+		/// Whether the source is read directly, bypassing pitch, resampling and channel mapping.
+		bool m_direct;
+
 		/// Whether the source is being read for the first time.
 		bool m_first_reading;
 
@@ -146,6 +163,45 @@ protected:
 		/// Own device.
 		SoftwareDevice* m_device;
 
+		/// The priority of the handle when the voices are limited.
+		int m_priority;
+
+		/// Whether the handle is rendered in the current mix.
+		bool m_audible;
+
+		/// Whether the handle is virtual, so that only its position is tracked.
+		bool m_virtual;
+
+		/// The position of a virtual handle in samples of the source.
+		double m_virtual_position;
+
+		/// The angle of a mono source for the channel mapping.
+		float m_angle;
+
+		/// The sine of the elevation of a mono source relative to the listener.
+		float m_height;
+
+		/// The ambisonic encoding coefficients of the current mix, including the volume.
+		float m_ambisonics[AUD_AMBISONICS_CHANNELS(AUD_AMBISONICS_MAX_ORDER)];
+
+		/// The ambisonic encoding coefficients of the previous mix.
+		float m_old_ambisonics[AUD_AMBISONICS_CHANNELS(AUD_AMBISONICS_MAX_ORDER)];
+
+		/// Whether the handle has not been encoded into an ambisonics bus yet.
+		bool m_first_encoding;
+
+		/// The bus the handle is mixed into, nullptr for the device output.
+		std::shared_ptr<SubmixBus> m_bus;
+
+		/// The device clock sample at which a scheduled handle starts, 0 if it is not scheduled.
+		uint64_t m_start_sample;
+
+		/// The device clock sample at which the handle stops, set without locking the device.
+		std::atomic<uint64_t> m_stop_sample;
+
+		/// The profile of the reads of the handle if profiling was enabled when it was played, otherwise nullptr.
+		std::shared_ptr<ProfileNode> m_profile;
+
 		/**
 		 * This method is for internal use only.
 		 * @param keep Whether the sound should be marked stopped or paused.
@@ -153,6 +209,29 @@ protected:
 		 */
 		bool pause(bool keep);
 
+		/**
+		 * Sets the playback parameters to their initial values.
+		 * \param buffer_source The source reader if it reads from memory, otherwise nullptr.
+		 * \param keep Whether to keep the handle when the sound ends.
+		 */
+		void initialize(std::shared_ptr<BufferReader> buffer_source, bool keep);
+
+		/**
+		 * Switches from reading the source directly back to the reader chain.
+		 * The chain is primed with the last samples played, so that the
+		 * transition is seamless.
+		 * \param buffer A buffer that can hold length samples of the device.
+		 * \param length The length of the buffer in samples.
+		 */
+		void leaveDirect(sample_t* buffer, int length);
+
+		/**
+		 * Calculates the ambisonic encoding coefficients of a mono source for
+		 * the current mix from its direction and volume.
+		 * \param order The ambisonics order of the bus.
+		 */
+		void updateAmbisonics(int order);
+
 	public:
 		/**
 		 * Creates a new software handle.
@@ -161,15 +240,77 @@ protected:
 		 * \param pitch The pitch reader.
 		 * \param resampler The resampling reader.
 		 * \param mapper The channel mapping reader.
+		 * \param buffer_source The source reader if it reads from memory, otherwise nullptr.
 		 * \param keep Whether to keep the handle when the sound ends.
 		 */
-		SoftwareHandle(SoftwareDevice* device, std::shared_ptr<IReader> reader, std::shared_ptr<PitchReader> pitch, std::shared_ptr<ResampleReader> resampler, std::shared_ptr<ChannelMapperReader> mapper, bool keep);
+		SoftwareHandle(SoftwareDevice* device, std::shared_ptr<IReader> reader, std::shared_ptr<PitchReader> pitch, std::shared_ptr<ResampleReader> resampler, std::shared_ptr<ChannelMapperReader> mapper, std::shared_ptr<BufferReader> buffer_source, bool keep);
+
+		/**
+		 * Prepares a stopped handle from the pool for playing a new reader,
+		 * reusing the existing reader chain.
+		 * \param reader The reader to play.
+		 * \param buffer_source The source reader if it reads from memory, otherwise nullptr.
+		 * \param keep Whether to keep the handle when the sound ends.
+		 */
+		void reuse(std::shared_ptr<IReader> reader, std::shared_ptr<BufferReader> buffer_source, bool keep);
+
+		/**
+		 * Releases the source of a stopped handle, keeping the reader chain
+		 * for reuse.
+		 */
+		void release();
 
 		/**
 		 * Updates the handle's playback parameters.
 		 */
 		void update();
 
+		/**
+		 * Reads the next samples of the sound in the device specification.
+		 * If the source is a buffer matching the device specification and
+		 * no pitch is applied, the samples are not copied but returned
+		 * directly from the source buffer.
+		 * \param[in,out] length The count of samples that should be read.
+		 * \param[out] eos End of stream, whether the end is reached or not.
+		 * \param buffer The buffer to read into if the samples are not
+		 *        returned directly. Has to hold length samples.
+		 * \param encode Whether to read the mono samples before the channel
+		 *        mapping for ambisonic encoding.
+		 * \return A pointer to the samples read, either buffer or the
+		 *         memory of the source.
+		 */
+		sample_t* read(int& length, bool& eos, sample_t* buffer, bool encode = false);
+
+		/**
+		 * Seeks the reader chain and resets it.
+		 * \param position The position in samples of the device.
+		 */
+		void seekReader(int position);
+
+		/**
+		 * Returns whether the handle can become virtual, which requires a
+		 * seekable source with known length.
+		 * \return Whether the handle can become virtual.
+		 */
+		bool canVirtualize();
+
+		/**
+		 * Stops rendering the handle and only tracks its position.
+		 */
+		void virtualize();
+
+		/**
+		 * Continues rendering a virtual handle at its tracked position.
+		 */
+		void devirtualize();
+
+		/**
+		 * Advances the position of a virtual handle.
+		 * \param length The length in samples of the device.
+		 * \return Whether the end of the sound has been reached.
+		 */
+		bool advanceVirtual(int length);
+
 		/**
 		 * Sets the audio output specification of the readers.
 		 * \param specs The output specification.
@@ -234,6 +375,11 @@ protected:
 	 */
 	ResampleQuality m_quality;
 
+	/**
+	 * Whether sounds played on this device create offline rendering readers.
+	 */
+	bool m_offline;
+
 	/**
 	 * Initializes member variables.
 	 */
@@ -251,6 +397,32 @@ protected:
 	 */
 	void mix(data_t* buffer, int length);
 
+	/**
+	 * Locks the device if no other thread holds the lock, without waiting,
+	 * so that a realtime audio callback can mix.
+	 * \return Whether the device has been locked. It then has to be unlocked
+	 *         with unlock().
+	 */
+	bool tryLock();
+
+	/**
+	 * Allocates the mixing buffers for mixing up to the given number of
+	 * samples at once, so that mixing in a realtime audio callback doesn't
+	 * allocate them.
+	 * \param length The maximum length in samples mixed at once.
+	 */
+	void prepareMixing(int length);
+
+	/**
+	 * Records an audio callback of the backend for the statistics.
+	 * Does nothing if the statistics are disabled.
+	 * \param length The length of the callback in samples.
+	 * \param fill The fill level of the ring buffer between 0 and 1 or a
+	 *             negative value if the backend has no ring buffer.
+	 * \param underrun Whether the callback could not be filled completely.
+	 */
+	void recordCallback(int length, float fill, bool underrun);
+
 	/**
 	 * This function tells the device, to start or pause playback.
 	 * \param playing True if device should playback.
@@ -261,12 +433,18 @@ protected:
 	/**
 	 * Sets the audio output specification of the device.
 	 * \param specs The output specification.
+	 * \note Registered device buffers without a thread pool are converted
+	 *       synchronously on the calling thread, so the device should not be
+	 *       locked while calling this method.
 	 */
 	void setSpecs(Specs specs);
 
 	/**
 	 * Sets the audio output specification of the device.
 	 * \param specs The output specification.
+	 * \note Registered device buffers without a thread pool are converted
+	 *       synchronously on the calling thread, so the device should not be
+	 *       locked while calling this method.
 	 */
 	void setSpecs(DeviceSpecs specs);
 
@@ -282,6 +460,11 @@ private:
 	 */
 	Buffer m_buffer;
 
+	/**
+	 * The maximum length in samples the mixing buffers are allocated for.
+	 */
+	int m_mixLength;
+
 	/**
 	 * The list of sounds that are currently playing.
 	 */
@@ -292,6 +475,52 @@ private:
 	 */
 	std::list<std::shared_ptr<SoftwareHandle> > m_pausedSounds;
 
+	/**
+	 * The list of stopped sounds whose reader chains can be reused.
+	 */
+	std::list<std::shared_ptr<SoftwareHandle> > m_pooledSounds;
+
+	/**
+	 * The list of stopped sounds with a buffer reader whose reader chains
+	 * can be reused.
+	 */
+	std::list<std::shared_ptr<SoftwareHandle> > m_pooledBufferSounds;
+
+	/**
+	 * The maximum number of stopped sounds that are pooled.
+	 */
+	int m_poolSize;
+
+	/**
+	 * Moves a stopped sound into the pool or drops it if the pool is full.
+	 * \param list The list the sound is in.
+	 * \param it The position of the sound in the list.
+	 */
+	void AUD_LOCAL poolHandle(std::list<std::shared_ptr<SoftwareHandle> >& list, std::list<std::shared_ptr<SoftwareHandle> >::iterator it);
+
+	/**
+	 * Finds a pooled sound that is no longer referenced outside the device.
+	 * Referenced sounds are moved to the end of the pool on the way.
+	 * \param pool The pool to search.
+	 * \return The position of the sound or the end of the pool.
+	 */
+	std::list<std::shared_ptr<SoftwareHandle> >::iterator AUD_LOCAL findPooledHandle(std::list<std::shared_ptr<SoftwareHandle> >& pool);
+
+	/**
+	 * The list of sounds that are scheduled to start, sorted by their start.
+	 */
+	std::list<std::shared_ptr<SoftwareHandle> > m_scheduledSounds;
+
+	/**
+	 * The sounds that reached their end in the current mix.
+	 */
+	std::vector<std::shared_ptr<SoftwareHandle> > m_stopSounds;
+
+	/**
+	 * The sounds that reached their end in the current mix and are kept.
+	 */
+	std::vector<std::shared_ptr<SoftwareHandle> > m_pauseSounds;
+
 	/**
 	 * Whether there is currently playback.
 	 */
@@ -332,6 +561,215 @@ private:
 	uint64_t m_synchronizerPosition{0};
 	int m_synchronizerState{0};
 
+	/// The number of samples mixed since the device was created.
+	std::atomic<uint64_t> m_clock{0};
+
+	/// Maximum number of voices that are rendered, 0 for no limit.
+	std::atomic<int> m_max_voices;
+
+	/// Volume below which voices become virtual.
+	std::atomic<float> m_virtual_volume;
+
+	/// Number of voices rendered in the last mix, readable without locking.
+	std::atomic<int> m_real_voices;
+
+	/// Number of virtual voices in the last mix, readable without locking.
+	std::atomic<int> m_virtual_voices;
+
+	/// The node the mixes are profiled in.
+	std::shared_ptr<ProfileNode> m_mixProfile;
+
+	/// Whether the statistics are recorded.
+	std::atomic<bool> m_statistics{false};
+
+	/// Mix durations in nanoseconds.
+	Histogram m_mixTime;
+
+	/// Rendered voices per mix.
+	Histogram m_mixVoices;
+
+	/// Intervals between audio callbacks in nanoseconds.
+	Histogram m_callbackInterval;
+
+	/// Deviations of the callback intervals from the buffer period in nanoseconds.
+	Histogram m_callbackJitter;
+
+	/// Ring buffer fill levels in the callbacks in per mille.
+	Histogram m_callbackFill;
+
+	/// Number of callbacks that could not be filled completely.
+	std::atomic<uint64_t> m_underruns{0};
+
+	/// Time of the last audio callback.
+	std::chrono::steady_clock::time_point m_lastCallback;
+
+	/// Length of the last audio callback in samples, 0 if there was none.
+	int m_lastCallbackLength{0};
+
+	/// The voices competing for rendering in the current mix.
+	std::vector<SoftwareHandle*> m_voices;
+
+	/**
+	 * The 3D parameters and results of the playing mono handles stored as
+	 * structure of arrays, so that all handles are updated in tight loops.
+	 */
+	class AUD_LOCAL SpatialBatch
+	{
+	public:
+		/// The handles in the batch.
+		std::vector<SoftwareHandle*> m_handles;
+
+		/// The rendering flags, inverted after distance computation.
+		std::vector<int> m_flags;
+
+		/// Whether the handle position is relative to the listener.
+		std::vector<int> m_relative;
+
+		/// The vector from the source to the listener.
+		std::vector<float> m_sl_x, m_sl_y, m_sl_z;
+
+		/// The velocity of the source.
+		std::vector<float> m_velocity_x, m_velocity_y, m_velocity_z;
+
+		/// The look at vector of the source orientation.
+		std::vector<float> m_look_x, m_look_y, m_look_z;
+
+		/// The user set pitch, volume and panning.
+		std::vector<float> m_user_pitch, m_user_volume, m_user_pan;
+
+		/// The volume limits.
+		std::vector<float> m_volume_min, m_volume_max;
+
+		/// The distance model parameters.
+		std::vector<float> m_distance_reference, m_distance_max, m_attenuation;
+
+		/// The cone parameters.
+		std::vector<float> m_cone_angle_inner, m_cone_angle_outer, m_cone_volume_outer;
+
+		/// The distance between source and listener.
+		std::vector<float> m_distance;
+
+		/// The distance clamped by the distance model.
+		std::vector<float> m_clamped;
+
+		/// The gain of the distance model and cone.
+		std::vector<float> m_gain;
+
+		/// The cosine and then the angle between the source direction and the listener.
+		std::vector<float> m_cone;
+
+		/// The resulting pitch.
+		std::vector<float> m_pitch;
+
+		/// The resulting volume, initialized with the previous volume.
+		std::vector<float> m_volume;
+
+		/// The resulting angle for the channel mapping.
+		std::vector<float> m_angle;
+
+		/// The resulting sine of the elevation.
+		std::vector<float> m_height;
+
+		/**
+		 * Resizes all arrays, without freeing memory when shrinking.
+		 * \param size The new number of handles.
+		 */
+		void resize(int size);
+
+		/**
+		 * Reserves memory in all arrays, so that resizing doesn't allocate.
+		 * \param size The number of handles to reserve memory for.
+		 */
+		void reserve(int size);
+	};
+
+	/// The 3D parameters of the handles in the current mix.
+	SpatialBatch m_spatial;
+
+	/**
+	 * Mixes the next samples of all playing sounds into the mixer buffer.
+	 * \param length The length in samples to be mixed.
+	 * \note The device has to be locked.
+	 */
+	void AUD_LOCAL mixSounds(int length);
+
+	/**
+	 * Allocates the mixing buffers for the prepared length and the current
+	 * specification, see prepareMixing().
+	 */
+	void AUD_LOCAL allocateMixing();
+
+	/**
+	 * Reserves space for the voices and 3D parameters of all playing and
+	 * scheduled sounds and for stopping or pausing them within one mix, so
+	 * that mixing doesn't allocate.
+	 */
+	void AUD_LOCAL reserveSounds();
+
+	/**
+	 * Updates the playback parameters of all playing handles.
+	 * Does the same as SoftwareHandle::update for every handle, but
+	 * processes all mono handles together.
+	 */
+	void AUD_LOCAL updateHandles();
+
+	/**
+	 * Decides which of the playing handles are rendered in the current mix.
+	 */
+	void AUD_LOCAL updateVoices();
+
+	/// The submix buses of the device in the order of their creation.
+	std::list<std::weak_ptr<SubmixBus> > m_buses;
+
+	/// The buses processed in the current mix.
+	std::vector<std::shared_ptr<SubmixBus> > m_mixBuses;
+
+	/// Sounds that are kept converted to the device specification.
+	std::list<std::weak_ptr<DeviceBuffer> > m_deviceBuffers;
+
+	/// The mutex for the registered device buffers.
+	std::mutex m_deviceBuffersMutex;
+
+	/**
+	 * Converts all registered device buffers to a specification. Buffers
+	 * without a thread pool are converted synchronously, so the device must
+	 * not be locked by the caller.
+	 * \param specs The specification to convert to.
+	 */
+	void AUD_LOCAL updateDeviceBuffers(Specs specs);
+
+	/**
+	 * Creates a new handle with its reader chain.
+	 * \param reader The reader to play.
+	 * \param buffer_source The source reader if it reads from memory, otherwise nullptr.
+	 * \param keep Whether to keep the handle when the sound ends.
+	 * \return The new handle.
+	 */
+	std::shared_ptr<SoftwareHandle> AUD_LOCAL createHandle(std::shared_ptr<IReader> reader, std::shared_ptr<BufferReader> buffer_source, bool keep);
+
+	/**
+	 * Starts playing a reader with a handle from the pool if one is available.
+	 * \param reader The reader to play, nullptr if it is created from buffer.
+	 * \param buffer The buffer to play if the sound is in memory, otherwise nullptr.
+	 * \param keep Whether to keep the handle when the sound ends.
+	 * \param start The device clock sample at which the handle starts, 0 to start with the next mix.
+	 * \return The playback handle.
+	 */
+	std::shared_ptr<IHandle> AUD_LOCAL playHandle(std::shared_ptr<IReader> reader, std::shared_ptr<StreamBuffer> buffer, bool keep, uint64_t start = 0);
+
+	/**
+	 * Returns the position in the list of scheduled sounds for a handle.
+	 * \param start The device clock sample at which the handle starts.
+	 * \return The position after all handles starting at the same time or earlier.
+	 */
+	std::list<std::shared_ptr<SoftwareHandle> >::iterator AUD_LOCAL getSchedulePosition(uint64_t start);
+
+	/**
+	 * Converts the device clock and the scheduled start and stop samples to a new sample rate.
+	 * \param rate The new sample rate.
+	 */
+	void AUD_LOCAL rescaleClock(SampleRate rate);
+
 	// delete copy constructor and operator=
 	SoftwareDevice(const SoftwareDevice&) = delete;
 	SoftwareDevice& operator=(const SoftwareDevice&) = delete;
@@ -345,12 +783,224 @@ public:
 	 */
 	static void setPanning(IHandle* handle, float pan);
 
+	/**
+	 * Sets the priority of a specific handle.
+	 * When the number of voices is limited, handles with higher priority are
+	 * rendered first, handles of equal priority by their volume.
+	 * \param handle The handle to set the priority of.
+	 * \param priority The new priority, 0 by default.
+	 */
+	static void setPriority(IHandle* handle, int priority);
+
+	/**
+	 * Routes a handle into a submix bus.
+	 * \param handle The handle to route.
+	 * \param bus The bus to mix the handle into, nullptr for the device output.
+	 * \return Whether the handle is a software handle of the device of the bus.
+	 */
+	static bool setBus(IHandle* handle, std::shared_ptr<SubmixBus> bus);
+
 	/**
 	 * Sets the resampling quality.
 	 * \param quality Resampling quality vs performance setting.
 	 */
 	void setQuality(ResampleQuality quality);
 
+	/**
+	 * Returns whether the output is dithered.
+	 * \return Whether 8, 16 and 24 bit output is dithered.
+	 */
+	bool isDithering();
+
+	/**
+	 * Sets whether the output is dithered, which avoids the harmonic
+	 * distortion of truncating quiet signals for 8, 16 and 24 bit output.
+	 * \param dither Whether to dither the output, the default is false.
+	 */
+	void setDithering(bool dither);
+
+	/**
+	 * Returns the output latency of the device, the time between mixing a
+	 * sample and it being played back. For the round trip latency of live
+	 * monitoring the latency of the capture path has to be added.
+	 * \return The latency in seconds or 0 if it is unknown.
+	 */
+	virtual double getLatency();
+
+	/**
+	 * Returns the device clock, the time of the first sample of the next mix.
+	 * The clock starts at 0 when the device is created and advances with
+	 * every mix, independent of the synchronizer, but pauses while the device
+	 * is idle. It can be queried without locking the device.
+	 * \return The device clock in seconds.
+	 */
+	double getClock() const;
+
+	/**
+	 * Plays a sound starting at an exact sample of the device clock.
+	 * Until then the handle does not use a voice. If the time has already
+	 * passed, the sound starts with the next mix like with play().
+	 * Pausing a scheduled handle cancels the schedule.
+	 * \param sound The sound to play.
+	 * \param time The device clock time in seconds, see getClock().
+	 * \param keep Whether to keep the handle when the sound ends.
+	 * \return The playback handle.
+	 */
+	std::shared_ptr<IHandle> playAt(std::shared_ptr<ISound> sound, double time, bool keep = false);
+
+	/**
+	 * Plays a reader starting at an exact sample of the device clock.
+	 * \param reader The reader to play.
+	 * \param time The device clock time in seconds, see getClock().
+	 * \param keep Whether to keep the handle when the sound ends.
+	 * \return The playback handle.
+	 */
+	std::shared_ptr<IHandle> playAt(std::shared_ptr<IReader> reader, double time, bool keep = false);
+
+	/**
+	 * Stops a handle at an exact sample of the device clock.
+	 * The stop time is set without locking the device, so this can be
+	 * called from any thread. The last stop time set wins.
+	 * \param handle The handle to stop.
+	 * \param time The device clock time in seconds, see getClock().
+	 * \return Whether the handle is a valid handle of this device.
+	 */
+	bool stopAt(std::shared_ptr<IHandle> handle, double time);
+
+	/**
+	 * Returns the profile of a handle, see Profiler.
+	 * The root node contains all reads of the handle, its self time is spent
+	 * in the pitch, resampling and channel mapping of the device. Its
+	 * children are the profiled readers of the played sound.
+	 * \param handle The handle to get the profile of.
+	 * \return The root node of the profile or nullptr if the handle was
+	 *         played while profiling was disabled or is not a handle of this
+	 *         device.
+	 */
+	std::shared_ptr<ProfileNode> getProfile(std::shared_ptr<IHandle> handle);
+
+	/**
+	 * Enables or disables recording of the timing statistics.
+	 * While disabled, the recording costs one atomic load per mix.
+	 * \param enabled Whether to record statistics.
+	 */
+	void setStatisticsEnabled(bool enabled);
+
+	/**
+	 * Returns whether timing statistics are recorded.
+	 * \return Whether statistics are recorded.
+	 */
+	bool isStatisticsEnabled() const;
+
+	/**
+	 * Returns the timing statistics recorded since the last reset.
+	 * This does not lock the device.
+	 * \return The statistics.
+	 */
+	DeviceStatistics getStatistics() const;
+
+	/**
+	 * Clears the recorded timing statistics.
+	 */
+	void resetStatistics();
+
+	/**
+	 * Sets whether the device is used for offline rendering.
+	 * If enabled, sounds played on the device create their readers within an
+	 * OfflineRender scope, so that effects like time stretching can use
+	 * higher quality processing that is not suitable for real-time playback.
+	 * \param offline Whether the device renders offline.
+	 */
+	void setOfflineRendering(bool offline);
+
+	/**
+	 * Registers a sound that is kept converted to the device specification.
+	 * The sound is converted right away and again whenever the specification
+	 * of the device changes.
+	 * \param buffer The sound to convert. Only a weak reference is kept.
+	 */
+	void addDeviceBuffer(std::shared_ptr<DeviceBuffer> buffer);
+
+	/**
+	 * Retrieves the maximum number of voices that are rendered.
+	 * \return The maximum number of voices, 0 if unlimited.
+	 */
+	int getMaximumVoices() const;
+
+	/**
+	 * Sets the maximum number of voices that are rendered.
+	 * Playing handles exceeding this number become virtual: they are neither
+	 * read nor mixed, but their position keeps advancing so that they
+	 * continue seamlessly once they are rendered again.
+	 * \param count The maximum number of voices, 0 for no limit.
+	 */
+	void setMaximumVoices(int count);
+
+	/**
+	 * Retrieves the volume below which voices become virtual.
+	 * \return The volume threshold.
+	 */
+	float getVirtualizationVolume() const;
+
+	/**
+	 * Sets the volume below which voices become virtual.
+	 * The volume includes distance and cone attenuation.
+	 * \param volume The volume threshold, 0 disables virtualization by volume.
+	 */
+	void setVirtualizationVolume(float volume);
+
+	/**
+	 * Returns the number of voices rendered in the last mix.
+	 * \return The number of real voices.
+	 */
+	int getRealVoiceCount() const;
+
+	/**
+	 * Returns the number of virtual voices in the last mix.
+	 * \return The number of virtual voices.
+	 */
+	int getVirtualVoiceCount() const;
+
+	/**
+	 * Creates a new submix bus.
+	 * Buses are mixed into their parent, so buses can form a hierarchy. The
+	 * bus exists as long as it is referenced by the application, a child bus
+	 * or a handle routed to it.
+	 * \param parent The bus to mix into, nullptr for the device output.
+	 * \return The new bus.
+	 * \exception Exception Thrown if the parent belongs to another device.
+	 */
+	std::shared_ptr<SubmixBus> createBus(std::shared_ptr<SubmixBus> parent = nullptr);
+
+	/**
+	 * Creates a new ambisonics bus, which encodes the mono handles routed to
+	 * it into an ambisonic sound field and decodes it once for all of them.
+	 * \param decoder The decoder of the bus, which must not be shared with
+	 *        other buses.
+	 * \param parent The bus to mix into, nullptr for the device output.
+	 * \return The new bus.
+	 * \exception Exception Thrown if the parent belongs to another device or
+	 *            the decoder doesn't support the device specification.
+	 */
+	std::shared_ptr<SubmixBus> createAmbisonicsBus(std::shared_ptr<AmbisonicsDecoder> decoder, std::shared_ptr<SubmixBus> parent = nullptr);
+
+	/**
+	 * Preallocates handles with their reader chains, so that playing sounds
+	 * doesn't need to allocate memory for them.
+	 * Stopped handles are returned to this pool once they are no longer
+	 * referenced outside of the device. Sounds in memory (StreamBuffer and
+	 * DeviceBuffer) are played from the pool without any allocation.
+	 * The pool keeps at most count stopped handles, but at least 32.
+	 * \param count The number of handles available in the pool afterwards.
+	 */
+	void prewarm(int count);
+
+	/**
+	 * Returns the number of stopped handles in the pool.
+	 * \return The number of pooled handles.
+	 */
+	int getPooledHandleCount();
+
 	virtual DeviceSpecs getSpecs() const;
 	virtual std::shared_ptr<IHandle> play(std::shared_ptr<IReader> reader, bool keep = false);
 	virtual std::shared_ptr<IHandle> play(std::shared_ptr<ISound> sound, bool keep = false);
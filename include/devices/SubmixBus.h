@@ -0,0 +1,235 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file SubmixBus.h
+ * @ingroup devices
+ * The SubmixBus class.
+ */
+
+#include "respec/Specification.h"
+#include "util/Buffer.h"
+
+#include <atomic>
+#include <memory>
+
+AUD_NAMESPACE_BEGIN
+
+class AmbisonicsDecoder;
+class IReader;
+class ISound;
+class Mixer;
+class SoftwareDevice;
+
+/**
+ * A submix bus of a software device mixes the handles routed to it into its
+ * own buffer, runs a single effect chain on the mix and feeds the result into
+ * its parent bus or the device output.
+ *
+ * The effect chain is a sound built on the input sound of the bus, for
+ * example a Lowpass of getInput(). As the input only provides the samples of
+ * the current mix, effects must not read ahead of the samples they output.
+ *
+ * An ambisonics bus encodes the mono handles routed to it into an ambisonic
+ * sound field according to their 3D position and decodes the field once for
+ * all of them before the effect chain. Other handles are mixed unencoded.
+ *
+ * A bus can outlive its device. When the device is destroyed, the bus is
+ * detached from it and isn't mixed anymore. Buses must not be used while
+ * their device is being destroyed.
+ */
+class AUD_API SubmixBus
+{
+private:
+	class InputSound;
+	class InputReader;
+
+	/// The device the bus belongs to, nullptr once the device is destroyed.
+	std::atomic<SoftwareDevice*> m_device;
+
+	/// The bus this bus is mixed into, nullptr for the device output.
+	std::shared_ptr<SubmixBus> m_parent;
+
+	/// The mixer of the handles routed to this bus.
+	std::shared_ptr<Mixer> m_mixer;
+
+	/// The input sound of the effect chain.
+	std::shared_ptr<ISound> m_input;
+
+	/// The effect chain.
+	std::shared_ptr<ISound> m_effect;
+
+	/// The reader of the effect chain.
+	std::shared_ptr<IReader> m_reader;
+
+	/// The output buffer of the effect chain.
+	Buffer m_buffer;
+
+	/// The decoder of an ambisonics bus, nullptr for a regular bus.
+	std::shared_ptr<AmbisonicsDecoder> m_decoder;
+
+	/// Whether the decoder supports the device specification.
+	bool m_decoding;
+
+	/// The ambisonic sound field of the current mix.
+	Buffer m_ambisonics;
+
+	/// The length of the current mix in samples.
+	int m_length;
+
+	/// The number of the current mix.
+	unsigned int m_mix;
+
+	/// The volume of the bus, set without locking the device.
+	std::atomic<float> m_volume;
+
+	/// The volume of the bus in the previous mix.
+	float m_old_volume;
+
+	/// The time the members and the effect chain took in the current mix.
+	double m_time;
+
+	/// The processing time of the last complete mix.
+	std::atomic<double> m_last_time;
+
+	// delete copy constructor and operator=
+	SubmixBus(const SubmixBus&) = delete;
+	SubmixBus& operator=(const SubmixBus&) = delete;
+
+	friend class SoftwareDevice;
+
+	/**
+	 * Creates a new submix bus.
+	 * \param device The device the bus belongs to.
+	 * \param parent The bus this bus is mixed into, nullptr for the device output.
+	 * \param specs The specification of the device.
+	 * \param decoder The ambisonics decoder, nullptr for a regular bus.
+	 * \exception Exception Thrown if the decoder doesn't support the specification.
+	 */
+	SubmixBus(SoftwareDevice* device, std::shared_ptr<SubmixBus> parent, Specs specs, std::shared_ptr<AmbisonicsDecoder> decoder = nullptr);
+
+	/**
+	 * Creates a new submix bus together with its input sound.
+	 * \param device The device the bus belongs to.
+	 * \param parent The bus this bus is mixed into, nullptr for the device output.
+	 * \param specs The specification of the device.
+	 * \param decoder The ambisonics decoder, nullptr for a regular bus.
+	 * \return The new bus.
+	 * \exception Exception Thrown if the decoder doesn't support the specification.
+	 */
+	static std::shared_ptr<SubmixBus> AUD_LOCAL create(SoftwareDevice* device, std::shared_ptr<SubmixBus> parent, Specs specs, std::shared_ptr<AmbisonicsDecoder> decoder = nullptr);
+
+	/**
+	 * Changes the specification of the bus and recreates the effect chain.
+	 * \param specs The new specification of the device.
+	 */
+	void AUD_LOCAL setSpecs(Specs specs);
+
+	/**
+	 * Clears the mixing buffer for the next mix.
+	 * \param length The length of the mix in samples.
+	 */
+	void AUD_LOCAL clear(int length);
+
+	/**
+	 * Encodes mono samples into the ambisonic sound field of the current mix.
+	 * \param buffer The samples to encode.
+	 * \param start The start sample of the mix.
+	 * \param length The length of the buffer in samples.
+	 * \param coefficients_to The encoding coefficients at the end of the buffer.
+	 * \param coefficients_from The encoding coefficients at the start of the buffer.
+	 */
+	void AUD_LOCAL encode(sample_t* buffer, int start, int length, const float* coefficients_to, const float* coefficients_from);
+
+	/**
+	 * Adds a processing time to the current mix.
+	 * \param time The time in seconds.
+	 */
+	void AUD_LOCAL addTime(double time);
+
+	/**
+	 * Runs the effect chain on the mix and mixes the result into the target.
+	 * \param target The mixer of the parent bus or the device.
+	 * \param timing Whether the processing time is measured.
+	 */
+	void AUD_LOCAL process(Mixer& target, bool timing);
+
+public:
+	/**
+	 * Destroys the bus.
+	 */
+	~SubmixBus();
+
+	/**
+	 * Returns the bus this bus is mixed into.
+	 * \return The parent bus, nullptr if the bus is mixed into the device output.
+	 */
+	std::shared_ptr<SubmixBus> getParent() const;
+
+	/**
+	 * Returns the ambisonics decoder of the bus.
+	 * \return The decoder, nullptr if the bus is a regular bus.
+	 */
+	std::shared_ptr<AmbisonicsDecoder> getDecoder() const;
+
+	/**
+	 * Returns the sound that represents the mix of the bus, which has to be
+	 * the source of the effect chain. The sound only references the bus
+	 * weakly: readers of it are silent once the bus is destroyed and
+	 * creating a reader then fails.
+	 * \return The input sound of the bus.
+	 */
+	std::shared_ptr<ISound> getInput() const;
+
+	/**
+	 * Returns the effect chain of the bus.
+	 * \return The effect chain, nullptr if there is none.
+	 */
+	std::shared_ptr<ISound> getEffect() const;
+
+	/**
+	 * Sets the effect chain of the bus.
+	 * \param effect A sound built on getInput() or nullptr to disable effects.
+	 * \exception Exception Thrown if the reader of the effect can't be created.
+	 */
+	void setEffect(std::shared_ptr<ISound> effect);
+
+	/**
+	 * Returns the volume of the bus.
+	 * \return The volume.
+	 */
+	float getVolume() const;
+
+	/**
+	 * Sets the volume of the bus.
+	 * \param volume The new volume.
+	 */
+	void setVolume(float volume);
+
+	/**
+	 * Returns the time the last mix of the bus took, including reading and
+	 * mixing the handles routed to it and running its effect chain.
+	 * Child buses are not included. The time is only measured while the
+	 * statistics of the device are enabled, see
+	 * SoftwareDevice::setStatisticsEnabled().
+	 * \return The processing time in seconds.
+	 */
+	double getProcessingTime() const;
+};
+
+AUD_NAMESPACE_END
@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file AmbisonicsBinauralDecoder.h
+ * @ingroup fx
+ * The AmbisonicsBinauralDecoder class.
+ */
+
+#include "fx/AmbisonicsDecoder.h"
+#include "fx/Convolver.h"
+#include "fx/HRTF.h"
+#include "util/Buffer.h"
+#include "util/FFTPlan.h"
+#include "util/ThreadPool.h"
+
+#include <memory>
+#include <vector>
+
+AUD_NAMESPACE_BEGIN
+
+/**
+ * This decoder renders an ambisonic sound field binaurally for headphones.
+ *
+ * The sound field is decoded to virtual speakers evenly distributed around
+ * the listener, whose HRTFs are combined into one pair of filters per
+ * ambisonic channel. Decoding therefore needs two convolutions per ambisonic
+ * channel, independent of the number of sources in the sound field.
+ *
+ * The output has a latency of half the size of the FFT plan. It is written
+ * to the front left and right channels, mono output gets their average.
+ */
+class AUD_API AmbisonicsBinauralDecoder : public AmbisonicsDecoder
+{
+private:
+	/// The HRTFs of the virtual speakers.
+	std::shared_ptr<HRTF> m_hrtfs;
+
+	/// The convolvers of the left and right ear for every ambisonic channel.
+	std::vector<std::unique_ptr<Convolver>> m_convolvers;
+
+	/// The number of virtual speakers.
+	int m_speakers;
+
+	/// The block length of the convolvers.
+	int m_L;
+
+	/// The position within the current block.
+	int m_position;
+
+	/// The output channel count.
+	int m_channels;
+
+	/// The ambisonic channels of the current block, one after another.
+	Buffer m_input;
+
+	/// The left and right output of the previous block, one after another.
+	Buffer m_output;
+
+	/// The output of a single convolver.
+	Buffer m_temp;
+
+	// delete copy constructor and operator=
+	AmbisonicsBinauralDecoder(const AmbisonicsBinauralDecoder&) = delete;
+	AmbisonicsBinauralDecoder& operator=(const AmbisonicsBinauralDecoder&) = delete;
+
+	/**
+	 * Convolves the current block into the output buffer.
+	 */
+	void AUD_LOCAL process();
+
+	/**
+	 * Resets the convolvers and buffers.
+	 */
+	void AUD_LOCAL reset();
+
+public:
+	/**
+	 * Creates a new binaural decoder.
+	 * \param order The ambisonics order, between 1 and AUD_AMBISONICS_MAX_ORDER.
+	 * \param hrtfs The HRTFs, which have to be processed with a plan of the same size.
+	 * \param threadPool The thread pool used by the convolvers.
+	 * \param plan The FFT plan used by the convolvers.
+	 * \exception Exception Thrown if the order is not supported or the HRTFs are empty.
+	 */
+	AmbisonicsBinauralDecoder(int order, std::shared_ptr<HRTF> hrtfs, std::shared_ptr<ThreadPool> threadPool, std::shared_ptr<FFTPlan> plan);
+
+	/**
+	 * Returns the number of virtual speakers with distinct HRTFs.
+	 * \return The virtual speaker count.
+	 */
+	int getVirtualSpeakerCount() const;
+
+	virtual void setSpecs(Specs specs);
+	virtual void decode(const sample_t* input, sample_t* output, int length);
+};
+
+AUD_NAMESPACE_END
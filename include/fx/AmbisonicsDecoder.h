@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file AmbisonicsDecoder.h
+ * @ingroup fx
+ * The AmbisonicsDecoder class.
+ */
+
+#include "respec/Specification.h"
+
+/// The highest supported ambisonics order.
+#define AUD_AMBISONICS_MAX_ORDER 3
+
+/// The number of ambisonic channels of an order.
+#define AUD_AMBISONICS_CHANNELS(order) (((order) + 1) * ((order) + 1))
+
+AUD_NAMESPACE_BEGIN
+
+/**
+ * An ambisonics decoder renders a sound field in ambisonics format to the
+ * output channels of a device.
+ *
+ * The sound field uses ACN channel ordering and SN3D normalization. The x axis
+ * points to the front of the listener, the y axis to the left and the z axis
+ * upwards.
+ */
+class AUD_API AmbisonicsDecoder
+{
+private:
+	// delete copy constructor and operator=
+	AmbisonicsDecoder(const AmbisonicsDecoder&) = delete;
+	AmbisonicsDecoder& operator=(const AmbisonicsDecoder&) = delete;
+
+protected:
+	/// The ambisonics order.
+	const int m_order;
+
+	/**
+	 * Creates a new decoder.
+	 * \param order The ambisonics order, between 1 and AUD_AMBISONICS_MAX_ORDER.
+	 * \exception Exception Thrown if the order is not supported.
+	 */
+	AmbisonicsDecoder(int order);
+
+	/**
+	 * Returns the max-rE weight of an order, which maximizes the energy
+	 * concentration of a decoded source in its direction.
+	 * \param degree The degree of the spherical harmonics to weight.
+	 * \return The weight.
+	 */
+	float getMaxREWeight(int degree) const;
+
+public:
+	virtual ~AmbisonicsDecoder();
+
+	/**
+	 * Returns the ambisonics order of the decoder.
+	 * \return The order.
+	 */
+	int getOrder() const;
+
+	/**
+	 * Returns the number of ambisonic channels the decoder reads.
+	 * \return The channel count.
+	 */
+	int getChannels() const;
+
+	/**
+	 * Prepares the decoder for the output specification of a device.
+	 * \param specs The output specification.
+	 * \exception Exception Thrown if the decoder can't render to the specification.
+	 */
+	virtual void setSpecs(Specs specs)=0;
+
+	/**
+	 * Decodes a sound field and adds the result to the output.
+	 * \param input The interleaved ambisonic channels.
+	 * \param output The interleaved output channels to add the result to.
+	 * \param length The length of the input and output in samples.
+	 */
+	virtual void decode(const sample_t* input, sample_t* output, int length)=0;
+
+	/**
+	 * Calculates the ambisonic encoding coefficients of a direction.
+	 * \param order The ambisonics order.
+	 * \param x The front component of the normalized direction.
+	 * \param y The left component of the normalized direction.
+	 * \param z The upwards component of the normalized direction.
+	 * \param[out] coefficients The AUD_AMBISONICS_CHANNELS(order) coefficients.
+	 */
+	static void encode(int order, float x, float y, float z, float* coefficients);
+};
+
+AUD_NAMESPACE_END
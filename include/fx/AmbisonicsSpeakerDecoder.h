@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file AmbisonicsSpeakerDecoder.h
+ * @ingroup fx
+ * The AmbisonicsSpeakerDecoder class.
+ */
+
+#include "fx/AmbisonicsDecoder.h"
+
+#include <vector>
+
+AUD_NAMESPACE_BEGIN
+
+/**
+ * This decoder renders an ambisonic sound field to the speakers of the channel
+ * layout of the device.
+ *
+ * It samples the sound field in the directions of the speakers with max-rE
+ * weighting and normalizes the matrix to preserve the energy of sources in
+ * the horizontal plane. The LFE channel stays silent and mono output only
+ * receives the omnidirectional channel.
+ */
+class AUD_API AmbisonicsSpeakerDecoder : public AmbisonicsDecoder
+{
+private:
+	/// The decoding matrix with the ambisonic coefficients of every output channel.
+	std::vector<float> m_matrix;
+
+	/// The output channel count.
+	int m_channels;
+
+	// delete copy constructor and operator=
+	AmbisonicsSpeakerDecoder(const AmbisonicsSpeakerDecoder&) = delete;
+	AmbisonicsSpeakerDecoder& operator=(const AmbisonicsSpeakerDecoder&) = delete;
+
+public:
+	/**
+	 * Creates a new speaker decoder.
+	 * \param order The ambisonics order, between 1 and AUD_AMBISONICS_MAX_ORDER.
+	 * \exception Exception Thrown if the order is not supported.
+	 */
+	AmbisonicsSpeakerDecoder(int order);
+
+	/**
+	 * Returns the decoding coefficient of an ambisonic channel for an output channel.
+	 * \param channel The output channel.
+	 * \param ambisonic_channel The ambisonic channel.
+	 * \return The coefficient.
+	 */
+	float getCoefficient(int channel, int ambisonic_channel) const;
+
+	virtual void setSpecs(Specs specs);
+	virtual void decode(const sample_t* input, sample_t* output, int length);
+};
+
+AUD_NAMESPACE_END
@@ -47,6 +47,11 @@ private:
 	 */
 	std::shared_ptr<AnimateableProperty> m_pitchScale;
 
+	/**
+	 * Updates the time ratio and pitch scale from the animation at the current position.
+	 */
+	AUD_LOCAL void updateAnimation();
+
 	// delete copy constructor and operator=
 	AnimateableTimeStretchPitchScaleReader(const AnimateableTimeStretchPitchScaleReader&) = delete;
 	AnimateableTimeStretchPitchScaleReader& operator=(const AnimateableTimeStretchPitchScaleReader&) = delete;
@@ -66,6 +71,8 @@ public:
 
 	virtual void read(int& length, bool& eos, sample_t* buffer) override;
 
+	virtual void readPlanar(int& length, bool& eos, sample_t* const* buffers) override;
+
 	virtual void seek(int position) override;
 };
 
@@ -23,13 +23,16 @@
  */
 
 #include "fx/EffectReader.h"
+#include "IPlanarReader.h"
+#include "util/Buffer.h"
 
 AUD_NAMESPACE_BEGIN
 
 /**
  * This class is a base class for infinite impulse response filters.
+ * The channels are filtered separately, so it also supports planar reading.
  */
-class AUD_API BaseIIRFilterReader : public EffectReader
+class AUD_API BaseIIRFilterReader : public EffectReader, public IPlanarReader
 {
 private:
 	/**
@@ -48,12 +51,13 @@ private:
 	int m_ylen;
 
 	/**
-	 * The last in samples array.
+	 * The last in samples array. The history of every channel is stored twice
+	 * in a row, so that it can be accessed without wrapping around.
 	 */
 	sample_t* m_x;
 
 	/**
-	 * The last out samples array.
+	 * The last out samples array, stored like the in samples.
 	 */
 	sample_t* m_y;
 
@@ -72,10 +76,46 @@ private:
 	 */
 	int m_channel;
 
+	/**
+	 * The second copy of the in samples history of the current channel.
+	 */
+	sample_t* m_xchannel;
+
+	/**
+	 * The second copy of the out samples history of the current channel.
+	 */
+	sample_t* m_ychannel;
+
+	/**
+	 * The interleaved buffer for planar reading from a non-planar reader.
+	 */
+	Buffer m_buffer;
+
 	// delete copy constructor and operator=
 	BaseIIRFilterReader(const BaseIIRFilterReader&) = delete;
 	BaseIIRFilterReader& operator=(const BaseIIRFilterReader&) = delete;
 
+	/**
+	 * Adapts the filter state to changed specs of the input reader.
+	 */
+	AUD_LOCAL void updateSpecs();
+
+	/**
+	 * Sets the current channel.
+	 * \param channel The channel to filter.
+	 */
+	AUD_LOCAL void selectChannel(int channel);
+
+	/**
+	 * Filters the current channel in place, starting at the given history position.
+	 * \param buffer The pointer to the first sample of the channel.
+	 * \param stride The distance between two samples of the channel.
+	 * \param length The number of samples.
+	 * \param xpos The position of the current input sample in the input array.
+	 * \param ypos The position of the current output sample in the output array.
+	 */
+	AUD_LOCAL void filterChannel(sample_t* buffer, int stride, int length, int xpos, int ypos);
+
 protected:
 	/**
 	 * Creates a new base IIR filter reader.
@@ -100,7 +140,7 @@ public:
 	 */
 	inline sample_t x(int pos)
 	{
-		return m_x[(m_xpos + pos + m_xlen) % m_xlen * m_specs.channels + m_channel];
+		return m_xchannel[m_xpos + pos];
 	}
 
 	/**
@@ -110,12 +150,13 @@ public:
 	 */
 	inline sample_t y(int pos)
 	{
-		return m_y[(m_ypos + pos + m_ylen) % m_ylen * m_specs.channels + m_channel];
+		return m_ychannel[m_ypos + pos];
 	}
 
 	virtual ~BaseIIRFilterReader();
 
 	virtual void read(int& length, bool& eos, sample_t* buffer);
+	virtual void readPlanar(int& length, bool& eos, sample_t* const* buffers);
 
 	/**
 	 * Runs the filtering function.
@@ -24,15 +24,16 @@
 
 #include "IReader.h"
 #include "ISound.h"
-#include "Convolver.h"
 #include "HRTF.h"
 #include "Source.h"
 #include "util/FFTPlan.h"
 #include "util/ThreadPool.h"
 
+#include <complex>
 #include <memory>
 #include <vector>
 #include <future>
+#include <utility>
 
 AUD_NAMESPACE_BEGIN
 
@@ -82,6 +83,11 @@ private:
 	*/
 	float m_RealElevation;
 
+	/**
+	* The FFT plan used for convolution.
+	*/
+	std::shared_ptr<FFTPlan> m_plan;
+
 	/**
 	* The FFT size, given by the FFTPlan.
 	*/
@@ -98,19 +104,49 @@ private:
 	int m_L;
 
 	/**
-	* The array of convolvers that will be used, one per channel.
+	* The impulse responses for the left and right ear in use.
 	*/
-	std::vector<std::unique_ptr<Convolver>> m_convolvers;
+	std::pair<std::shared_ptr<ImpulseResponse>, std::shared_ptr<ImpulseResponse>> m_impulseResponses;
 
 	/**
-	* True if a transition is happening.
+	* The impulse responses that were in use before the last source movement.
+	*/
+	std::pair<std::shared_ptr<ImpulseResponse>, std::shared_ptr<ImpulseResponse>> m_oldImpulseResponses;
+
+	/**
+	* True if the current block fades from the old to the new impulse responses.
 	*/
 	bool m_transition;
 
 	/**
-	* The position of the current transition (decreasing)
+	* The number of spectra in the frequency domain delay line.
+	*/
+	int m_parts;
+
+	/**
+	* The frequency domain delay line, the spectra of the last m_parts input blocks, shared by both ears and all impulse responses.
+	*/
+	std::vector<std::complex<sample_t>> m_spectra;
+
+	/**
+	* The position of the newest spectrum in m_spectra.
+	*/
+	int m_spectrumPos;
+
+	/**
+	* The buffer the input spectrum is calculated in.
+	*/
+	std::complex<sample_t>* m_fftBuffer;
+
+	/**
+	* The buffers the output spectra of both ears are accumulated in.
+	*/
+	std::vector<std::complex<sample_t>*> m_accBuffers;
+
+	/**
+	* The buffers the output spectra of the old impulse responses are accumulated in during transitions.
 	*/
-	int m_transPos;
+	std::vector<std::complex<sample_t>*> m_oldAccBuffers;
 
 	/**
 	* The output buffer in which the convolved data will be written and from which the reader will read.
@@ -118,24 +154,24 @@ private:
 	sample_t* m_outBuffer;
 
 	/**
-	* The input buffer that will hold the data to be convolved.
+	* The input buffer that holds the last two input slices.
 	*/
 	sample_t* m_inBuffer;
 
 	/**
-	* Current position in which the m_outBuffer is being read.
+	* Current position in which the m_outBuffer is being read, in samples per channel.
 	*/
 	int m_outBufferPos;
 
 	/**
-	* Length of rhe m_outBuffer.
+	* Length of the data in m_outBuffer, in samples per channel.
 	*/
 	int m_outBufLen;
 
 	/**
-	* Effective length of rhe m_outBuffer.
+	* The number of samples that are still to be generated after the input sound ended.
 	*/
-	int m_eOutBufLen;
+	int m_tailLength;
 
 	/**
 	* Flag indicating whether the end of the sound has been reached or not.
@@ -147,25 +183,15 @@ private:
 	*/
 	bool m_eosTail;
 
-	/**
-	* A vector of buffers (one per channel) on which the audio signal will be separated per channel so it can be convolved.
-	*/
-	std::vector<sample_t*> m_vecOut;
-
 	/**
 	* A shared ptr to a thread pool.
 	*/
 	std::shared_ptr<ThreadPool> m_threadPool;
 
-	/**
-	* Length of the input data to be used by the channel threads.
-	*/
-	int m_lastLengthIn;
-
 	/**
 	* A vector of futures to sync tasks.
 	*/
-	std::vector<std::future<int>> m_futures;
+	std::vector<std::future<bool>> m_futures;
 
 	// delete copy constructor and operator=
 	BinauralReader(const BinauralReader&) = delete;
@@ -193,30 +219,21 @@ public:
 
 private:
 	/**
-	* Joins several buffers (one per channel) into the m_outBuffer.
-	* \param start The starting position from which the m_outBuffer will be written.
-	* \param len The amout of samples that will be joined.
-	* \param nConvolvers The number of convolvers that have been used. Only use 2 or 4 as possible values.
-						 If the value is 4 the result will be interpolated.
+	* Convolves the next input slice and loads the m_outBuffer with the result.
 	*/
-	void joinByChannel(int start, int len, int nConvolvers);
+	void loadBuffer();
 
 	/**
-	* Loads the m_outBuffer with data.
-	* \param nConvolvers The number of convolver objects that will be used. Only 2 or 4 should be used.
+	* The function that the threads will run. It convolves the input for one ear.
+	* \param ear The ear to process, 0 for the left and 1 for the right one.
+	* \return Always true.
 	*/
-	void loadBuffer(int nConvolvers);
+	bool threadFunction(int ear);
 
 	/**
-	* The function that the threads will run. It will process a subset of channels.
-	* \param id An id number that will determine which subset of channels will be processed.
-	* \param input A flag that will indicate if thare is input data.
-	*		-If true there is new input data.
-	*		-If false there isn't new input data.
-	* \return The number of samples obtained.
+	* Looks up new impulse responses if the source moved.
+	* \return Whether the impulse responses changed.
 	*/
-	int threadFunction(int id, bool input);
-
 	bool checkSource();
 };
 
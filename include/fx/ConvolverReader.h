@@ -22,6 +22,7 @@
 * The ConvolverReader class.
 */
 
+#include "IPlanarReader.h"
 #include "IReader.h"
 #include "ISound.h"
 #include "Convolver.h"
@@ -51,6 +52,11 @@ private:
 	*/
 	std::shared_ptr<IReader> m_reader;
 
+	/**
+	* The reader of the input sound if it supports planar reading, nullptr otherwise.
+	*/
+	IPlanarReader* m_planarReader;
+
 	/**
 	* The impulse response in the frequency domain.
 	*/
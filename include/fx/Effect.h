@@ -23,6 +23,7 @@
  */
 
 #include "ISound.h"
+#include "util/Profiler.h"
 
 AUD_NAMESPACE_BEGIN
 
@@ -46,12 +47,12 @@ protected:
 	/**
 	 * Returns the reader created out of the sound.
 	 * This method can be used for the createReader function of the implementing
-	 * classes.
+	 * classes, the reader is profiled if profiling is enabled.
 	 * \return The reader created out of the sound.
 	 */
 	inline std::shared_ptr<IReader> getReader() const
 	{
-		return m_sound->createReader();
+		return Profiler::createReader(m_sound);
 	}
 
 public:
@@ -57,6 +57,12 @@ public:
 	 */
 	virtual ~EffectReader();
 
+	/**
+	 * Exchanges the reader to read from.
+	 * \param reader The new reader to read from.
+	 */
+	void setReader(std::shared_ptr<IReader> reader);
+
 	virtual bool isSeekable() const;
 	virtual void seek(int position);
 	virtual int getLength() const;
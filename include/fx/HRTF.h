@@ -26,9 +26,10 @@
 #include "util/FFTPlan.h"
 #include "ImpulseResponse.h"
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
-#include <unordered_map>
 #include <utility>
 
 AUD_NAMESPACE_BEGIN
@@ -40,15 +41,51 @@ class AUD_API HRTF
 {
 private:
 	/**
-	* An unordered map of unordered maps containing the ImpulseResponse objects of the HRTFs.
+	* The ImpulseResponse objects of the HRTFs.
 	*/
-	std::unordered_map<float, std::unordered_map<float, std::shared_ptr<ImpulseResponse>>> m_hrtfs;
+	std::vector<std::shared_ptr<ImpulseResponse>> m_hrtfs;
+
+	/**
+	* The azimuth and elevation angles of the HRTFs.
+	*/
+	std::vector<std::pair<float, float>> m_angles;
+
+	/**
+	* The indices of the HRTFs by their azimuth and elevation angles.
+	*/
+	std::map<std::pair<float, float>, int> m_angleIndex;
+
+	/**
+	* The directions of the HRTFs as unit vectors, three values per HRTF.
+	*/
+	std::vector<float> m_directions;
+
+	/**
+	* A k-d tree over the directions. It contains the indices of the HRTFs, where the middle of every range is the median that splits it.
+	* It is rebuilt on the first lookup after HRTFs have been added.
+	*/
+	std::vector<int> m_index;
 
 	/**
 	* The FFTPlan used to create the ImpulseResponses.
 	*/
 	std::shared_ptr<FFTPlan> m_plan;
 
+	/**
+	* True if the impulse responses are interpolated between the closest HRTFs.
+	*/
+	bool m_interpolation;
+
+	/**
+	* The interpolated impulse responses, which are reused once they aren't referenced anymore.
+	*/
+	std::vector<std::shared_ptr<ImpulseResponse>> m_interpolated;
+
+	/**
+	* The mutex for the lookups.
+	*/
+	std::mutex m_mutex;
+
 	/**
 	* The specifications of the HRTFs.
 	*/
@@ -63,6 +100,57 @@ private:
 	HRTF(const HRTF&) = delete;
 	HRTF& operator=(const HRTF&) = delete;
 
+	friend class ImpulseResponseBank;
+
+	/**
+	* Adds a new HRTF without updating the k-d tree.
+	* \param impulseResponse The HRTF.
+	* \param azimuth The azimuth angle of the HRTF. Interval [0,360).
+	* \param elevation The elevation angle of the HRTF.
+	*/
+	void AUD_LOCAL insert(std::shared_ptr<ImpulseResponse> impulseResponse, float azimuth, float elevation);
+
+	/**
+	* Rebuilds the k-d tree after HRTFs have been added.
+	*/
+	void AUD_LOCAL updateIndex();
+
+	/**
+	* Sorts a range of the k-d tree.
+	* \param begin The start of the range.
+	* \param end The end of the range.
+	* \param depth The depth of the range in the tree, which determines the axis it is split on.
+	*/
+	void AUD_LOCAL buildIndex(int begin, int end, int depth);
+
+	/**
+	* Searches a range of the k-d tree for the HRTFs closest to a direction.
+	* \param direction The direction as unit vector.
+	* \param begin The start of the range.
+	* \param end The end of the range.
+	* \param depth The depth of the range in the tree.
+	* \param count The number of HRTFs to find.
+	* \param[in,out] nearest The indices of the closest HRTFs found so far, sorted by distance.
+	* \param[in,out] distances The squared distances of the closest HRTFs found so far.
+	*/
+	void AUD_LOCAL findNearest(const float* direction, int begin, int end, int depth, int count, int* nearest, float* distances) const;
+
+	/**
+	* Returns an interpolated impulse response that isn't used anymore or creates a new one.
+	* \param parts The number of parts of the impulse response.
+	* \param bins The number of frequency bins of every part.
+	* \param length The length of the impulse response.
+	* \return The cleared impulse response.
+	*/
+	std::shared_ptr<ImpulseResponse> AUD_LOCAL getInterpolationBuffer(int parts, int bins, int length);
+
+	/**
+	* Interpolates an impulse response in the frequency domain between the HRTFs closest to a direction.
+	* \param direction The direction as unit vector.
+	* \return The interpolated impulse response.
+	*/
+	std::shared_ptr<ImpulseResponse> AUD_LOCAL interpolate(const float* direction);
+
 public:
 	/**
 	* Creates a new empty HRTF object that will instance it own FFTPlan with default size.
@@ -85,13 +173,51 @@ public:
 	bool addImpulseResponse(std::shared_ptr<StreamBuffer> impulseResponse, float azimuth, float elevation);
 
 	/**
-	* Retrieves a pair of HRTFs for a certain azimuth and elevation. If no exact match is found, the closest ones will be chosen (the elevation has priority over the azimuth).
+	* Adds a new HRTF that is already processed to the class.
+	* \param impulseResponse The HRTF, which has to be processed with the same FFT plan size as the other HRTFs.
+	* \param azimuth The azimuth angle of the HRTF. Interval [0,360).
+	* \param elevation The elevation angle of the HRTF.
+	* \return True if the impulse response was added successfully, false otherwise (the specs weren't correct).
+	*/
+	bool addImpulseResponse(std::shared_ptr<ImpulseResponse> impulseResponse, float azimuth, float elevation);
+
+	/**
+	* Retrieves the number of HRTFs.
+	* \return The number of HRTFs.
+	*/
+	int getCount() const;
+
+	/**
+	* Retrieves one of the HRTFs as it was added.
+	* \param index The number of the HRTF, from 0 to getCount()-1.
+	* \param[out] azimuth The azimuth angle of the HRTF.
+	* \param[out] elevation The elevation angle of the HRTF.
+	* \return The HRTF.
+	*/
+	std::shared_ptr<ImpulseResponse> getMeasurement(int index, float& azimuth, float& elevation) const;
+
+	/**
+	* Retrieves a pair of HRTFs for a certain azimuth and elevation. If no exact match is found, the closest ones on the sphere will be chosen.
+	* With interpolation enabled, the direction is rounded to whole degrees and the HRTFs are interpolated between the three closest ones instead.
 	* \param[in,out] azimuth The desired azimuth angle. If no exact match is found, the value of azimuth will represent the actual azimuth elevation of the chosen HRTF. Interval [0,360)
 	* \param[in,out] elevation The desired elevation angle. If no exact match is found, the value of elevation will represent the actual elevation angle of the chosen HRTF.
 	* \return A pair of shared pointers to ImpulseResponse objects containing the HRTFs for the left (first element) and right (second element) ears.
 	*/
 	std::pair<std::shared_ptr<ImpulseResponse>, std::shared_ptr<ImpulseResponse>> getImpulseResponse(float &azimuth, float &elevation);
 
+	/**
+	* Retrieves whether the HRTFs are interpolated.
+	* \return True if interpolation is enabled, false otherwise.
+	*/
+	bool getInterpolation() const;
+
+	/**
+	* Enables or disables the interpolation of the HRTFs in the frequency domain.
+	* Interpolated HRTFs change gradually with the direction, so that moving sources don't jump between measured directions.
+	* \param interpolation True to enable interpolation.
+	*/
+	void setInterpolation(bool interpolation);
+
 	/**
 	* Retrieves the specs shared by all the HRTFs.
 	* \return The shared specs of all the HRTFs.
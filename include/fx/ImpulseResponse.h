@@ -77,6 +77,14 @@ public:
 	*/
 	ImpulseResponse(std::shared_ptr<StreamBuffer> impulseResponse);
 
+	/**
+	* Creates a new ImpulseResponse object from data that is already split and transformed to the frequency domain.
+	* \param processedIR The parts of every channel of the impulse response.
+	* \param length The length of the impulse response.
+	* \param specs The specification of the impulse response.
+	*/
+	ImpulseResponse(std::vector<std::shared_ptr<std::vector<std::shared_ptr<std::vector<std::complex<sample_t>>>>>> processedIR, int length, Specs specs);
+
 	/**
 	* Returns the specification of the impulse response.
 	* \return The specification of the impulse response.
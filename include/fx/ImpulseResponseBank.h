@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file ImpulseResponseBank.h
+ * @ingroup fx
+ * The ImpulseResponseBank class.
+ */
+
+#include "fx/HRTF.h"
+#include "fx/ImpulseResponse.h"
+#include "util/FFTPlan.h"
+
+#include <memory>
+#include <string>
+
+AUD_NAMESPACE_BEGIN
+
+/**
+ * This class reads and writes impulse response banks, binary files that store
+ * impulse responses or complete HRTF sets already split and transformed to the
+ * frequency domain for one FFT plan size.
+ *
+ * Loading a bank maps the file into memory and copies the spectra into the
+ * impulse responses, so neither decoding nor FFTs are necessary.
+ *
+ * The file starts with a header containing the magic "AUDIRBK", the format
+ * version, a byte order mark, the FFT size, the sample rate, the channel count
+ * and the number of impulse responses. It is followed by a table with the
+ * direction, the length and the data offset of every impulse response and the
+ * spectra themselves, which are stored as native single precision complex
+ * numbers for every channel and part.
+ */
+class AUD_API ImpulseResponseBank
+{
+private:
+	// delete normal constructor, copy constructor and operator=
+	ImpulseResponseBank(const ImpulseResponseBank&) = delete;
+	ImpulseResponseBank& operator=(const ImpulseResponseBank&) = delete;
+	ImpulseResponseBank() = delete;
+
+public:
+	/**
+	 * Writes an HRTF set to a bank.
+	 * \param hrtfs The HRTFs to write.
+	 * \param filename The path of the bank.
+	 * \exception Exception Thrown if the HRTF set is empty or the file can't be written.
+	 */
+	static void writeHRTF(std::shared_ptr<HRTF> hrtfs, const std::string& filename);
+
+	/**
+	 * Writes a single impulse response to a bank.
+	 * \param impulseResponse The impulse response to write.
+	 * \param filename The path of the bank.
+	 * \exception Exception Thrown if the file can't be written.
+	 */
+	static void writeImpulseResponse(std::shared_ptr<ImpulseResponse> impulseResponse, const std::string& filename);
+
+	/**
+	 * Reads an HRTF set from a bank.
+	 * \param filename The path of the bank.
+	 * \param plan The plan that will be used to create the HRTF object, its size has to match the bank.
+	 * \return A shared pointer to the loaded HRTF object.
+	 * \exception Exception Thrown if the file can't be read, is invalid or doesn't match the plan.
+	 */
+	static std::shared_ptr<HRTF> readHRTF(const std::string& filename, std::shared_ptr<FFTPlan> plan);
+
+	/**
+	 * Reads a single impulse response from a bank.
+	 * \param filename The path of the bank.
+	 * \param plan The plan the impulse response will be used with, its size has to match the bank.
+	 * \return A shared pointer to the loaded impulse response.
+	 * \exception Exception Thrown if the file can't be read, is invalid or doesn't match the plan.
+	 */
+	static std::shared_ptr<ImpulseResponse> readImpulseResponse(const std::string& filename, std::shared_ptr<FFTPlan> plan);
+};
+
+AUD_NAMESPACE_END
@@ -31,6 +31,8 @@
 
 AUD_NAMESPACE_BEGIN
 
+class SubmixBus;
+
 /**
 * This class represents a category of related sounds which are currently playing and allows to control them easily.
 */
@@ -62,6 +64,11 @@ private:
 	*/
 	std::shared_ptr<VolumeStorage> m_volumeStorage;
 
+	/**
+	* Submix bus the sounds of the category are mixed into.
+	*/
+	std::shared_ptr<SubmixBus> m_bus;
+
 	// delete copy constructor and operator=
 	PlaybackCategory(const PlaybackCategory&) = delete;
 	PlaybackCategory& operator=(const PlaybackCategory&) = delete;
@@ -114,6 +121,19 @@ public:
 	*/
 	std::shared_ptr<VolumeStorage> getSharedVolume();
 
+	/**
+	* Retrieves the submix bus of the category.
+	* \return The bus the sounds of the category are mixed into, nullptr for the device output.
+	*/
+	std::shared_ptr<SubmixBus> getBus();
+
+	/**
+	* Sets the submix bus of the category, so that effects can be applied to all its sounds at once.
+	* Only has an effect if the device of the category is a software device.
+	* \param bus The bus to mix the sounds into, nullptr for the device output.
+	*/
+	void setBus(std::shared_ptr<SubmixBus> bus);
+
 	/**
 	* Cleans the category erasing all the invalid handles.
 	* Only needed if individual sounds are stopped with their handles.
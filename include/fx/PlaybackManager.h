@@ -121,6 +121,23 @@ public:
 	*/
 	bool setVolume(float volume, unsigned int catKey);
 
+	/**
+	* Retrieves the submix bus of a category.
+	* \param catKey Key of the category.
+	* \return The bus of the category, nullptr if the category doesn't exist or has no bus.
+	*/
+	std::shared_ptr<SubmixBus> getBus(unsigned int catKey);
+
+	/**
+	* Sets the submix bus of a category.
+	* \param bus The bus to mix the sounds of the category into, nullptr for the device output.
+	* \param catKey Key of the category.
+	* \return
+	*        - true if succesful.
+	*        - false if the category doesn't exist.
+	*/
+	bool setBus(std::shared_ptr<SubmixBus> bus, unsigned int catKey);
+
 	/**
 	* Stops and erases a category of sounds.
 	* \param catKey Key of the category.
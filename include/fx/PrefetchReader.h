@@ -0,0 +1,139 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file PrefetchReader.h
+ * @ingroup fx
+ * The PrefetchReader class.
+ */
+
+#include "fx/EffectReader.h"
+#include "util/Buffer.h"
+#include "util/RingBuffer.h"
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+AUD_NAMESPACE_BEGIN
+
+/**
+ * This reader reads another reader ahead in a background thread, so that
+ * slow readers like file decoders don't stall the thread consuming the
+ * samples. The prefetched samples are kept in a ring buffer.
+ */
+class AUD_API PrefetchReader : public EffectReader
+{
+private:
+	/**
+	 * The prefetched samples.
+	 */
+	RingBuffer m_ring;
+
+	/**
+	 * The buffer the prefetching thread reads into.
+	 */
+	Buffer m_buffer;
+
+	/**
+	 * The number of samples the prefetching thread reads at once.
+	 */
+	int m_blockSize;
+
+	/**
+	 * The current position of the consumer in samples.
+	 */
+	int m_position;
+
+	/**
+	 * Whether the prefetching thread reached the end of the stream.
+	 */
+	bool m_eos;
+
+	/**
+	 * Whether the prefetching thread should stop.
+	 */
+	bool m_stop;
+
+	/**
+	 * The exception thrown by a failed read in the prefetching thread.
+	 */
+	std::exception_ptr m_error;
+
+	/**
+	 * The prefetching thread.
+	 */
+	std::thread m_thread;
+
+	/**
+	 * The mutex for the ring buffer and the state flags.
+	 */
+	std::mutex m_mutex;
+
+	/**
+	 * The condition signaled whenever the ring buffer or the state changes.
+	 */
+	std::condition_variable m_condition;
+
+	/**
+	 * The function run by the prefetching thread.
+	 */
+	AUD_LOCAL void prefetch();
+
+	/**
+	 * Starts the prefetching thread.
+	 */
+	AUD_LOCAL void start();
+
+	/**
+	 * Stops the prefetching thread and waits for it.
+	 */
+	AUD_LOCAL void stop();
+
+	// delete copy constructor and operator=
+	PrefetchReader(const PrefetchReader&) = delete;
+	PrefetchReader& operator=(const PrefetchReader&) = delete;
+
+public:
+	/**
+	 * Creates a new prefetch reader and starts prefetching.
+	 * \param reader The reader to read ahead.
+	 * \param size The number of samples to read ahead.
+	 * \param block The number of samples the background thread reads at once.
+	 * \exception Exception Thrown if size or block are not positive.
+	 */
+	PrefetchReader(std::shared_ptr<IReader> reader, int size, int block = 1024);
+
+	/**
+	 * Stops prefetching.
+	 */
+	virtual ~PrefetchReader();
+
+	virtual void seek(int position);
+	virtual int getPosition() const;
+
+	/**
+	 * Reads prefetched samples, waiting for the prefetching thread if needed.
+	 * \exception ... Rethrows the exception of a failed read in the prefetching
+	 *            thread once the samples read before it have been returned.
+	 */
+	virtual void read(int& length, bool& eos, sample_t* buffer);
+};
+
+AUD_NAMESPACE_END
@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file ProfileReader.h
+ * @ingroup fx
+ * The ProfileReader class.
+ */
+
+#include "fx/EffectReader.h"
+#include "IPlanarReader.h"
+#include "util/Buffer.h"
+#include "util/ProfileNode.h"
+
+#include <string>
+
+AUD_NAMESPACE_BEGIN
+
+/**
+ * This reader measures the time, samples and calls of the reads of another
+ * reader and records them in a ProfileNode. It is usually created by
+ * Profiler::createReader().
+ */
+class AUD_API ProfileReader : public EffectReader, public IPlanarReader
+{
+private:
+	/**
+	 * The node the reads are recorded in.
+	 */
+	std::shared_ptr<ProfileNode> m_node;
+
+	/**
+	 * The interleaved buffer for planar reads of readers that don't support them.
+	 */
+	Buffer m_buffer;
+
+	// delete copy constructor and operator=
+	ProfileReader(const ProfileReader&) = delete;
+	ProfileReader& operator=(const ProfileReader&) = delete;
+
+public:
+	/**
+	 * Creates a new profile reader.
+	 * \param reader The reader to profile.
+	 * \param name The name of the node, reads are also aggregated under this
+	 *        name in Profiler::getProfile().
+	 */
+	ProfileReader(std::shared_ptr<IReader> reader, const std::string& name);
+
+	/**
+	 * Returns the profile of the reader.
+	 * \return The node containing the reads of the reader and its profiled
+	 *         input readers as children.
+	 */
+	std::shared_ptr<ProfileNode> getProfile() const;
+
+	/**
+	 * Returns the profiled reader.
+	 * \return The reader whose reads are recorded.
+	 */
+	std::shared_ptr<IReader> getReader() const;
+
+	virtual void read(int& length, bool& eos, sample_t* buffer);
+	virtual void readPlanar(int& length, bool& eos, sample_t* const* buffers);
+};
+
+AUD_NAMESPACE_END
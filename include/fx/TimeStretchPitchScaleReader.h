@@ -25,6 +25,7 @@
 #include "TimeStretchPitchScale.h"
 
 #include "fx/EffectReader.h"
+#include "IPlanarReader.h"
 #include "rubberband/RubberBandStretcher.h"
 #include "util/Buffer.h"
 
@@ -35,29 +36,70 @@ AUD_NAMESPACE_BEGIN
 /**
  * This class reads from another reader and applies time-stretching and pitch scaling.
  */
-class AUD_API TimeStretchPitchScaleReader : public EffectReader
+class AUD_API TimeStretchPitchScaleReader : public EffectReader, public IPlanarReader
 {
 private:
 	/**
-	 * The input buffer for the reader.
+	 * The interleaved input buffer for the reader.
 	 */
 	Buffer m_buffer;
 
 	/**
-	 * The input/output deinterleaved buffers for each channel.
+	 * The planar input buffer, one block per channel.
 	 */
-	std::vector<Buffer> m_deinterleaved;
+	Buffer m_input;
 
 	/**
-	 * The pointers to the input/output deinterleaved buffer data for processing/retrieving.
+	 * The planar output buffer, one block per channel.
 	 */
-	std::vector<sample_t*> m_channelData;
+	Buffer m_output;
+
+	/**
+	 * The pointers to the planar input channels passed to the stretcher.
+	 */
+	std::vector<sample_t*> m_inputData;
+
+	/**
+	 * The pointers to the planar output channels retrieved from the stretcher.
+	 */
+	std::vector<sample_t*> m_outputData;
+
+	/**
+	 * The pointers to the target channels when retrieving without conversion.
+	 */
+	std::vector<sample_t*> m_targetData;
 
 	/**
 	 * Number of samples that need to be dropped at the beginning or after a seek.
 	 */
 	int m_samplesToDrop;
 
+	/**
+	 * Whether the stretcher runs in offline mode.
+	 */
+	bool m_offline;
+
+	/**
+	 * Reads the next block of the input reader into the planar input buffer.
+	 * \param length The maximum number of samples to read, returns the number of samples read.
+	 * \param eos Returns whether the end of the input reader was reached.
+	 */
+	AUD_LOCAL void readInput(int& length, bool& eos);
+
+	/**
+	 * Runs the study pass of the offline stretcher over the rest of the input and seeks the input back.
+	 */
+	AUD_LOCAL void study();
+
+	/**
+	 * Reads stretched samples either interleaved or planar.
+	 * \param length The count of samples to read, returns the count read.
+	 * \param eos Returns whether the end of the stream was reached.
+	 * \param buffer The interleaved buffer to read into, if buffers is nullptr.
+	 * \param buffers The channel buffers to read into or nullptr.
+	 */
+	AUD_LOCAL void readStretched(int& length, bool& eos, sample_t* buffer, sample_t* const* buffers);
+
 	// delete copy constructor and operator=
 	TimeStretchPitchScaleReader(const TimeStretchPitchScaleReader&) = delete;
 	TimeStretchPitchScaleReader& operator=(const TimeStretchPitchScaleReader&) = delete;
@@ -65,6 +107,8 @@ private:
 protected:
 	/**
 	 * Feeds the number of required zero samples to the stretcher and queries the amount of samples to drop.
+	 * In offline mode the expected input duration is set instead, the study pass
+	 * only runs on construction and when the ratios change.
 	 */
 	void reset();
 
@@ -91,10 +135,14 @@ public:
 	 * \param pitchScale The factor by which to adjust the pitch.
 	 * \param quality The processing quality level of the stretcher.
 	 * \param preserveFormant Whether to preserve the vocal formants for the stretcher.
+	 * \param offline Whether to use the offline mode of the stretcher, which studies the whole input
+	 *        before processing and processes the channels in parallel. This is only used if the input
+	 *        reader is seekable and has a known length, otherwise the real-time mode is used.
 	 */
-	TimeStretchPitchScaleReader(std::shared_ptr<IReader> reader, double timeRatio, double pitchScale, StretcherQuality quality, bool preserveFormant);
+	TimeStretchPitchScaleReader(std::shared_ptr<IReader> reader, double timeRatio, double pitchScale, StretcherQuality quality, bool preserveFormant, bool offline = false);
 
 	virtual void read(int& length, bool& eos, sample_t* buffer);
+	virtual void readPlanar(int& length, bool& eos, sample_t* const* buffers);
 
 	virtual void seek(int position);
 	virtual int getLength() const;
@@ -108,6 +156,7 @@ public:
 
 	/**
 	 * Sets the time ratio for the stretcher.
+	 * In offline mode this restarts processing at the current position and studies the remaining input again.
 	 */
 	void setTimeRatio(double timeRatio);
 
@@ -119,8 +168,15 @@ public:
 
 	/**
 	 * Sets the pitch scale for the stretcher.
+	 * In offline mode this restarts processing at the current position and studies the remaining input again.
 	 */
 	void setPitchScale(double pitchScale);
+
+	/**
+	 * Returns whether the stretcher runs in offline mode.
+	 * \return Whether offline mode is used.
+	 */
+	bool isOffline() const;
 };
 
 AUD_NAMESPACE_END
@@ -25,6 +25,8 @@
 #include "fx/EffectReader.h"
 #include "util/Buffer.h"
 
+#include <vector>
+
 AUD_NAMESPACE_BEGIN
 
 /**
@@ -34,11 +36,57 @@ AUD_NAMESPACE_BEGIN
 class AUD_API ChannelMapperReader : public EffectReader
 {
 private:
+	/**
+	 * The kernels the mapping can be applied with.
+	 */
+	enum MappingKernel
+	{
+		KERNEL_IDENTITY,	/// The source is passed through.
+		KERNEL_PERMUTATION,	/// Every target channel copies a source channel or is silent.
+		KERNEL_SPARSE,		/// Every target channel sums a few weighted source channels.
+		KERNEL_DENSE		/// The full matrix is applied with vector instructions.
+	};
+
 	/**
 	 * The sound reading buffer.
 	 */
 	Buffer m_buffer;
 
+	/**
+	 * The kernel used to apply the mapping.
+	 */
+	MappingKernel m_kernel;
+
+	/**
+	 * The source channel of every target channel for the permutation kernel, -1 for silence.
+	 */
+	std::vector<int> m_routes;
+
+	/**
+	 * The start of the entries of every target channel and the end of the last for the sparse kernel.
+	 */
+	std::vector<int> m_sparse_offsets;
+
+	/**
+	 * The source channels of the entries of the sparse kernel.
+	 */
+	std::vector<int> m_sparse_sources;
+
+	/**
+	 * The weights of the entries of the sparse kernel.
+	 */
+	std::vector<float> m_sparse_weights;
+
+	/**
+	 * The columns of the mapping per source channel for the dense kernel, padded to the vector width.
+	 */
+	std::vector<float> m_columns;
+
+	/**
+	 * The padded size of a column of the dense kernel.
+	 */
+	int m_column_size;
+
 	/**
 	 * The output specification.
 	 */
@@ -93,6 +141,11 @@ private:
 	 */
 	void AUD_LOCAL calculateMapping();
 
+	/**
+	 * Chooses the cheapest kernel for the mapping matrix and prepares its data.
+	 */
+	void AUD_LOCAL optimizeMapping();
+
 	/**
 	 * Calculates the distance between two angles.
 	 */
@@ -144,6 +197,22 @@ public:
 	 */
 	void setMonoAngle(float angle);
 
+	/**
+	 * Returns which channel is at a position of a channel layout.
+	 * \param channels The channel layout.
+	 * \param index The position of the channel, in the range [0, channels).
+	 * \return The channel.
+	 */
+	static Channel getChannel(Channels channels, int index);
+
+	/**
+	 * Returns the angle of the speaker of a channel of a channel layout.
+	 * \param channels The channel layout.
+	 * \param index The position of the channel, in the range [0, channels).
+	 * \return The angle in radians, negative angles are on the left.
+	 */
+	static float getChannelAngle(Channels channels, int index);
+
 	virtual Specs getSpecs() const;
 	virtual void read(int& length, bool& eos, sample_t* buffer);
 };
@@ -33,6 +33,11 @@ AUD_NAMESPACE_BEGIN
 class AUD_API Converter : public SpecsChanger
 {
 private:
+	/**
+	 * Whether the converted samples are dithered.
+	 */
+	const bool m_dither;
+
 	// delete copy constructor and operator=
 	Converter(const Converter&) = delete;
 	Converter& operator=(const Converter&) = delete;
@@ -42,8 +47,9 @@ public:
 	 * Creates a new sound.
 	 * \param sound The input sound.
 	 * \param specs The target specifications.
+	 * \param dither Whether 8, 16 and 24 bit samples are dithered instead of truncated.
 	 */
-	Converter(std::shared_ptr<ISound> sound, DeviceSpecs specs);
+	Converter(std::shared_ptr<ISound> sound, DeviceSpecs specs, bool dither = false);
 
 	virtual std::shared_ptr<IReader> createReader();
 };
@@ -20,6 +20,11 @@
  * @file ConverterFunctions.h
  * @ingroup respec
  * Defines several conversion functions between different sample formats.
+ * The conversions from and to FORMAT_FLOAT32 that devices, readers and
+ * writers use most are implemented with vector instructions, which are
+ * selected at runtime for the processor. The dithered conversions add
+ * triangular noise of one least significant bit and round, the others
+ * truncate.
  */
 
 #include "Audaspace.h"
@@ -318,6 +323,38 @@ void AUD_API convert_float_s24_le(data_t* target, data_t* source, int length);
  */
 void AUD_API convert_float_s32(data_t* target, data_t* source, int length);
 
+/**
+ * @brief Converts from FORMAT_FLOAT32 to FORMAT_U8 with TPDF dither.
+ * @param target The target buffer.
+ * @param source The source buffer.
+ * @param length The amount of samples to be converted.
+ */
+void AUD_API convert_float_u8_dither(data_t* target, data_t* source, int length);
+
+/**
+ * @brief Converts from FORMAT_FLOAT32 to FORMAT_S16 with TPDF dither.
+ * @param target The target buffer.
+ * @param source The source buffer.
+ * @param length The amount of samples to be converted.
+ */
+void AUD_API convert_float_s16_dither(data_t* target, data_t* source, int length);
+
+/**
+ * @brief Converts from FORMAT_FLOAT32 to FORMAT_S24 big endian with TPDF dither.
+ * @param target The target buffer.
+ * @param source The source buffer.
+ * @param length The amount of samples to be converted.
+ */
+void AUD_API convert_float_s24_be_dither(data_t* target, data_t* source, int length);
+
+/**
+ * @brief Converts from FORMAT_FLOAT32 to FORMAT_S24 little endian with TPDF dither.
+ * @param target The target buffer.
+ * @param source The source buffer.
+ * @param length The amount of samples to be converted.
+ */
+void AUD_API convert_float_s24_le_dither(data_t* target, data_t* source, int length);
+
 /**
  * @brief Converts from FORMAT_FLOAT32 to FORMAT_FLOAT64.
  * @param target The target buffer.
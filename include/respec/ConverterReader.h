@@ -58,8 +58,9 @@ public:
 	 * Creates a converter reader.
 	 * \param reader The reader to convert.
 	 * \param specs The target specification.
+	 * \param dither Whether 8, 16 and 24 bit samples are dithered instead of truncated.
 	 */
-	ConverterReader(std::shared_ptr<IReader> reader, DeviceSpecs specs);
+	ConverterReader(std::shared_ptr<IReader> reader, DeviceSpecs specs, bool dither = false);
 
 	virtual void read(int& length, bool& eos, sample_t* buffer);
 };
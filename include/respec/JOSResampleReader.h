@@ -131,11 +131,6 @@ private:
 	JOSResampleReader(const JOSResampleReader&) = delete;
 	JOSResampleReader& operator=(const JOSResampleReader&) = delete;
 
-	/**
-	 * Resets the resampler to its initial state.
-	 */
-	void AUD_LOCAL reset();
-
 	/**
 	 * Updates the buffer to be as small as possible for the coming reading.
 	 * \param size The size of samples to be read.
@@ -160,6 +155,7 @@ public:
 	 */
 	JOSResampleReader(std::shared_ptr<IReader> reader, SampleRate rate, ResampleQuality quality = ResampleQuality::HIGH);
 
+	virtual void reset();
 	virtual void seek(int position);
 	virtual int getLength() const;
 	virtual int getPosition() const;
@@ -70,6 +70,7 @@ public:
 	 */
 	LinearResampleReader(std::shared_ptr<IReader> reader, SampleRate rate);
 
+	virtual void reset();
 	virtual void seek(int position);
 	virtual int getLength() const;
 	virtual int getPosition() const;
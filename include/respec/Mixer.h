@@ -64,6 +64,11 @@ protected:
 	 */
 	convert_f m_convert;
 
+	/**
+	 * Whether integer output formats are dithered.
+	 */
+	bool m_dither;
+
 public:
 	/**
 	 * Creates the mixer.
@@ -93,6 +98,20 @@ public:
 	 */
 	void setSpecs(DeviceSpecs specs);
 
+	/**
+	 * Returns whether the conversion to 8, 16 and 24 bit output formats adds
+	 * triangular dither noise instead of truncating.
+	 * \return Whether the output is dithered.
+	 */
+	bool isDithering() const;
+
+	/**
+	 * Sets whether the conversion to 8, 16 and 24 bit output formats adds
+	 * triangular dither noise instead of truncating.
+	 * \param dither Whether to dither the output, the default is false.
+	 */
+	void setDithering(bool dither);
+
 	/**
 	 * Mixes a buffer.
 	 * \param buffer The buffer to superpose.
@@ -119,6 +138,12 @@ public:
 	 */
 	void read(data_t* buffer, float volume);
 
+	/**
+	 * Returns the mixing buffer.
+	 * \return The superposed samples, valid until the next call of clear.
+	 */
+	sample_t* getBuffer();
+
 	/**
 	 * Clears the mixing buffer.
 	 * \param length The length of the buffer in samples.
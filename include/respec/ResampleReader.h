@@ -56,6 +56,14 @@ public:
 	 * \return The target sampling rate.
 	 */
 	virtual SampleRate getRate();
+
+	/**
+	 * Resets the internal state of the resampler, so that reading continues
+	 * at the current position of the source without using cached samples.
+	 * The default implementation seeks to the current source position,
+	 * resamplers can override it to avoid seeking the source.
+	 */
+	virtual void reset();
 };
 
 AUD_NAMESPACE_END
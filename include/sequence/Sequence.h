@@ -162,9 +162,11 @@ public:
 	/**
 	 * Creates a new reader with indicated resampling quality.
 	 * \param quality The resampling quality.
+	 * \param offline Whether the reader is used for offline rendering, which
+	 *        lets the entries' effects use non real-time processing.
 	 * \return The new reader.
 	 */
-	std::shared_ptr<IReader> createQualityReader(ResampleQuality quality);
+	std::shared_ptr<IReader> createQualityReader(ResampleQuality quality, bool offline = false);
 
 	virtual std::shared_ptr<IReader> createReader();
 };
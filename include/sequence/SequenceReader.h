@@ -75,8 +75,9 @@ public:
 	 * Creates a resampling reader.
 	 * \param sequence The sequence data.
 	 * \param quality Resampling quality vs performance option.
+	 * \param offline Whether the reader is used for offline rendering.
 	 */
-	SequenceReader(std::shared_ptr<SequenceData> sequence, ResampleQuality quality = ResampleQuality::FASTEST);
+	SequenceReader(std::shared_ptr<SequenceData> sequence, ResampleQuality quality = ResampleQuality::FASTEST, bool offline = false);
 
 	/**
 	 * Destroys the reader.
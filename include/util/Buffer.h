@@ -24,6 +24,8 @@
 
 #include "Audaspace.h"
 
+#include <functional>
+
 AUD_NAMESPACE_BEGIN
 
 /**
@@ -39,6 +41,12 @@ private:
 	/// The pointer to the buffer memory.
 	data_t* m_buffer;
 
+	/// The memory owned by someone else or nullptr if the buffer owns its memory.
+	sample_t* m_external;
+
+	/// Releases the external memory.
+	std::function<void()> m_release;
+
 	// delete copy constructor and operator=
 	Buffer(const Buffer&) = delete;
 	Buffer& operator=(const Buffer&) = delete;
@@ -50,6 +58,19 @@ public:
 	 */
 	Buffer(long long size = 0);
 
+	/**
+	 * Creates a buffer that uses memory owned by someone else without copying
+	 * it. If the buffer is resized, the data is copied to memory owned by the
+	 * buffer and the external memory is released.
+	 * \param data The memory to use, which has to stay valid until release is
+	 *        called.
+	 * \param size The size of the memory in bytes.
+	 * \param release Called when the buffer doesn't use the memory anymore,
+	 *        which may happen on any thread, for example the mixing thread of
+	 *        a device.
+	 */
+	Buffer(sample_t* data, long long size, std::function<void()> release);
+
 	/**
 	 * Destroys the buffer.
 	 */
@@ -65,6 +65,23 @@ public:
 	 */
 	BufferReader(std::shared_ptr<Buffer> buffer, Specs specs);
 
+	/**
+	 * Exchanges the buffer to read from and rewinds the reader.
+	 * \param buffer The buffer to read from.
+	 * \param specs The specification of the sample data in the buffer.
+	 */
+	void setBuffer(std::shared_ptr<Buffer> buffer, Specs specs);
+
+	/**
+	 * Reads the next samples without copying them out of the buffer.
+	 * \param[in,out] length The count of samples that should be read. Contains
+	 *                the real count of samples available after reading.
+	 * \param[out] eos End of stream, whether the end is reached or not.
+	 * \return A pointer to the samples within the buffer, valid as long as the
+	 *         buffer is not changed.
+	 */
+	sample_t* readDirect(int& length, bool& eos);
+
 	virtual bool isSeekable() const;
 	virtual void seek(int position);
 	virtual int getLength() const;
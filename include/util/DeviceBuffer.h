@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file DeviceBuffer.h
+ * @ingroup util
+ * The DeviceBuffer class.
+ */
+
+#include "ISound.h"
+#include "respec/Specification.h"
+
+#include <future>
+#include <mutex>
+
+AUD_NAMESPACE_BEGIN
+
+class StreamBuffer;
+class ThreadPool;
+
+/**
+ * This sound holds a sound in memory together with a copy that is already
+ * converted to the specification of a device.
+ *
+ * The conversion uses high quality resampling and is done once, optionally
+ * on a thread pool, so that playback of the converted copy needs neither
+ * resampling nor channel mapping. Until the conversion is finished the
+ * original data is played back. Mono sounds keep their channel count, since
+ * devices pan them in 3D.
+ *
+ * Register the sound with SoftwareDevice::addDeviceBuffer to have it converted
+ * again whenever the device specification changes.
+ */
+class AUD_API DeviceBuffer : public ISound
+{
+private:
+	/**
+	 * The sound data in its original specification.
+	 */
+	std::shared_ptr<StreamBuffer> m_buffer;
+
+	/**
+	 * The sound data converted to the target specification.
+	 */
+	std::shared_ptr<StreamBuffer> m_converted;
+
+	/**
+	 * The pending conversion.
+	 */
+	std::future<std::shared_ptr<StreamBuffer>> m_conversion;
+
+	/**
+	 * The thread pool for the conversion.
+	 */
+	std::shared_ptr<ThreadPool> m_threadPool;
+
+	/**
+	 * The target specification.
+	 */
+	Specs m_specs;
+
+	/**
+	 * The resampling quality of the conversion.
+	 */
+	ResampleQuality m_quality;
+
+	/**
+	 * The number of setSpecs calls, so that the result of a superseded
+	 * synchronous conversion is discarded.
+	 */
+	unsigned int m_generation;
+
+	/**
+	 * The mutex for the converted data.
+	 */
+	std::mutex m_mutex;
+
+	// delete copy constructor and operator=
+	DeviceBuffer(const DeviceBuffer&) = delete;
+	DeviceBuffer& operator=(const DeviceBuffer&) = delete;
+
+	/**
+	 * Converts a buffer to a specification.
+	 * \param buffer The buffer to convert.
+	 * \param specs The target specification.
+	 * \param quality The resampling quality.
+	 * \return The converted buffer.
+	 */
+	static std::shared_ptr<StreamBuffer> AUD_LOCAL convert(std::shared_ptr<StreamBuffer> buffer, Specs specs, ResampleQuality quality);
+
+	/**
+	 * Returns the converted data if available, has to be called locked.
+	 * \return The converted data or nullptr if the conversion is pending.
+	 */
+	std::shared_ptr<StreamBuffer> AUD_LOCAL getConverted();
+
+public:
+	/**
+	 * Creates the sound and loads the sound supplied into memory.
+	 * \param sound The sound to buffer. If it is a StreamBuffer, its data is
+	 *        used directly.
+	 * \param threadPool The thread pool to convert the data on. If nullptr,
+	 *        the conversion is done synchronously in setSpecs.
+	 * \param quality The resampling quality of the conversion.
+	 * \exception Exception Thrown if the reader cannot be created.
+	 */
+	DeviceBuffer(std::shared_ptr<ISound> sound, std::shared_ptr<ThreadPool> threadPool = nullptr, ResampleQuality quality = ResampleQuality::HIGH);
+
+	/**
+	 * Returns the sound data in its original specification.
+	 * \return The original data.
+	 */
+	std::shared_ptr<StreamBuffer> getBuffer();
+
+	/**
+	 * Returns the target specification.
+	 * \return The target specification, the original specification if none
+	 *         has been set.
+	 */
+	Specs getSpecs();
+
+	/**
+	 * Sets the target specification and starts the conversion.
+	 * Without a thread pool the conversion is done synchronously and the
+	 * previous data is played back until it succeeded. If the conversion
+	 * fails, the specification stays unchanged and the exception is thrown.
+	 * If another call changes the specification while converting, the
+	 * result of the earlier call is discarded.
+	 * With a thread pool, the original data is played back while the
+	 * conversion is pending and if it fails.
+	 * \param specs The target specification.
+	 * \exception Exception Thrown if the synchronous conversion fails.
+	 */
+	void setSpecs(Specs specs);
+
+	/**
+	 * Returns whether the data converted to the target specification is
+	 * available.
+	 * \return Whether the conversion has finished.
+	 */
+	bool isConverted();
+
+	/**
+	 * Returns the data that is played back.
+	 * \return The converted data if available, otherwise the original data.
+	 */
+	std::shared_ptr<StreamBuffer> getCurrentBuffer();
+
+	virtual std::shared_ptr<IReader> createReader();
+};
+
+AUD_NAMESPACE_END
@@ -23,10 +23,20 @@
 */
 
 #include <complex>
-#include <fftw3.h>
 #include "Audaspace.h"
 
+#ifdef WITH_BUILTIN_FFT
+/**Complex number in the memory layout used by FFTW, used by the built-in FFT as well.*/
+typedef float fftwf_complex[2];
+#else
+#include <fftw3.h>
+#endif
+
+#include <future>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 /**Default FFT size.*/
@@ -45,6 +55,17 @@ private:
 	*/
 	int m_N;
 
+#ifdef WITH_BUILTIN_FFT
+	/**
+	* The twiddle factors of the radix-4 stages of the complex FFT of size N/2.
+	*/
+	std::vector<float> m_twiddles;
+
+	/**
+	* The twiddle factors to split the complex FFT into the real FFT.
+	*/
+	std::vector<float> m_realTwiddles;
+#else
 	/**
 	* The plan to transform the input to the frequency domain.
 	*/
@@ -54,16 +75,42 @@ private:
 	* The plan to transform the input to the time domain again.
 	*/
 	fftwf_plan m_fftPlanC2R;
+#endif
 
 	/**
 	* The size of a buffer for its use with the FFT plan (in bytes).
 	*/
 	unsigned int m_bufferSize;
 
+	/**
+	* The cache of plans, indexed by size and measure time.
+	*/
+	static std::map<std::pair<int, double>, std::shared_future<std::shared_ptr<FFTPlan>>> m_plans;
+
+	/**
+	* Protects the cache of plans and the wisdom file name.
+	*/
+	static std::mutex m_cacheMutex;
+
+	/**
+	* FFTW's planner isn't thread safe, so all planner calls are serialized.
+	*/
+	static std::mutex m_plannerMutex;
+
+	/**
+	* The file the wisdom is stored in.
+	*/
+	static std::string m_wisdomFile;
+
 	// delete copy constructor and operator=
 	FFTPlan(const FFTPlan&) = delete;
 	FFTPlan& operator=(const FFTPlan&) = delete;
 
+	/**
+	* Stores the wisdom in the wisdom file if one is set.
+	*/
+	static void AUD_LOCAL saveWisdom();
+
 public:
 	/**
 	* Creates a new FFTPlan object with DEFAULT_N size (4096).
@@ -74,7 +121,7 @@ public:
 
 	/**
 	* Creates a new FFTPlan object with a custom size.
-	* \param n The size of the FFT plan. Values that are a power of two are faster. 
+	* \param n The size of the FFT plan. Values that are a power of two are faster, the built-in FFT only supports powers of two. 
 	*		The useful range usually is between 2048 and 8192, but bigger values can be useful
 	*		in certain situations (when using the StreamBuffer class per example). 
 	*		Generally, low values use more CPU power and are a bit faster than large ones, 
@@ -115,6 +162,56 @@ public:
 	* \param buffer A pointer to the buufer taht must be freed.
 	*/
 	void freeBuffer(void* buffer);
+
+	/**
+	* Retrieves a shared plan from the process wide cache, creating it if it doesn't exist yet.
+	* The plan is created on the calling thread, if another thread is already creating it the call waits for it.
+	* \param n The size of the FFT plan.
+	* \param measureTime The aproximate amount of seconds that FFTW will spend searching for the optimal plan.
+	* \return The shared plan.
+	*/
+	static std::shared_ptr<FFTPlan> get(int n = DEFAULT_N, double measureTime = 0);
+
+	/**
+	* Retrieves a shared plan from the process wide cache, creating it on a separate thread if it doesn't exist yet.
+	* \param n The size of the FFT plan.
+	* \param measureTime The aproximate amount of seconds that FFTW will spend searching for the optimal plan.
+	* \return A future that becomes ready as soon as the plan has been created.
+	*/
+	static std::shared_future<std::shared_ptr<FFTPlan>> getAsync(int n = DEFAULT_N, double measureTime = 0);
+
+	/**
+	* Removes all plans from the cache. Plans still in use stay valid.
+	*/
+	static void clearCache();
+
+	/**
+	* Sets the file that FFTW wisdom is read from and stored to.
+	* The wisdom in the file is imported immediately and the file is updated every time the cache creates a new plan.
+	* \param filename The path of the file or an empty string to stop storing wisdom.
+	* \return Whether the wisdom could be imported from the file.
+	*/
+	static bool setWisdomFile(const std::string& filename);
+
+	/**
+	* Retrieves the file that FFTW wisdom is stored to.
+	* \return The path of the file or an empty string if none is set.
+	*/
+	static std::string getWisdomFile();
+
+	/**
+	* Imports FFTW wisdom from a file.
+	* \param filename The path of the file.
+	* \return Whether the wisdom could be imported, always false for the built-in FFT.
+	*/
+	static bool importWisdom(const std::string& filename);
+
+	/**
+	* Exports the accumulated FFTW wisdom to a file.
+	* \param filename The path of the file.
+	* \return Whether the wisdom could be exported, always false for the built-in FFT.
+	*/
+	static bool exportWisdom(const std::string& filename);
 };
 
 AUD_NAMESPACE_END
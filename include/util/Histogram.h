@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file Histogram.h
+ * @ingroup util
+ * The Histogram class.
+ */
+
+#include "Audaspace.h"
+
+#include <atomic>
+#include <cstdint>
+
+AUD_NAMESPACE_BEGIN
+
+/**
+ * This class counts values in logarithmic bins with four bins per power of
+ * two, so that percentiles are accurate to 25 %. Adding values is lock-free
+ * and can be done from a realtime thread while other threads read.
+ */
+class AUD_API Histogram
+{
+public:
+	/**
+	 * The number of bins.
+	 */
+	static constexpr int BINS = 256;
+
+private:
+	/**
+	 * The value counts per bin.
+	 */
+	std::atomic<uint64_t> m_bins[BINS];
+
+	/**
+	 * The number of values.
+	 */
+	std::atomic<uint64_t> m_count;
+
+	/**
+	 * The sum of all values.
+	 */
+	std::atomic<uint64_t> m_sum;
+
+	/**
+	 * The smallest value.
+	 */
+	std::atomic<uint64_t> m_min;
+
+	/**
+	 * The largest value.
+	 */
+	std::atomic<uint64_t> m_max;
+
+	// delete copy constructor and operator=
+	Histogram(const Histogram&) = delete;
+	Histogram& operator=(const Histogram&) = delete;
+
+public:
+	/**
+	 * Creates an empty histogram.
+	 */
+	Histogram();
+
+	/**
+	 * Adds a value.
+	 * \param value The value to add.
+	 */
+	void add(uint64_t value);
+
+	/**
+	 * Removes all values.
+	 */
+	void reset();
+
+	/**
+	 * Returns the number of values.
+	 * \return The value count.
+	 */
+	uint64_t getCount() const;
+
+	/**
+	 * Returns the mean of the values.
+	 * \return The mean or 0 if there are no values.
+	 */
+	double getMean() const;
+
+	/**
+	 * Returns the smallest value.
+	 * \return The minimum or 0 if there are no values.
+	 */
+	uint64_t getMinimum() const;
+
+	/**
+	 * Returns the largest value.
+	 * \return The maximum or 0 if there are no values.
+	 */
+	uint64_t getMaximum() const;
+
+	/**
+	 * Returns an estimate of a percentile of the values.
+	 * \param percentile The percentile between 0 and 1.
+	 * \return The upper bound of the bin that contains the percentile, limited
+	 *         to the maximum value, or 0 if there are no values.
+	 */
+	uint64_t getPercentile(double percentile) const;
+
+	/**
+	 * Returns the bin of a value.
+	 * \param value The value.
+	 * \return The index of the bin counting the value.
+	 */
+	static int getBin(uint64_t value);
+
+	/**
+	 * Returns the smallest value of a bin.
+	 * \param bin The index of the bin.
+	 * \return The lower bound of the bin.
+	 */
+	static uint64_t getBinStart(int bin);
+
+	/**
+	 * Returns the number of values in a bin.
+	 * \param bin The index of the bin.
+	 * \return The value count of the bin.
+	 */
+	uint64_t getBinCount(int bin) const;
+};
+
+AUD_NAMESPACE_END
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file OfflineRender.h
+ * @ingroup util
+ * The OfflineRender class.
+ */
+
+#include "Audaspace.h"
+
+AUD_NAMESPACE_BEGIN
+
+/**
+ * This class marks the readers created on the current thread during its
+ * lifetime as being used for offline rendering, for example during a mixdown.
+ *
+ * Sounds can query isActive() in their createReader() method to choose an
+ * implementation that trades latency for quality, since the reader will not be
+ * read from a real-time audio callback. Scopes can be nested.
+ */
+class AUD_API OfflineRender
+{
+private:
+	/**
+	 * Whether this scope enabled offline rendering.
+	 */
+	bool m_active;
+
+	// delete copy constructor and operator=
+	OfflineRender(const OfflineRender&) = delete;
+	OfflineRender& operator=(const OfflineRender&) = delete;
+
+public:
+	/**
+	 * Enters an offline rendering scope on the current thread.
+	 * \param active Whether to actually enable offline rendering, so that
+	 *        callers can create the scope unconditionally.
+	 */
+	OfflineRender(bool active = true);
+
+	/**
+	 * Leaves the offline rendering scope.
+	 */
+	~OfflineRender();
+
+	/**
+	 * Returns whether readers are currently created for offline rendering on
+	 * the calling thread.
+	 * \return Whether an offline rendering scope is active.
+	 */
+	static bool isActive();
+};
+
+AUD_NAMESPACE_END
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file PlanarBuffer.h
+ * @ingroup util
+ * The PlanarBuffer class.
+ */
+
+#include "util/Buffer.h"
+
+#include <vector>
+
+AUD_NAMESPACE_BEGIN
+
+class IReader;
+
+/**
+ * This class holds non-interleaved samples, one contiguous block per channel.
+ * It also provides the conversions between the interleaved and the planar
+ * layout used at the boundaries of planar reader chains.
+ */
+class AUD_API PlanarBuffer
+{
+private:
+	/**
+	 * The buffer holding the samples of all channels.
+	 */
+	Buffer m_buffer;
+
+	/**
+	 * The interleaved buffer used to read from readers without planar support.
+	 */
+	Buffer m_interleaved;
+
+	/**
+	 * The pointers to the channels.
+	 */
+	std::vector<sample_t*> m_channels;
+
+	/**
+	 * The number of samples per channel.
+	 */
+	int m_length;
+
+	// delete copy constructor and operator=
+	PlanarBuffer(const PlanarBuffer&) = delete;
+	PlanarBuffer& operator=(const PlanarBuffer&) = delete;
+
+public:
+	/**
+	 * Creates a new planar buffer.
+	 * \param length The number of samples per channel.
+	 * \param channels The number of channels.
+	 */
+	PlanarBuffer(int length = 0, int channels = 0);
+
+	/**
+	 * Returns the pointers to the channels.
+	 * \return One pointer per channel.
+	 */
+	sample_t* const* getChannels() const;
+
+	/**
+	 * Returns a single channel.
+	 * \param channel The index of the channel.
+	 * \return The pointer to the samples of the channel.
+	 */
+	sample_t* getChannel(int channel) const;
+
+	/**
+	 * Returns the number of channels.
+	 */
+	int getChannelCount() const;
+
+	/**
+	 * Returns the number of samples per channel.
+	 */
+	int getLength() const;
+
+	/**
+	 * Makes sure the buffer holds at least the given amount of samples per
+	 * channel and exactly the given amount of channels.
+	 * \param length The number of samples per channel.
+	 * \param channels The number of channels.
+	 * \note The content is lost if the buffer has to grow.
+	 */
+	void assureSize(int length, int channels);
+
+	/**
+	 * Reads from a reader into the buffer. The buffer is resized to the
+	 * channels of the reader if necessary.
+	 * \param reader The reader to read from.
+	 * \param[in,out] length The count of samples to read, returns the count read.
+	 * \param[out] eos Whether the end of the reader was reached.
+	 */
+	void read(IReader& reader, int& length, bool& eos);
+
+	/**
+	 * Reads from a reader into separate channels. Readers that implement
+	 * IPlanarReader are read directly, all others are read into the
+	 * interleaved buffer and converted.
+	 * \param reader The reader to read from.
+	 * \param[in,out] length The count of samples to read, returns the count read.
+	 * \param[out] eos Whether the end of the reader was reached.
+	 * \param buffers One pointer per channel of the reader, each large enough for length samples.
+	 * \param interleaved The buffer for the interleaved samples, only used if
+	 *        the reader does not support planar reading.
+	 */
+	static void read(IReader& reader, int& length, bool& eos, sample_t* const* buffers, Buffer& interleaved);
+
+	/**
+	 * Splits interleaved samples into separate channels.
+	 * \param source The interleaved samples.
+	 * \param buffers One pointer per channel.
+	 * \param length The number of samples per channel.
+	 * \param channels The number of channels.
+	 */
+	static void deinterleave(const sample_t* source, sample_t* const* buffers, int length, int channels);
+
+	/**
+	 * Joins separate channels into interleaved samples.
+	 * \param buffers One pointer per channel.
+	 * \param target The buffer for the interleaved samples.
+	 * \param length The number of samples per channel.
+	 * \param channels The number of channels.
+	 */
+	static void interleave(const sample_t* const* buffers, sample_t* target, int length, int channels);
+};
+
+AUD_NAMESPACE_END
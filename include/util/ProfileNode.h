@@ -0,0 +1,168 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file ProfileNode.h
+ * @ingroup util
+ * The ProfileNode class.
+ */
+
+#include "Audaspace.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+AUD_NAMESPACE_BEGIN
+
+/**
+ * This class accumulates the processing time of one node of a reader graph.
+ *
+ * Nodes are either created per reader by a ProfileReader, in which case they
+ * form a tree that mirrors the reader graph of a handle, or per sound type by
+ * the Profiler, in which case they aggregate all readers of that type.
+ * Recording is lock-free, so nodes can be updated from the mixing thread while
+ * others read them.
+ */
+class AUD_API ProfileNode
+{
+private:
+	/**
+	 * The name of the node, usually the type of the sound or reader.
+	 */
+	const std::string m_name;
+
+	/**
+	 * The node that aggregates all nodes of the same type or nullptr.
+	 */
+	std::shared_ptr<ProfileNode> m_type;
+
+	/**
+	 * The number of reads.
+	 */
+	std::atomic<uint64_t> m_calls;
+
+	/**
+	 * The number of samples produced.
+	 */
+	std::atomic<uint64_t> m_samples;
+
+	/**
+	 * The time spent in reads including the children in nanoseconds.
+	 */
+	std::atomic<uint64_t> m_time;
+
+	/**
+	 * The time spent in reads excluding the children in nanoseconds.
+	 */
+	std::atomic<uint64_t> m_selfTime;
+
+	/**
+	 * Whether the node has been added to a parent.
+	 */
+	std::atomic<bool> m_linked;
+
+	/**
+	 * The child nodes that have been read from this node.
+	 */
+	std::vector<std::shared_ptr<ProfileNode>> m_children;
+
+	/**
+	 * Protects the child nodes.
+	 */
+	mutable std::mutex m_mutex;
+
+	// delete copy constructor and operator=
+	ProfileNode(const ProfileNode&) = delete;
+	ProfileNode& operator=(const ProfileNode&) = delete;
+
+public:
+	/**
+	 * Creates a new profile node.
+	 * \param name The name of the node.
+	 * \param type The node aggregating all nodes of this type or nullptr.
+	 */
+	ProfileNode(const std::string& name, std::shared_ptr<ProfileNode> type = nullptr);
+
+	/**
+	 * Records a read of the node, which is also added to the type node.
+	 * \param samples The number of samples produced.
+	 * \param time The time of the read including children in nanoseconds.
+	 * \param selfTime The time of the read excluding children in nanoseconds.
+	 */
+	void record(uint64_t samples, uint64_t time, uint64_t selfTime);
+
+	/**
+	 * Adds a child node unless the child already has a parent or this node
+	 * aggregates a type, since type nodes have no children.
+	 * \param child The node that was read from this node.
+	 */
+	void link(const std::shared_ptr<ProfileNode>& child);
+
+	/**
+	 * Clears the recorded values of this node and all of its children.
+	 */
+	void reset();
+
+	/**
+	 * Returns the name of the node.
+	 * \return The name of the node.
+	 */
+	const std::string& getName() const;
+
+	/**
+	 * Returns the node that aggregates all nodes of the same type.
+	 * \return The type node or nullptr if this is a type node.
+	 */
+	std::shared_ptr<ProfileNode> getType() const;
+
+	/**
+	 * Returns the number of reads.
+	 * \return The number of reads.
+	 */
+	uint64_t getCalls() const;
+
+	/**
+	 * Returns the number of samples produced.
+	 * \return The number of samples.
+	 */
+	uint64_t getSamples() const;
+
+	/**
+	 * Returns the time spent in the node including its children.
+	 * \return The time in seconds.
+	 */
+	double getTime() const;
+
+	/**
+	 * Returns the time spent in the node excluding its children.
+	 * \return The time in seconds.
+	 */
+	double getSelfTime() const;
+
+	/**
+	 * Returns the child nodes.
+	 * \return The nodes that were read from this node.
+	 */
+	std::vector<std::shared_ptr<ProfileNode>> getChildren() const;
+};
+
+AUD_NAMESPACE_END
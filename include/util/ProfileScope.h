@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file ProfileScope.h
+ * @ingroup util
+ * The ProfileScope class.
+ */
+
+#include "util/Profiler.h"
+
+AUD_NAMESPACE_BEGIN
+
+/**
+ * This class measures the time of a read of a profiled node during its
+ * lifetime.
+ *
+ * Scopes nest per thread: the time of a scope is subtracted from the self time
+ * of the enclosing scope and its node is added as a child to the node of the
+ * enclosing scope, so that the nodes form the reader graph.
+ */
+class AUD_API ProfileScope
+{
+private:
+	/**
+	 * The node that is read.
+	 */
+	const std::shared_ptr<ProfileNode>& m_node;
+
+	/**
+	 * Whether this scope records the read.
+	 */
+	bool m_active;
+
+	/**
+	 * The enclosing scope on this thread.
+	 */
+	ProfileScope* m_parent;
+
+	/**
+	 * The time the scope was entered.
+	 */
+	Profiler::Clock::time_point m_start;
+
+	/**
+	 * The time spent in nested scopes in nanoseconds.
+	 */
+	uint64_t m_childTime;
+
+	/**
+	 * The number of samples produced.
+	 */
+	int m_samples;
+
+	// delete copy constructor and operator=
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+public:
+	/**
+	 * Enters a profiling scope on the current thread.
+	 * \param node The node to record the read in, which must outlive the
+	 *        scope. If it is nullptr, the scope does nothing.
+	 * \param active Whether to actually record the read, so that callers can
+	 *        create the scope unconditionally.
+	 */
+	ProfileScope(const std::shared_ptr<ProfileNode>& node, bool active = true);
+
+	/**
+	 * Leaves the profiling scope and records the read.
+	 */
+	~ProfileScope();
+
+	/**
+	 * Sets the number of samples the read produced.
+	 * \param samples The number of samples.
+	 */
+	void setSamples(int samples);
+};
+
+AUD_NAMESPACE_END
@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file Profiler.h
+ * @ingroup util
+ * The Profiler class.
+ */
+
+#include "util/ProfileNode.h"
+
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+AUD_NAMESPACE_BEGIN
+
+class IReader;
+class ISound;
+
+/**
+ * This class controls the profiling of reader graphs.
+ *
+ * While profiling is enabled, readers created through createReader() are
+ * wrapped in a ProfileReader, which accumulates the time, samples and calls of
+ * every node of the graph and of all nodes of the same sound type. Readers
+ * created while profiling is disabled are not affected, so profiling costs
+ * nothing unless it was enabled before the sounds were played.
+ *
+ * Additionally a trace of all profiled reads can be recorded and exported in
+ * the Chrome trace event format for chrome://tracing or Perfetto.
+ */
+class AUD_API Profiler
+{
+public:
+	/**
+	 * The clock used for profiling.
+	 */
+	typedef std::chrono::steady_clock Clock;
+
+private:
+	// delete constructor, copy constructor and operator=
+	Profiler() = delete;
+	Profiler(const Profiler&) = delete;
+	Profiler& operator=(const Profiler&) = delete;
+
+public:
+	/**
+	 * Enables or disables the profiling of newly created readers.
+	 * \param enabled Whether to profile readers.
+	 */
+	static void setEnabled(bool enabled);
+
+	/**
+	 * Returns whether newly created readers are profiled.
+	 * \return Whether profiling is enabled.
+	 */
+	static bool isEnabled();
+
+	/**
+	 * Creates a reader out of a sound, which is profiled if profiling is enabled.
+	 * Sounds should use this to create the readers of their input sounds.
+	 * \param sound The sound to create the reader of.
+	 * \return The reader, wrapped in a ProfileReader if profiling is enabled.
+	 * \exception Exception Thrown if the sound cannot create a reader.
+	 */
+	static std::shared_ptr<IReader> createReader(std::shared_ptr<ISound> sound);
+
+	/**
+	 * Returns the node that aggregates all nodes of a type.
+	 * \param name The name of the type.
+	 * \return The aggregating node, which exists until the library is unloaded.
+	 */
+	static std::shared_ptr<ProfileNode> getTypeNode(const std::string& name);
+
+	/**
+	 * Returns a readable name of a type without namespaces.
+	 * \param type The type.
+	 * \return The name of the type.
+	 */
+	static std::string getTypeName(const std::type_info& type);
+
+	/**
+	 * Returns the profile aggregated by sound type.
+	 * \return One node per type that has been profiled.
+	 */
+	static std::vector<std::shared_ptr<ProfileNode>> getProfile();
+
+	/**
+	 * Clears the profile aggregated by sound type.
+	 */
+	static void reset();
+
+	/**
+	 * Starts recording a trace of all profiled reads, discarding the previous trace.
+	 * \param events The maximum number of reads to record, later reads are dropped.
+	 */
+	static void startTrace(int events = 65536);
+
+	/**
+	 * Stops recording the trace, which is kept until the next start.
+	 */
+	static void stopTrace();
+
+	/**
+	 * Returns whether a trace is recorded.
+	 * \return Whether the trace is recorded.
+	 */
+	static bool isTracing();
+
+	/**
+	 * Adds a read to the trace if a trace is recorded.
+	 * \param node The node that was read.
+	 * \param start The time the read started.
+	 * \param end The time the read ended.
+	 */
+	static void trace(const ProfileNode& node, Clock::time_point start, Clock::time_point end);
+
+	/**
+	 * Writes the recorded trace as Chrome trace event JSON.
+	 * \param stream The stream to write to.
+	 */
+	static void writeTrace(std::ostream& stream);
+};
+
+AUD_NAMESPACE_END
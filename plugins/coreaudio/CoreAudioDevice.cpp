@@ -32,6 +32,8 @@ OSStatus CoreAudioDevice::CoreAudio_mix(void* data, AudioUnitRenderActionFlags*
 	{
 		auto& buffer = buffer_list->mBuffers[i];
 
+		device->recordRingBufferCallback(buffer.mDataByteSize / sample_size);
+
 		size_t readsamples = device->getRingBuffer().getReadSize();
 
 		size_t num_bytes = size_t(buffer.mDataByteSize);
@@ -46,8 +46,13 @@ int JackDevice::jack_mix(jack_nframes_t length, void* data)
 		if((state == JackTransportRolling) && (device->m_lastMixState != JackTransportRolling))
 			++device->m_rollingSyncRevision;
 
+		if(device->isDirectMixing())
+			device->mixDirect(length);
+
 		size_t sample_size = AUD_DEVICE_SAMPLE_SIZE(device->m_specs);
 
+		device->recordRingBufferCallback(length);
+
 		size_t readsamples = device->getRingBuffer().getReadSize();
 
 		readsamples = std::min(readsamples / sample_size, static_cast<size_t>(length));
@@ -79,7 +84,9 @@ int JackDevice::jack_mix(jack_nframes_t length, void* data)
 			}
 		}
 
-		device->notifyMixingThread();
+		// when mixing directly the thread only needs to run for synchronisation, mixDirect() wakes it to refill the reserve
+		if(!device->isDirectMixing() || (device->m_syncCallRevision != device->m_lastSyncCallRevision) || (state == JackTransportStopped && device->m_lastMixState != JackTransportStopped))
+			device->notifyMixingThread();
 	}
 
 	device->m_lastMixState = state;
@@ -147,7 +154,7 @@ void JackDevice::jack_shutdown(void* data)
 	device->stopMixingThread();
 }
 
-JackDevice::JackDevice(const std::string& name, DeviceSpecs specs, int buffersize)
+JackDevice::JackDevice(const std::string& name, DeviceSpecs specs, int buffersize, bool direct)
 {
 	if(specs.channels == CHANNELS_INVALID)
 		specs.channels = CHANNELS_STEREO;
@@ -192,10 +199,14 @@ JackDevice::JackDevice(const std::string& name, DeviceSpecs specs, int buffersiz
 
 	m_specs.rate = (SampleRate)AUD_jack_get_sample_rate(m_client);
 
-	if(buffersize < 0)
+	// when mixing directly the ring buffer holds the period and the reserve for up to twice the current period
+	if(direct)
+		buffersize = AUD_jack_get_buffer_size(m_client) * 4;
+	else if(buffersize < 0)
 		buffersize = AUD_jack_get_buffer_size(m_client) * 2;
 
 	buffersize *= AUD_SAMPLE_SIZE(m_specs);
+
 	m_deinterleavebuf.resize(buffersize);
 
 	create();
@@ -229,7 +240,7 @@ JackDevice::JackDevice(const std::string& name, DeviceSpecs specs, int buffersiz
 		AUD_jack_free(ports);
 	}
 
-	startMixingThread(buffersize);
+	startMixingThread(buffersize, direct);
 }
 
 JackDevice::~JackDevice()
@@ -250,6 +261,14 @@ void JackDevice::playing(bool playing)
 	MixingThreadDevice::playing(playing);
 }
 
+double JackDevice::getLatency()
+{
+	jack_latency_range_t range;
+	AUD_jack_port_get_latency_range(m_ports[0], JackPlaybackLatency, &range);
+
+	return MixingThreadDevice::getLatency() + range.max / double(m_specs.rate);
+}
+
 void JackDevice::playSynchronizer()
 {
 	AUD_jack_transport_start(m_client);
@@ -308,7 +327,7 @@ public:
 
 	virtual std::shared_ptr<IDevice> openDevice()
 	{
-		return std::shared_ptr<IDevice>(new JackDevice(m_name, m_specs, m_buffersize));
+		return std::shared_ptr<IDevice>(new JackDevice(m_name, m_specs, m_buffersize, m_buffersize == 0));
 	}
 
 	virtual int getPriority()
@@ -138,15 +138,21 @@ public:
 	 * \param specs The wanted audio specification, where only the channel count
 	 *              is important.
 	 * \param buffersize The size of the internal buffer.
+	 * \param direct Whether to mix directly in the process callback instead of
+	 *               a separate thread, which reduces the latency of the internal
+	 *               buffer to one period. The callback never waits for the
+	 *               device lock and plays that period of reserve if it is taken.
 	 * \exception Exception Thrown if the audio device cannot be opened.
 	 */
-	JackDevice(const std::string &name, DeviceSpecs specs, int buffersize = AUD_DEFAULT_BUFFER_SIZE);
+	JackDevice(const std::string &name, DeviceSpecs specs, int buffersize = AUD_DEFAULT_BUFFER_SIZE, bool direct = false);
 
 	/**
 	 * Closes the JACK client.
 	 */
 	virtual ~JackDevice();
 
+	virtual double getLatency();
+
 	/**
 	 * Starts jack transport playback.
 	 */
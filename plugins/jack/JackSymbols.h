@@ -32,6 +32,7 @@ JACK_SYMBOL(jack_ringbuffer_read_space);
 JACK_SYMBOL(jack_set_sync_callback);
 
 JACK_SYMBOL(jack_port_get_buffer);
+JACK_SYMBOL(jack_port_get_latency_range);
 
 JACK_SYMBOL(jack_client_open);
 JACK_SYMBOL(jack_set_process_callback);
@@ -69,6 +69,11 @@ void PipeWireDevice::mixAudioBuffer(void* device_ptr)
 		n_frames = SPA_MIN(pw_buf->requested, n_frames);
 	}
 
+	if(device->isDirectMixing())
+		device->mixDirect(n_frames);
+
+	device->recordRingBufferCallback(n_frames);
+
 	size_t readsamples = device->getRingBuffer().getReadSize() / chunk->stride;
 
 	if(readsamples < n_frames)
@@ -78,7 +83,10 @@ void PipeWireDevice::mixAudioBuffer(void* device_ptr)
 
 	device->getRingBuffer().read(reinterpret_cast<data_t*>(spa_data.data), chunk->size);
 
-	device->notifyMixingThread();
+	// when mixing directly the thread is only woken if the reserve has to be refilled
+	if(!device->isDirectMixing())
+		device->notifyMixingThread();
+
 	AUD_pw_stream_queue_buffer(device->m_stream, pw_buf);
 }
 
@@ -111,7 +119,7 @@ void PipeWireDevice::playing(bool playing)
 	}
 }
 
-PipeWireDevice::PipeWireDevice(const std::string& name, DeviceSpecs specs, int buffersize)
+PipeWireDevice::PipeWireDevice(const std::string& name, DeviceSpecs specs, int buffersize, bool direct)
 {
 	if(specs.channels == CHANNELS_INVALID)
 		specs.channels = CHANNELS_STEREO;
@@ -163,7 +171,8 @@ PipeWireDevice::PipeWireDevice(const std::string& name, DeviceSpecs specs, int b
 
 	/* Set the requested sample rate and latency. */
 	AUD_pw_properties_setf(stream_props, PW_KEY_NODE_RATE, "1/%u", uint(m_specs.rate));
-	AUD_pw_properties_setf(stream_props, PW_KEY_NODE_LATENCY, "%u/%u", buffersize, uint(m_specs.rate));
+	if(buffersize > 0)
+		AUD_pw_properties_setf(stream_props, PW_KEY_NODE_LATENCY, "%u/%u", buffersize, uint(m_specs.rate));
 
 	m_stream = AUD_pw_stream_new_simple(AUD_pw_thread_loop_get_loop(m_thread), name.c_str(), stream_props, m_events.get(), this);
 	if(!m_stream)
@@ -187,7 +196,11 @@ PipeWireDevice::PipeWireDevice(const std::string& name, DeviceSpecs specs, int b
 
 	create();
 
-	startMixingThread(buffersize * 2 * AUD_DEVICE_SAMPLE_SIZE(m_specs));
+	// when mixing directly the ring buffer holds the period and the reserve for up to twice the expected period
+	if(direct)
+		buffersize = (buffersize > 0 ? buffersize : AUD_DEFAULT_BUFFER_SIZE) * 2;
+
+	startMixingThread(buffersize * 2 * AUD_DEVICE_SAMPLE_SIZE(m_specs), direct);
 }
 
 PipeWireDevice::~PipeWireDevice()
@@ -204,6 +217,20 @@ PipeWireDevice::~PipeWireDevice()
 	AUD_pw_deinit();
 }
 
+double PipeWireDevice::getLatency()
+{
+	pw_time tm;
+	AUD_pw_stream_get_time_n(m_stream, &tm, sizeof(tm));
+
+	/* Samples queued in our buffers and the delay of the graph to the device. */
+	double latency = MixingThreadDevice::getLatency() + tm.queued / double(AUD_DEVICE_SAMPLE_SIZE(m_specs) * m_specs.rate);
+
+	if(tm.rate.denom)
+		latency += tm.delay * tm.rate.num / double(tm.rate.denom);
+
+	return latency;
+}
+
 void PipeWireDevice::seekSynchronizer(double time)
 {
 	/* Update start time here as we might update the seek position while playing back. */
@@ -262,7 +289,7 @@ public:
 
 	virtual std::shared_ptr<IDevice> openDevice()
 	{
-		return std::shared_ptr<IDevice>(new PipeWireDevice(m_name, m_specs, m_buffersize));
+		return std::shared_ptr<IDevice>(new PipeWireDevice(m_name, m_specs, m_buffersize, m_buffersize == 0));
 	}
 
 	virtual int getPriority()
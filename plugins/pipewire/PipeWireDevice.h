@@ -71,16 +71,24 @@ public:
 	 * Opens the PipeWire audio device for playback.
 	 * \param specs The wanted audio specification.
 	 * \param buffersize The size of the internal buffer.
+	 * \param direct Whether to mix directly in the process callback instead of
+	 *               a separate thread, which reduces the latency of the internal
+	 *               buffer to one period. The buffer size is then only the
+	 *               requested period size and the graph decides if it is not
+	 *               positive. The callback never waits for the device lock and
+	 *               plays that period of reserve if it is taken.
 	 * \note The specification really used for opening the device may differ.
 	 * \exception Exception Thrown if the audio device cannot be opened.
 	 */
-	PipeWireDevice(const std::string& name, DeviceSpecs specs, int buffersize = AUD_DEFAULT_BUFFER_SIZE);
+	PipeWireDevice(const std::string& name, DeviceSpecs specs, int buffersize = AUD_DEFAULT_BUFFER_SIZE, bool direct = false);
 
 	/**
 	 * Closes the PipeWire audio device.
 	 */
 	virtual ~PipeWireDevice();
 
+	virtual double getLatency();
+
 	virtual void seekSynchronizer(double time);
 	virtual double getSynchronizerPosition();
 	virtual void playSynchronizer();
@@ -64,6 +64,8 @@ void PulseAudioDevice::PulseAudio_request(pa_stream* stream, size_t total_bytes,
 
 		AUD_pa_stream_begin_write(stream, reinterpret_cast<void**>(&buffer), &num_bytes);
 
+		device->recordRingBufferCallback(num_bytes / sample_size);
+
 		size_t readsamples = device->getRingBuffer().getReadSize();
 
 		readsamples = std::min(readsamples, size_t(num_bytes)) / sample_size;
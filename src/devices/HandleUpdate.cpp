@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "devices/HandleUpdate.h"
+#include "devices/I3DHandle.h"
+#include "devices/IDevice.h"
+
+#include <mutex>
+
+AUD_NAMESPACE_BEGIN
+
+int applyHandleUpdates(IDevice& device, const HandleUpdate* updates, int count)
+{
+	static const int flags3D = HANDLE_UPDATE_LOCATION | HANDLE_UPDATE_VELOCITY | HANDLE_UPDATE_ORIENTATION;
+
+	int applied = 0;
+
+	std::lock_guard<ILockable> lock(device);
+
+	for(int i = 0; i < count; i++)
+	{
+		const HandleUpdate& update = updates[i];
+
+		if(!update.handle)
+			continue;
+
+		bool result = true;
+
+		if(update.flags & flags3D)
+		{
+			I3DHandle* handle = dynamic_cast<I3DHandle*>(update.handle);
+
+			if(handle)
+			{
+				if(update.flags & HANDLE_UPDATE_LOCATION)
+					result = handle->setLocation(update.location) && result;
+				if(update.flags & HANDLE_UPDATE_VELOCITY)
+					result = handle->setVelocity(update.velocity) && result;
+				if(update.flags & HANDLE_UPDATE_ORIENTATION)
+					result = handle->setOrientation(update.orientation) && result;
+			}
+			else
+				result = false;
+		}
+
+		if(update.flags & HANDLE_UPDATE_VOLUME)
+			result = update.handle->setVolume(update.volume) && result;
+		if(update.flags & HANDLE_UPDATE_PITCH)
+			result = update.handle->setPitch(update.pitch) && result;
+
+		if(result)
+			applied++;
+	}
+
+	return applied;
+}
+
+AUD_NAMESPACE_END
@@ -16,6 +16,8 @@
 
 #include "devices/MixingThreadDevice.h"
 
+#include <algorithm>
+
 AUD_NAMESPACE_BEGIN
 
 void MixingThreadDevice::updateRingBuffer()
@@ -35,6 +37,13 @@ void MixingThreadDevice::updateRingBuffer()
 			{
 				size_t size = m_ringBuffer.getWriteSize();
 
+				// when mixing directly only the reserve the callback couldn't refill is mixed
+				if(m_direct)
+				{
+					size_t reserve = m_reserve;
+					size = std::min(size, reserve - std::min(reserve, m_ringBuffer.getReadSize()));
+				}
+
 				size_t sample_count = size / samplesize;
 
 				while(sample_count > 0)
@@ -45,7 +54,7 @@ void MixingThreadDevice::updateRingBuffer()
 
 					m_ringBuffer.write(reinterpret_cast<data_t*>(m_mixingBuffer.getBuffer()), size);
 
-					sample_count = m_ringBuffer.getWriteSize() / samplesize;
+					sample_count = m_direct ? 0 : m_ringBuffer.getWriteSize() / samplesize;
 				}
 			}
 		}
@@ -54,16 +63,61 @@ void MixingThreadDevice::updateRingBuffer()
 	}
 }
 
-void MixingThreadDevice::startMixingThread(size_t buffersize)
+void MixingThreadDevice::startMixingThread(size_t buffersize, bool direct)
 {
+	m_direct = direct;
+
 	m_mixingBuffer.resize(buffersize);
 	m_ringBuffer.resize(buffersize);
 
+	// the audio callback mustn't allocate while mixing
+	if(m_direct)
+		prepareMixing(int(buffersize / AUD_DEVICE_SAMPLE_SIZE(m_specs)));
+
 	m_valid = true;
 
 	m_mixingThread = std::thread(&MixingThreadDevice::updateRingBuffer, this);
 }
 
+void MixingThreadDevice::mixDirect(int length)
+{
+	size_t samplesize = AUD_DEVICE_SAMPLE_SIZE(m_specs);
+	size_t period = length * samplesize;
+
+	m_reserve = period;
+
+	// without playback the mixing thread still has to notice the drained ring buffer
+	if(!m_playback)
+	{
+		notifyMixingThread();
+		return;
+	}
+
+	// the period to read and the reserve for the next one
+	size_t size = 2 * period;
+	size_t available = m_ringBuffer.getReadSize();
+
+	if(available >= size)
+		return;
+
+	size_t sample_count = std::min(size - available, m_ringBuffer.getWriteSize()) / samplesize;
+
+	if(!sample_count)
+		return;
+
+	if(!tryLock())
+	{
+		notifyMixingThread();
+		return;
+	}
+
+	std::lock_guard<ILockable> lock(*this, std::adopt_lock);
+
+	mix(reinterpret_cast<data_t*>(m_mixingBuffer.getBuffer()), sample_count);
+
+	m_ringBuffer.write(reinterpret_cast<data_t*>(m_mixingBuffer.getBuffer()), sample_count * samplesize);
+}
+
 void MixingThreadDevice::notifyMixingThread()
 {
 	m_mixingCondition.notify_all();
@@ -87,6 +141,27 @@ MixingThreadDevice::MixingThreadDevice()
 {
 }
 
+void MixingThreadDevice::recordRingBufferCallback(int length)
+{
+	if(!isStatisticsEnabled())
+	{
+		recordCallback(length, -1, false);
+		return;
+	}
+
+	size_t size = m_ringBuffer.getSize();
+	size_t available = m_ringBuffer.getReadSize();
+
+	// an empty ring buffer is only an underrun while there is playback
+	recordCallback(length, size ? float(available) / size : -1, m_playback && available < size_t(length) * AUD_DEVICE_SAMPLE_SIZE(m_specs));
+}
+
+double MixingThreadDevice::getLatency()
+{
+	// the samples waiting in the ring buffer
+	return m_ringBuffer.getReadSize() / double(AUD_DEVICE_SAMPLE_SIZE(m_specs) * m_specs.rate);
+}
+
 void aud::MixingThreadDevice::stopMixingThread()
 {
 	{
@@ -15,21 +15,37 @@
  ******************************************************************************/
 
 #include "devices/SoftwareDevice.h"
+#include "devices/SubmixBus.h"
 #include "fx/PitchReader.h"
+#include "fx/ProfileReader.h"
 #include "respec/ChannelMapperReader.h"
 #include "respec/JOSResampleReader.h"
 #include "respec/LinearResampleReader.h"
 #include "respec/Mixer.h"
+#include "util/Buffer.h"
+#include "util/BufferReader.h"
+#include "util/DeviceBuffer.h"
+#include "util/OfflineRender.h"
+#include "util/ProfileScope.h"
+#include "util/Profiler.h"
+#include "util/StreamBuffer.h"
 #include "Exception.h"
 #include "ISound.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <limits>
 #include <mutex>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define AUD_SPATIAL_SSE
+#endif
+
 AUD_NAMESPACE_BEGIN
 
 enum RenderFlags
@@ -42,6 +58,30 @@ enum RenderFlags
 
 #define PITCH_MAX 10
 
+// samples read through the reader chain when switching from direct reading
+#define DIRECT_PRIME_SAMPLES 256
+
+// minimum number of stopped handles that are kept for reuse
+#define DEFAULT_POOL_SIZE 32
+
+// volume bonus of rendered voices, so that voices don't flip between real and virtual
+#define VOICE_HYSTERESIS 1.25f
+
+#ifdef AUD_SPATIAL_SSE
+/// Returns a where the mask is set and b otherwise.
+static inline __m128 selectSSE(__m128 mask, __m128 a, __m128 b)
+{
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+/// Returns a mask of the four flags at flags that have the flag set.
+static inline __m128 flagMaskSSE(const int* flags, int flag)
+{
+	__m128i set = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(flags)), _mm_set1_epi32(flag));
+	return _mm_castsi128_ps(_mm_xor_si128(_mm_cmpeq_epi32(set, _mm_setzero_si128()), _mm_set1_epi32(-1)));
+}
+#endif
+
 /******************************************************************************/
 /********************** SoftwareHandle Handle Code ************************/
 /******************************************************************************/
@@ -58,14 +98,28 @@ bool SoftwareDevice::SoftwareHandle::pause(bool keep)
 			{
 				if(it->get() == this)
 				{
-					std::shared_ptr<SoftwareHandle> This = *it;
+					m_device->m_pausedSounds.splice(m_device->m_pausedSounds.end(), m_device->m_playingSounds, it);
+
+					if(m_device->m_playingSounds.empty() && m_device->m_scheduledSounds.empty())
+						m_device->playing(m_device->m_playback = false);
+
+					m_status = keep ? STATUS_STOPPED : STATUS_PAUSED;
+
+					return true;
+				}
+			}
 
-					m_device->m_playingSounds.erase(it);
-					m_device->m_pausedSounds.push_back(This);
+			// pausing cancels the schedule
+			for(auto it = m_device->m_scheduledSounds.begin(); it != m_device->m_scheduledSounds.end(); it++)
+			{
+				if(it->get() == this)
+				{
+					m_device->m_pausedSounds.splice(m_device->m_pausedSounds.end(), m_device->m_scheduledSounds, it);
 
-					if(m_device->m_playingSounds.empty())
+					if(m_device->m_playingSounds.empty() && m_device->m_scheduledSounds.empty())
 						m_device->playing(m_device->m_playback = false);
 
+					m_start_sample = 0;
 					m_status = keep ? STATUS_STOPPED : STATUS_PAUSED;
 
 					return true;
@@ -77,12 +131,103 @@ bool SoftwareDevice::SoftwareHandle::pause(bool keep)
 	return false;
 }
 
-SoftwareDevice::SoftwareHandle::SoftwareHandle(SoftwareDevice* device, std::shared_ptr<IReader> reader, std::shared_ptr<PitchReader> pitch, std::shared_ptr<ResampleReader> resampler, std::shared_ptr<ChannelMapperReader> mapper, bool keep) :
-	m_reader(reader), m_pitch(pitch), m_resampler(resampler), m_mapper(mapper), m_first_reading(true), m_keep(keep), m_user_pitch(1.0f), m_user_volume(1.0f), m_user_pan(0.0f), m_volume(0.0f), m_old_volume(0.0f), m_loopcount(0),
-	m_relative(true), m_volume_max(1.0f), m_volume_min(0), m_distance_max(std::numeric_limits<float>::max()),
-	m_distance_reference(1.0f), m_attenuation(1.0f), m_cone_angle_outer(M_PI), m_cone_angle_inner(M_PI), m_cone_volume_outer(0),
-	m_flags(RENDER_CONE), m_stop(nullptr), m_stop_data(nullptr), m_status(STATUS_PLAYING), m_device(device)
+void SoftwareDevice::SoftwareHandle::leaveDirect(sample_t* buffer, int length)
+{
+	m_direct = false;
+
+	// the chain is reset and rereads the last samples at the original pitch,
+	// so that the resampler continues exactly where direct reading stopped
+	float pitch = m_pitch->getPitch();
+	int position = m_buffer_source->getPosition();
+	int prime = 0;
+	bool eos;
+
+	if(m_buffer_source->getSpecs().rate == m_device->m_specs.rate)
+		prime = std::min(position, DIRECT_PRIME_SAMPLES);
+
+	m_pitch->setPitch(1.0f);
+	m_reader->seek(position - prime);
+	m_pitch->seek(position - prime);
+
+	while(prime > 0)
+	{
+		int len = std::min(prime, length);
+		m_reader->read(len, eos, buffer);
+
+		if(!len)
+			break;
+
+		prime -= len;
+	}
+
+	m_pitch->setPitch(pitch);
+}
+
+void SoftwareDevice::SoftwareHandle::initialize(std::shared_ptr<BufferReader> buffer_source, bool keep)
 {
+	m_buffer_source = buffer_source;
+	m_direct = buffer_source != nullptr;
+	m_first_reading = true;
+	m_keep = keep;
+	m_user_pitch = 1.0f;
+	m_user_volume = 1.0f;
+	m_user_pan = 0.0f;
+	m_volume = 0.0f;
+	m_old_volume = 0.0f;
+	m_loopcount = 0;
+	m_location = Vector3();
+	m_velocity = Vector3();
+	m_orientation = Quaternion();
+	m_relative = true;
+	m_volume_max = 1.0f;
+	m_volume_min = 0;
+	m_distance_max = std::numeric_limits<float>::max();
+	m_distance_reference = 1.0f;
+	m_attenuation = 1.0f;
+	m_cone_angle_outer = M_PI;
+	m_cone_angle_inner = M_PI;
+	m_cone_volume_outer = 0;
+	m_flags = RENDER_CONE;
+	m_stop = nullptr;
+	m_stop_data = nullptr;
+	m_status = STATUS_PLAYING;
+	m_priority = 0;
+	m_audible = true;
+	m_virtual = false;
+	m_virtual_position = 0;
+	m_angle = 0;
+	m_height = 0;
+	m_first_encoding = true;
+	m_start_sample = 0;
+	m_stop_sample = std::numeric_limits<uint64_t>::max();
+	m_profile = Profiler::isEnabled() ? std::make_shared<ProfileNode>("SoftwareHandle", Profiler::getTypeNode("SoftwareHandle")) : nullptr;
+}
+
+SoftwareDevice::SoftwareHandle::SoftwareHandle(SoftwareDevice* device, std::shared_ptr<IReader> reader, std::shared_ptr<PitchReader> pitch, std::shared_ptr<ResampleReader> resampler, std::shared_ptr<ChannelMapperReader> mapper, std::shared_ptr<BufferReader> buffer_source, bool keep) :
+	m_reader(reader), m_pitch(pitch), m_resampler(resampler), m_mapper(mapper), m_device(device)
+{
+	initialize(buffer_source, keep);
+}
+
+void SoftwareDevice::SoftwareHandle::reuse(std::shared_ptr<IReader> reader, std::shared_ptr<BufferReader> buffer_source, bool keep)
+{
+	m_pitch->setReader(reader);
+	m_pitch->setPitch(1.0f);
+	m_resampler->reset();
+
+	initialize(buffer_source, keep);
+}
+
+void SoftwareDevice::SoftwareHandle::release()
+{
+	// the buffer reader is kept, so that it can be reused for another buffer
+	if(m_buffer_source)
+		m_buffer_source->setBuffer(nullptr, m_buffer_source->getSpecs());
+
+	m_pitch->setReader(nullptr);
+	m_stop = nullptr;
+	m_stop_data = nullptr;
+	m_bus = nullptr;
 }
 
 void SoftwareDevice::SoftwareHandle::update()
@@ -241,6 +386,12 @@ void SoftwareDevice::SoftwareHandle::update()
 	Vector3 A = N * ((SL * N) / (N * N)) - SL;
 
 	float Asquare = A * A;
+	float height = -(SL * N) / N.length();
+
+	if(Asquare + height * height > 0)
+		m_height = height / std::sqrt(Asquare + height * height);
+	else
+		m_height = 0;
 
 	if(Asquare > 0)
 	{
@@ -248,10 +399,119 @@ void SoftwareDevice::SoftwareHandle::update()
 		if(N.cross(Z) * A > 0)
 			phi = -phi;
 
-		m_mapper->setMonoAngle(phi);
+		m_angle = phi;
+	}
+	else
+		m_angle = m_relative ? m_user_pan * M_PI / 2.0 : 0;
+}
+
+sample_t* SoftwareDevice::SoftwareHandle::read(int& length, bool& eos, sample_t* buffer, bool encode)
+{
+	ProfileScope scope(m_profile);
+
+	if(m_direct)
+	{
+		if(AUD_COMPARE_SPECS(m_pitch->getSpecs(), m_device->m_specs))
+		{
+			sample_t* samples = m_buffer_source->readDirect(length, eos);
+			scope.setSamples(length);
+			return samples;
+		}
+
+		leaveDirect(buffer, length);
 	}
+
+	if(encode)
+		m_resampler->read(length, eos, buffer);
 	else
-		m_mapper->setMonoAngle(m_relative ? m_user_pan * M_PI / 2.0 : 0);
+		m_reader->read(length, eos, buffer);
+
+	scope.setSamples(length);
+
+	return buffer;
+}
+
+void SoftwareDevice::SoftwareHandle::updateAmbisonics(int order)
+{
+	const int channels = AUD_AMBISONICS_CHANNELS(order);
+
+	std::memcpy(m_old_ambisonics, m_ambisonics, channels * sizeof(float));
+
+	float horizontal = std::sqrt(std::max(0.0f, 1.0f - m_height * m_height));
+
+	// negative angles are on the left, which is the positive y axis
+	AmbisonicsDecoder::encode(order, horizontal * std::cos(m_angle), -horizontal * std::sin(m_angle), m_height, m_ambisonics);
+
+	for(int k = 0; k < channels; k++)
+		m_ambisonics[k] *= m_volume;
+
+	// we don't know previous coefficients if this source has never been encoded before
+	if(m_first_encoding)
+	{
+		std::memcpy(m_old_ambisonics, m_ambisonics, channels * sizeof(float));
+		m_first_encoding = false;
+	}
+}
+
+void SoftwareDevice::SoftwareHandle::seekReader(int position)
+{
+	m_reader->seek(position);
+
+	// seeking resets the reader chain, so direct reading can be resumed
+	m_direct = m_buffer_source != nullptr;
+
+	if(m_virtual)
+		m_virtual_position = m_pitch->getPosition();
+}
+
+bool SoftwareDevice::SoftwareHandle::canVirtualize()
+{
+	return m_pitch->isSeekable() && m_pitch->getLength() >= 0;
+}
+
+void SoftwareDevice::SoftwareHandle::virtualize()
+{
+	m_virtual = true;
+	m_virtual_position = m_pitch->getPosition();
+}
+
+void SoftwareDevice::SoftwareHandle::devirtualize()
+{
+	m_virtual = false;
+
+	seekReader(int(m_virtual_position * m_device->m_specs.rate / m_pitch->getSpecs().rate));
+
+	// the pitch reader passes the seek unchanged to the source
+	m_pitch->seek(int(m_virtual_position));
+
+	// fade in
+	m_old_volume = 0;
+}
+
+bool SoftwareDevice::SoftwareHandle::advanceVirtual(int length)
+{
+	m_virtual_position += length * m_pitch->getSpecs().rate / m_device->m_specs.rate;
+
+	int source_length = m_pitch->getLength();
+
+	if(source_length <= 0)
+		return !m_loopcount;
+
+	while(m_virtual_position >= source_length)
+	{
+		if(!m_loopcount)
+		{
+			m_virtual_position = source_length;
+			return true;
+		}
+
+		if(m_loopcount > 0)
+			m_loopcount--;
+
+		m_virtual_position -= source_length;
+	}
+
+	return false;
 }
 
 void SoftwareDevice::SoftwareHandle::setSpecs(Specs specs)
@@ -277,11 +537,8 @@ bool SoftwareDevice::SoftwareHandle::resume()
 			{
 				if(it->get() == this)
 				{
-					std::shared_ptr<SoftwareHandle> This = *it;
-
-					m_device->m_pausedSounds.erase(it);
-
-					m_device->m_playingSounds.push_back(This);
+					m_device->m_playingSounds.splice(m_device->m_playingSounds.end(), m_device->m_pausedSounds, it);
+					m_device->reserveSounds();
 
 					if(!m_device->m_playback)
 						m_device->playing(m_device->m_playback = true);
@@ -313,11 +570,13 @@ bool SoftwareDevice::SoftwareHandle::stop()
 	{
 		if(it->get() == this)
 		{
+			// the pool might drop the last reference
 			std::shared_ptr<SoftwareHandle> This = *it;
 
-			m_device->m_playingSounds.erase(it);
+			m_device->poolHandle(m_device->m_playingSounds, it);
+			release();
 
-			if(m_device->m_playingSounds.empty())
+			if(m_device->m_playingSounds.empty() && m_device->m_scheduledSounds.empty())
 				m_device->playing(m_device->m_playback = false);
 
 			return true;
@@ -328,9 +587,28 @@ bool SoftwareDevice::SoftwareHandle::stop()
 	{
 		if(it->get() == this)
 		{
+			// the pool might drop the last reference
+			std::shared_ptr<SoftwareHandle> This = *it;
+
+			m_device->poolHandle(m_device->m_pausedSounds, it);
+			release();
+
+			return true;
+		}
+	}
+
+	for(auto it = m_device->m_scheduledSounds.begin(); it != m_device->m_scheduledSounds.end(); it++)
+	{
+		if(it->get() == this)
+		{
+			// the pool might drop the last reference
 			std::shared_ptr<SoftwareHandle> This = *it;
 
-			m_device->m_pausedSounds.erase(it);
+			m_device->poolHandle(m_device->m_scheduledSounds, it);
+			release();
+
+			if(m_device->m_playingSounds.empty() && m_device->m_scheduledSounds.empty())
+				m_device->playing(m_device->m_playback = false);
 
 			return true;
 		}
@@ -373,7 +651,7 @@ bool SoftwareDevice::SoftwareHandle::seek(double position)
 		return false;
 
 	m_pitch->setPitch(m_user_pitch);
-	m_reader->seek((int)(position * m_reader->getSpecs().rate));
+	seekReader((int)(position * m_reader->getSpecs().rate));
 
 	if(m_status == STATUS_STOPPED)
 		m_status = STATUS_PAUSED;
@@ -391,6 +669,9 @@ double SoftwareDevice::SoftwareHandle::getPosition()
 	if(!m_status)
 		return 0.0f;
 
+	if(m_virtual)
+		return m_virtual_position / m_pitch->getSpecs().rate;
+
 	double position = m_reader->getPosition() / (double)m_device->m_specs.rate;
 
 	return position;
@@ -710,6 +991,7 @@ bool SoftwareDevice::SoftwareHandle::setConeVolumeOuter(float volume)
 void SoftwareDevice::create()
 {
 	m_playback = false;
+	m_mixLength = 0;
 	m_volume = 1.0f;
 	m_mixer = std::shared_ptr<Mixer>(new Mixer(m_specs));
 	m_speed_of_sound = 343.3f;
@@ -717,6 +999,13 @@ void SoftwareDevice::create()
 	m_distance_model = DISTANCE_MODEL_INVERSE_CLAMPED;
 	m_flags = 0;
 	m_quality = ResampleQuality::FASTEST;
+	m_poolSize = DEFAULT_POOL_SIZE;
+	m_offline = false;
+	m_max_voices = 0;
+	m_virtual_volume = 0;
+	m_real_voices = 0;
+	m_virtual_voices = 0;
+	m_mixProfile = Profiler::getTypeNode(Profiler::getTypeName(typeid(*this)));
 }
 
 void SoftwareDevice::destroy()
@@ -725,165 +1014,902 @@ void SoftwareDevice::destroy()
 		playing(m_playback = false);
 
 	stopAll();
+
+	std::lock_guard<ILockable> lock(*this);
+
+	m_pooledSounds.clear();
+	m_pooledBufferSounds.clear();
+
+	// buses can outlive the device
+	for(auto& weak_bus : m_buses)
+	{
+		std::shared_ptr<SubmixBus> bus = weak_bus.lock();
+
+		if(bus)
+			bus->m_device = nullptr;
+	}
+
+	m_buses.clear();
 }
 
 void SoftwareDevice::mix(data_t* buffer, int length)
 {
-	m_buffer.assureSize(length * AUD_SAMPLE_SIZE(m_specs));
+	std::lock_guard<ILockable> lock(*this);
+
+	mixSounds(length);
+
+	m_mixer->read(buffer, m_volume);
+}
+
+bool SoftwareDevice::tryLock()
+{
+	return m_mutex.try_lock();
+}
 
+void SoftwareDevice::prepareMixing(int length)
+{
 	std::lock_guard<ILockable> lock(*this);
 
+	m_mixLength = std::max(m_mixLength, length);
+
+	allocateMixing();
+}
+
+void SoftwareDevice::allocateMixing()
+{
+	if(!m_mixLength)
+		return;
+
+	m_buffer.assureSize(m_mixLength * AUD_SAMPLE_SIZE(m_specs));
+
+	// clearing allocates the mixer buffer
+	m_mixer->clear(m_mixLength);
+
+	m_mixBuses.reserve(m_buses.size());
+
+	reserveSounds();
+}
+
+void SoftwareDevice::reserveSounds()
+{
+	size_t count = m_playingSounds.size() + m_scheduledSounds.size();
+
+	m_stopSounds.reserve(count);
+	m_pauseSounds.reserve(count);
+	m_voices.reserve(count);
+	m_spatial.reserve(int(count));
+}
+
+void SoftwareDevice::recordCallback(int length, float fill, bool underrun)
+{
+	if(!m_statistics.load(std::memory_order_relaxed))
+	{
+		m_lastCallbackLength = 0;
+		return;
+	}
+
+	auto now = std::chrono::steady_clock::now();
+
+	if(m_lastCallbackLength)
 	{
+		int64_t interval = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_lastCallback).count();
+		int64_t period = int64_t(m_lastCallbackLength * 1e9 / m_specs.rate);
+
+		m_callbackInterval.add(interval);
+		m_callbackJitter.add(std::abs(interval - period));
+	}
+
+	m_lastCallback = now;
+	m_lastCallbackLength = length;
+
+	if(fill >= 0)
+		m_callbackFill.add(uint64_t(fill * 1000 + 0.5f));
+
+	if(underrun)
+		m_underruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SoftwareDevice::mixSounds(int length)
+{
+	m_buffer.assureSize(length * AUD_SAMPLE_SIZE(m_specs));
+
+	bool statistics = m_statistics.load(std::memory_order_relaxed);
+	std::chrono::steady_clock::time_point start;
+
+	if(statistics)
+		start = std::chrono::steady_clock::now();
+
+	{
+		ProfileScope profile(m_mixProfile, Profiler::isEnabled() || Profiler::isTracing());
+		profile.setSamples(length);
+
 		std::shared_ptr<SoftwareDevice::SoftwareHandle> sound;
 		int len;
 		int pos;
 		bool eos;
-		std::list<std::shared_ptr<SoftwareDevice::SoftwareHandle> > stopSounds;
-		std::list<std::shared_ptr<SoftwareDevice::SoftwareHandle> > pauseSounds;
 		sample_t* buf = m_buffer.getBuffer();
+		sample_t* data;
 
 		m_mixer->clear(length);
 
+		uint64_t clock = m_clock;
+
+		// start the scheduled sounds that begin within this mix
+		while(!m_scheduledSounds.empty() && m_scheduledSounds.front()->m_start_sample < clock + length)
+			m_playingSounds.splice(m_playingSounds.end(), m_scheduledSounds, m_scheduledSounds.begin());
+
+		if(!m_playback && !m_playingSounds.empty())
+			playing(m_playback = true);
+
+		// prepare the submix buses
+		for(auto it = m_buses.begin(); it != m_buses.end();)
+		{
+			std::shared_ptr<SubmixBus> bus = it->lock();
+
+			if(bus)
+			{
+				bus->clear(length);
+				m_mixBuses.push_back(bus);
+				it++;
+			}
+			else
+				it = m_buses.erase(it);
+		}
+
+		// update 3D Info and decide which sounds are rendered
+		updateHandles();
+
+		updateVoices();
+
 		// for all sounds
 		for(auto& sound : m_playingSounds)
 		{
-			// get the buffer from the source
-			pos = 0;
-			len = length;
 			eos = false;
 
-			// update 3D Info
-			sound->update();
+			// scheduled sounds start and stop at exact samples within the mix
+			int begin = 0;
+			int end = length;
+
+			if(sound->m_start_sample)
+			{
+				if(sound->m_start_sample > clock)
+					begin = int(sound->m_start_sample - clock);
+
+				sound->m_start_sample = 0;
+			}
+
+			uint64_t stop_sample = sound->m_stop_sample.load(std::memory_order_relaxed);
+			bool stopped = stop_sample < clock + length;
+
+			if(stopped)
+				end = std::max(int(std::max(stop_sample, clock) - clock), begin);
 
-			try
+			if(sound->m_virtual)
 			{
-				sound->m_reader->read(len, eos, buf);
+				if(sound->m_audible)
+					sound->devirtualize();
+				else
+					eos = sound->advanceVirtual(end - begin);
+			}
+
+			if(!sound->m_virtual)
+			{
+				Mixer& mixer = sound->m_bus ? *sound->m_bus->m_mixer : *m_mixer;
+				SubmixBus* ambisonics = nullptr;
+
+				// mono sounds routed to an ambisonics bus bypass the channel mapping
+				if(sound->m_bus && sound->m_bus->m_decoder && sound->m_pitch->getSpecs().channels == CHANNELS_MONO)
+					ambisonics = sound->m_bus.get();
+
+				std::chrono::steady_clock::time_point start;
+				bool timing = statistics && sound->m_bus;
+
+				if(timing)
+					start = std::chrono::steady_clock::now();
+
+				// get the buffer from the source
+				pos = begin;
+				len = end - begin;
+				data = buf;
 
-				// in case of looping
-				while(pos + len < length && sound->m_loopcount && eos)
+				// fade out sounds that become virtual
+				if(!sound->m_audible)
+					sound->m_volume = 0;
+
+				// the spatialization is only updated for rendered sounds
+				if(ambisonics)
+					sound->updateAmbisonics(ambisonics->m_decoder->getOrder());
+				else
+					sound->m_mapper->setMonoAngle(sound->m_angle);
+
+				try
 				{
-					m_mixer->mix(buf, pos, len, sound->m_volume, sound->m_old_volume);
+					if(len)
+						data = sound->read(len, eos, buf, ambisonics != nullptr);
+
+					// in case of looping
+					while(pos + len < end && sound->m_loopcount && eos)
+					{
+						if(ambisonics)
+						{
+							ambisonics->encode(data, pos, len, sound->m_ambisonics, sound->m_old_ambisonics);
+							std::memcpy(sound->m_old_ambisonics, sound->m_ambisonics, sizeof(sound->m_ambisonics));
+						}
+						else
+							mixer.mix(data, pos, len, sound->m_volume, sound->m_old_volume);
 
-					sound->m_old_volume = sound->m_volume;
+						sound->m_old_volume = sound->m_volume;
 
-					pos += len;
+						pos += len;
 
-					if(sound->m_loopcount > 0)
-						sound->m_loopcount--;
+						if(sound->m_loopcount > 0)
+							sound->m_loopcount--;
 
-					sound->m_reader->seek(0);
+						sound->seekReader(0);
 
-					len = length - pos;
-					sound->m_reader->read(len, eos, buf);
+						len = end - pos;
+						data = sound->read(len, eos, buf, ambisonics != nullptr);
 
-					// prevent endless loop
-					if(!len)
-						break;
+						// prevent endless loop
+						if(!len)
+							break;
+					}
 				}
-			}
-			catch(Exception& e)
-			{
-				len = 0;
-				std::cerr << "Caught exception while reading sound data during playback with software mixing: " << e.getMessage() << std::endl;
-			}
+				catch(Exception& e)
+				{
+					len = 0;
+					std::cerr << "Caught exception while reading sound data during playback with software mixing: " << e.getMessage() << std::endl;
+				}
+
+				if(ambisonics)
+					ambisonics->encode(data, pos, len, sound->m_ambisonics, sound->m_old_ambisonics);
+				else
+					mixer.mix(data, pos, len, sound->m_volume, sound->m_old_volume);
+
+				if(timing)
+					sound->m_bus->addTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
 
-			m_mixer->mix(buf, pos, len, sound->m_volume, sound->m_old_volume);
+				if(!sound->m_audible)
+					sound->virtualize();
+			}
 
-			// in case the end of the sound is reached
-			if(eos && !sound->m_loopcount)
+			// in case the sound is stopped or the end of the sound is reached
+			if(stopped)
+				m_stopSounds.push_back(sound);
+			else if(eos && !sound->m_loopcount)
 			{
 				if(sound->m_stop)
 					sound->m_stop(sound->m_stop_data);
 
 				if(sound->m_keep)
-					pauseSounds.push_back(sound);
+					m_pauseSounds.push_back(sound);
 				else
-					stopSounds.push_back(sound);
+					m_stopSounds.push_back(sound);
 			}
 		}
 
-		// superpose
-		m_mixer->read(buffer, m_volume);
+		// buses are created after their parents, so children are processed first
+		for(auto it = m_mixBuses.rbegin(); it != m_mixBuses.rend(); it++)
+		{
+			SubmixBus* bus = it->get();
+			bus->process(bus->m_parent ? *bus->m_parent->m_mixer : *m_mixer, statistics);
+		}
+
+		m_mixBuses.clear();
 
 		// cleanup
-		for(auto& sound : pauseSounds)
+		for(auto& sound : m_pauseSounds)
 			sound->pause(true);
 
-		for(auto& sound :  stopSounds)
+		for(auto& sound : m_stopSounds)
 			sound->stop();
 
-		pauseSounds.clear();
-		stopSounds.clear();
+		m_pauseSounds.clear();
+		m_stopSounds.clear();
 
 		if(m_synchronizerState)
 			m_synchronizerPosition += length;
-	}
-}
 
-void SoftwareDevice::setPanning(IHandle* handle, float pan)
-{
-	SoftwareDevice::SoftwareHandle* h = dynamic_cast<SoftwareDevice::SoftwareHandle*>(handle);
-	h->m_user_pan = pan;
-}
+		m_clock = clock + length;
+	}
 
-void SoftwareDevice::setQuality(ResampleQuality quality)
-{
-	m_quality = quality;
+	if(statistics)
+	{
+		m_mixTime.add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+		m_mixVoices.add(m_real_voices);
+	}
 }
 
-void SoftwareDevice::setSpecs(Specs specs)
+void SoftwareDevice::updateVoices()
 {
-	m_specs.specs = specs;
-	m_mixer->setSpecs(specs);
+	int max_voices = m_max_voices;
+	float virtual_volume = m_virtual_volume;
 
-	for(auto& sound : m_playingSounds)
+	if(max_voices <= 0 && virtual_volume <= 0)
 	{
-		sound->setSpecs(specs);
-	}
+		for(auto& sound : m_playingSounds)
+			sound->m_audible = true;
 
-	for(auto& sound : m_pausedSounds)
-	{
-		sound->setSpecs(specs);
+		m_real_voices = int(m_playingSounds.size());
+		m_virtual_voices = 0;
+
+		return;
 	}
-}
 
-void SoftwareDevice::setSpecs(DeviceSpecs specs)
-{
-	m_specs = specs;
-	m_mixer->setSpecs(specs);
+	int real = 0;
+
+	m_voices.clear();
 
 	for(auto& sound : m_playingSounds)
 	{
-		sound->setSpecs(specs.specs);
+		sound->m_audible = true;
+
+		if(!sound->canVirtualize())
+			real++;
+		else if(sound->m_volume < virtual_volume)
+			sound->m_audible = false;
+		else
+			m_voices.push_back(sound.get());
 	}
 
-	for(auto& sound : m_pausedSounds)
+	int count = m_voices.size();
+
+	if(max_voices > 0 && real + count > max_voices)
 	{
-		sound->setSpecs(specs.specs);
+		count = std::max(max_voices - real, 0);
+
+		std::nth_element(m_voices.begin(), m_voices.begin() + count, m_voices.end(), [](SoftwareHandle* a, SoftwareHandle* b)
+		{
+			if(a->m_priority != b->m_priority)
+				return a->m_priority > b->m_priority;
+
+			return a->m_volume * (a->m_virtual ? 1.0f : VOICE_HYSTERESIS) > b->m_volume * (b->m_virtual ? 1.0f : VOICE_HYSTERESIS);
+		});
+
+		for(auto it = m_voices.begin() + count; it != m_voices.end(); it++)
+			(*it)->m_audible = false;
 	}
+
+	m_real_voices = real + count;
+	m_virtual_voices = int(m_playingSounds.size()) - (real + count);
 }
 
-SoftwareDevice::SoftwareDevice()
+void SoftwareDevice::SpatialBatch::resize(int size)
 {
+	m_handles.resize(size);
+	m_flags.resize(size);
+	m_relative.resize(size);
+
+	for(std::vector<float>* array : {&m_sl_x, &m_sl_y, &m_sl_z, &m_velocity_x, &m_velocity_y, &m_velocity_z,
+									 &m_look_x, &m_look_y, &m_look_z, &m_user_pitch, &m_user_volume, &m_user_pan,
+									 &m_volume_min, &m_volume_max, &m_distance_reference, &m_distance_max, &m_attenuation,
+									 &m_cone_angle_inner, &m_cone_angle_outer, &m_cone_volume_outer,
+									 &m_distance, &m_clamped, &m_gain, &m_cone, &m_pitch, &m_volume, &m_angle, &m_height})
+		array->resize(size);
 }
 
-DeviceSpecs SoftwareDevice::getSpecs() const
+void SoftwareDevice::SpatialBatch::reserve(int size)
 {
-	return m_specs;
+	m_handles.reserve(size);
+	m_flags.reserve(size);
+	m_relative.reserve(size);
+
+	for(std::vector<float>* array : {&m_sl_x, &m_sl_y, &m_sl_z, &m_velocity_x, &m_velocity_y, &m_velocity_z,
+									 &m_look_x, &m_look_y, &m_look_z, &m_user_pitch, &m_user_volume, &m_user_pan,
+									 &m_volume_min, &m_volume_max, &m_distance_reference, &m_distance_max, &m_attenuation,
+									 &m_cone_angle_inner, &m_cone_angle_outer, &m_cone_volume_outer,
+									 &m_distance, &m_clamped, &m_gain, &m_cone, &m_pitch, &m_volume, &m_angle, &m_height})
+		array->reserve(size);
 }
 
-std::shared_ptr<IHandle> SoftwareDevice::play(std::shared_ptr<IReader> reader, bool keep)
+void SoftwareDevice::updateHandles()
 {
-	// prepare the reader
-	// pitch
+	SpatialBatch& b = m_spatial;
+	b.resize(m_playingSounds.size());
 
-	std::shared_ptr<PitchReader> pitch = std::shared_ptr<PitchReader>(new PitchReader(reader, 1));
-	reader = std::shared_ptr<IReader>(pitch);
+	int count = 0;
 
-	std::shared_ptr<ResampleReader> resampler;
+	// gather
 
-	// resample
-	if (m_quality == ResampleQuality::FASTEST)
+	for(auto& sound : m_playingSounds)
+	{
+		// only mono sources are rendered in 3D
+		if(sound->m_pitch->getSpecs().channels != CHANNELS_MONO)
+		{
+			sound->update();
+			continue;
+		}
+
+		sound->m_old_volume = sound->m_volume;
+
+		Vector3 SL;
+		if(sound->m_relative)
+			SL = -sound->m_location;
+		else
+			SL = m_location - sound->m_location;
+
+		Vector3 SZ = sound->m_orientation.getLookAt();
+
+		b.m_handles[count] = sound.get();
+		b.m_flags[count] = sound->m_flags | m_flags;
+		b.m_relative[count] = sound->m_relative;
+		b.m_sl_x[count] = SL.x();
+		b.m_sl_y[count] = SL.y();
+		b.m_sl_z[count] = SL.z();
+		b.m_velocity_x[count] = sound->m_velocity.x();
+		b.m_velocity_y[count] = sound->m_velocity.y();
+		b.m_velocity_z[count] = sound->m_velocity.z();
+		b.m_look_x[count] = SZ.x();
+		b.m_look_y[count] = SZ.y();
+		b.m_look_z[count] = SZ.z();
+		b.m_user_pitch[count] = sound->m_user_pitch;
+		b.m_user_volume[count] = sound->m_user_volume;
+		b.m_user_pan[count] = sound->m_user_pan;
+		b.m_volume_min[count] = sound->m_volume_min;
+		b.m_volume_max[count] = sound->m_volume_max;
+		b.m_distance_reference[count] = sound->m_distance_reference;
+		b.m_distance_max[count] = sound->m_distance_max;
+		b.m_attenuation[count] = sound->m_attenuation;
+		b.m_cone_angle_inner[count] = sound->m_cone_angle_inner;
+		b.m_cone_angle_outer[count] = sound->m_cone_angle_outer;
+		b.m_cone_volume_outer[count] = sound->m_cone_volume_outer;
+		b.m_volume[count] = sound->m_volume;
+
+		count++;
+	}
+
+	// the passes process four handles at once with SSE and the rest without
+
+	int i;
+
+	// distance
+
+	i = 0;
+
+#ifdef AUD_SPATIAL_SSE
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(&b.m_sl_x[i]);
+		__m128 y = _mm_loadu_ps(&b.m_sl_y[i]);
+		__m128 z = _mm_loadu_ps(&b.m_sl_z[i]);
+		__m128 squared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+
+		__m128i zero = _mm_castps_si128(_mm_cmpgt_ps(squared, _mm_setzero_ps()));
+		__m128i flags = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&b.m_flags[i])), _mm_andnot_si128(zero, _mm_set1_epi32(RENDER_DOPPLER | RENDER_DISTANCE)));
+
+		_mm_storeu_ps(&b.m_distance[i], _mm_sqrt_ps(squared));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&b.m_flags[i]), _mm_xor_si128(flags, _mm_set1_epi32(-1)));
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		float distance = b.m_sl_x[i] * b.m_sl_x[i] + b.m_sl_y[i] * b.m_sl_y[i] + b.m_sl_z[i] * b.m_sl_z[i];
+		int flags = b.m_flags[i];
+
+		if(distance > 0)
+			distance = std::sqrt(distance);
+		else
+			flags |= RENDER_DOPPLER | RENDER_DISTANCE;
+
+		b.m_distance[i] = distance;
+		b.m_flags[i] = ~flags;
+	}
+
+	// Doppler and Pitch
+
+	const float max = m_speed_of_sound / m_doppler_factor;
+
+	i = 0;
+
+#ifdef AUD_SPATIAL_SSE
+	const __m128 listener_x = _mm_set1_ps(m_velocity.x());
+	const __m128 listener_y = _mm_set1_ps(m_velocity.y());
+	const __m128 listener_z = _mm_set1_ps(m_velocity.z());
+	const __m128 speed_of_sound = _mm_set1_ps(m_speed_of_sound);
+	const __m128 doppler_factor = _mm_set1_ps(m_doppler_factor);
+	const __m128 max_vector = _mm_set1_ps(max);
+
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(&b.m_sl_x[i]);
+		__m128 y = _mm_loadu_ps(&b.m_sl_y[i]);
+		__m128 z = _mm_loadu_ps(&b.m_sl_z[i]);
+		__m128 distance = _mm_loadu_ps(&b.m_distance[i]);
+		__m128 user_pitch = _mm_loadu_ps(&b.m_user_pitch[i]);
+
+		__m128 vls = _mm_div_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, listener_x), _mm_mul_ps(y, listener_y)), _mm_mul_ps(z, listener_z)), distance);
+		__m128 vss = _mm_div_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_loadu_ps(&b.m_velocity_x[i])), _mm_mul_ps(y, _mm_loadu_ps(&b.m_velocity_y[i]))), _mm_mul_ps(z, _mm_loadu_ps(&b.m_velocity_z[i]))), distance);
+
+		vls = _mm_and_ps(vls, _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&b.m_relative[i])), _mm_setzero_si128())));
+		vls = _mm_min_ps(max_vector, vls);
+
+		__m128 pitch = _mm_mul_ps(_mm_div_ps(_mm_sub_ps(speed_of_sound, _mm_mul_ps(doppler_factor, vls)), _mm_sub_ps(speed_of_sound, _mm_mul_ps(doppler_factor, vss))), user_pitch);
+		pitch = selectSSE(_mm_cmpge_ps(vss, max_vector), _mm_set1_ps(PITCH_MAX), pitch);
+
+		_mm_storeu_ps(&b.m_pitch[i], selectSSE(flagMaskSSE(&b.m_flags[i], RENDER_DOPPLER), pitch, user_pitch));
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		float distance = b.m_distance[i];
+		float vls = b.m_relative[i] ? 0 : (b.m_sl_x[i] * m_velocity.x() + b.m_sl_y[i] * m_velocity.y() + b.m_sl_z[i] * m_velocity.z()) / distance;
+		float vss = (b.m_sl_x[i] * b.m_velocity_x[i] + b.m_sl_y[i] * b.m_velocity_y[i] + b.m_sl_z[i] * b.m_velocity_z[i]) / distance;
+
+		if(vls > max)
+			vls = max;
+
+		float pitch = vss >= max ? PITCH_MAX : (m_speed_of_sound - m_doppler_factor * vls) / (m_speed_of_sound - m_doppler_factor * vss) * b.m_user_pitch[i];
+
+		b.m_pitch[i] = (b.m_flags[i] & RENDER_DOPPLER) ? pitch : b.m_user_pitch[i];
+	}
+
+	// Distance, the results are stored as volume of handles that are rendered with volume
+
+	bool clamped = m_distance_model == DISTANCE_MODEL_INVERSE_CLAMPED ||
+				   m_distance_model == DISTANCE_MODEL_LINEAR_CLAMPED ||
+				   m_distance_model == DISTANCE_MODEL_EXPONENT_CLAMPED;
+
+	std::vector<float>& distance = clamped ? b.m_clamped : b.m_distance;
+
+	if(clamped)
+	{
+		for(i = 0; i < count; i++)
+			b.m_clamped[i] = std::max(std::min(b.m_distance_max[i], b.m_distance[i]), b.m_distance_reference[i]);
+	}
+
+	std::vector<float>& gain = b.m_gain;
+
+	switch(m_distance_model)
+	{
+	case DISTANCE_MODEL_INVERSE:
+	case DISTANCE_MODEL_INVERSE_CLAMPED:
+		for(i = 0; i < count; i++)
+			gain[i] = b.m_distance_reference[i] / (b.m_distance_reference[i] + b.m_attenuation[i] * (distance[i] - b.m_distance_reference[i]));
+		break;
+	case DISTANCE_MODEL_LINEAR:
+	case DISTANCE_MODEL_LINEAR_CLAMPED:
+		i = 0;
+
+#ifdef AUD_SPATIAL_SSE
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128 reference = _mm_loadu_ps(&b.m_distance_reference[i]);
+			__m128 d = _mm_loadu_ps(&distance[i]);
+			__m128 temp = _mm_sub_ps(_mm_loadu_ps(&b.m_distance_max[i]), reference);
+
+			__m128 linear = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_div_ps(_mm_mul_ps(_mm_loadu_ps(&b.m_attenuation[i]), _mm_sub_ps(d, reference)), temp));
+			__m128 step = _mm_andnot_ps(_mm_cmpgt_ps(d, reference), _mm_set1_ps(1.0f));
+
+			_mm_storeu_ps(&gain[i], selectSSE(_mm_cmpeq_ps(temp, _mm_setzero_ps()), step, linear));
+		}
+#endif
+
+		for(; i < count; i++)
+		{
+			float temp = b.m_distance_max[i] - b.m_distance_reference[i];
+
+			if(temp == 0)
+				gain[i] = distance[i] > b.m_distance_reference[i] ? 0.0f : 1.0f;
+			else
+				gain[i] = 1.0f - b.m_attenuation[i] * (distance[i] - b.m_distance_reference[i]) / temp;
+		}
+		break;
+	case DISTANCE_MODEL_EXPONENT:
+	case DISTANCE_MODEL_EXPONENT_CLAMPED:
+		// there is no vector version of std::pow
+		for(i = 0; i < count; i++)
+			gain[i] = b.m_distance_reference[i] == 0 ? 0 : std::pow(distance[i] / b.m_distance_reference[i], -b.m_attenuation[i]);
+		break;
+	default:
+		std::fill(gain.begin(), gain.begin() + count, 1.0f);
+	}
+
+	for(i = 0; i < count; i++)
+		gain[i] = (b.m_flags[i] & RENDER_DISTANCE) ? gain[i] : 1.0f;
+
+	// Cone, the cosine of the angle is computed for all handles, but only those rendered with a cone need std::acos
+
+	i = 0;
+
+#ifdef AUD_SPATIAL_SSE
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 look_x = _mm_loadu_ps(&b.m_look_x[i]);
+		__m128 look_y = _mm_loadu_ps(&b.m_look_y[i]);
+		__m128 look_z = _mm_loadu_ps(&b.m_look_z[i]);
+
+		__m128 sz_length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(look_x, look_x), _mm_mul_ps(look_y, look_y)), _mm_mul_ps(look_z, look_z)));
+		__m128 sz_sl = _mm_add_ps(_mm_add_ps(_mm_mul_ps(look_x, _mm_loadu_ps(&b.m_sl_x[i])), _mm_mul_ps(look_y, _mm_loadu_ps(&b.m_sl_y[i]))), _mm_mul_ps(look_z, _mm_loadu_ps(&b.m_sl_z[i])));
+
+		_mm_storeu_ps(&b.m_cone[i], _mm_div_ps(sz_sl, _mm_mul_ps(sz_length, _mm_loadu_ps(&b.m_distance[i]))));
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		float sz_length = std::sqrt(b.m_look_x[i] * b.m_look_x[i] + b.m_look_y[i] * b.m_look_y[i] + b.m_look_z[i] * b.m_look_z[i]);
+		float sz_sl = b.m_look_x[i] * b.m_sl_x[i] + b.m_look_y[i] * b.m_sl_y[i] + b.m_look_z[i] * b.m_sl_z[i];
+
+		b.m_cone[i] = sz_sl / (sz_length * b.m_distance[i]);
+	}
+
+	for(i = 0; i < count; i++)
+	{
+		if(b.m_flags[i] & RENDER_CONE)
+			b.m_cone[i] = std::acos(b.m_cone[i]);
+	}
+
+	i = 0;
+
+#ifdef AUD_SPATIAL_SSE
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 inner = _mm_loadu_ps(&b.m_cone_angle_inner[i]);
+		__m128 volume_outer = _mm_loadu_ps(&b.m_cone_volume_outer[i]);
+
+		__m128 t = _mm_div_ps(_mm_sub_ps(_mm_loadu_ps(&b.m_cone[i]), inner), _mm_sub_ps(_mm_loadu_ps(&b.m_cone_angle_outer[i]), inner));
+		__m128 cone = selectSSE(_mm_cmpgt_ps(t, _mm_set1_ps(1.0f)), volume_outer, _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(t, _mm_sub_ps(volume_outer, _mm_set1_ps(1.0f)))));
+		__m128 apply = _mm_and_ps(flagMaskSSE(&b.m_flags[i], RENDER_CONE), _mm_cmpgt_ps(t, _mm_setzero_ps()));
+
+		_mm_storeu_ps(&gain[i], selectSSE(apply, _mm_mul_ps(_mm_loadu_ps(&gain[i]), cone), _mm_loadu_ps(&gain[i])));
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		if(!(b.m_flags[i] & RENDER_CONE))
+			continue;
+
+		float t = (b.m_cone[i] - b.m_cone_angle_inner[i]) / (b.m_cone_angle_outer[i] - b.m_cone_angle_inner[i]);
+
+		if(t > 0)
+		{
+			if(t > 1)
+				gain[i] *= b.m_cone_volume_outer[i];
+			else
+				gain[i] *= 1 + t * (b.m_cone_volume_outer[i] - 1);
+		}
+	}
+
+	// Volume
+
+	i = 0;
+
+#ifdef AUD_SPATIAL_SSE
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 g = _mm_loadu_ps(&gain[i]);
+		__m128 volume_min = _mm_loadu_ps(&b.m_volume_min[i]);
+		__m128 volume_max = _mm_loadu_ps(&b.m_volume_max[i]);
+
+		__m128 volume = selectSSE(_mm_cmpgt_ps(g, volume_max), volume_max, selectSSE(_mm_cmplt_ps(g, volume_min), volume_min, g));
+
+		_mm_storeu_ps(&b.m_volume[i], selectSSE(flagMaskSSE(&b.m_flags[i], RENDER_VOLUME), _mm_mul_ps(volume, _mm_loadu_ps(&b.m_user_volume[i])), _mm_loadu_ps(&b.m_volume[i])));
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		float volume = gain[i];
+
+		if(volume > b.m_volume_max[i])
+			volume = b.m_volume_max[i];
+		else if(volume < b.m_volume_min[i])
+			volume = b.m_volume_min[i];
+
+		if(b.m_flags[i] & RENDER_VOLUME)
+			b.m_volume[i] = volume * b.m_user_volume[i];
+	}
+
+	// 3D Cue
+
+	Quaternion relative_orientation;
+
+	const Vector3 Z[2] = {m_orientation.getLookAt(), relative_orientation.getLookAt()};
+	const Vector3 N[2] = {m_orientation.getUp(), relative_orientation.getUp()};
+	const Vector3 NZ[2] = {N[0].cross(Z[0]), N[1].cross(Z[1])};
+	const float NN[2] = {N[0] * N[0], N[1] * N[1]};
+	const float Z_length[2] = {Z[0].length(), Z[1].length()};
+	const float N_length[2] = {N[0].length(), N[1].length()};
+
+	for(int i = 0; i < count; i++)
+	{
+		int r = b.m_relative[i] ? 1 : 0;
+
+		float projection = (b.m_sl_x[i] * N[r].x() + b.m_sl_y[i] * N[r].y() + b.m_sl_z[i] * N[r].z()) / NN[r];
+
+		float a_x = N[r].x() * projection - b.m_sl_x[i];
+		float a_y = N[r].y() * projection - b.m_sl_y[i];
+		float a_z = N[r].z() * projection - b.m_sl_z[i];
+
+		float a_square = a_x * a_x + a_y * a_y + a_z * a_z;
+		float height = -projection * N_length[r];
+
+		if(a_square + height * height > 0)
+			b.m_height[i] = height / std::sqrt(a_square + height * height);
+		else
+			b.m_height[i] = 0;
+
+		if(a_square > 0)
+		{
+			float phi = std::acos(float((Z[r].x() * a_x + Z[r].y() * a_y + Z[r].z() * a_z) / (Z_length[r] * std::sqrt(a_square))));
+
+			if(NZ[r].x() * a_x + NZ[r].y() * a_y + NZ[r].z() * a_z > 0)
+				phi = -phi;
+
+			b.m_angle[i] = phi;
+		}
+		else
+			b.m_angle[i] = r ? b.m_user_pan[i] * M_PI / 2.0 : 0;
+	}
+
+	// scatter
+
+	for(int i = 0; i < count; i++)
+	{
+		SoftwareHandle* sound = b.m_handles[i];
+
+		sound->m_pitch->setPitch(b.m_pitch[i]);
+		sound->m_volume = b.m_volume[i];
+
+		// we don't know a previous volume if this source has never been read before
+		if(sound->m_first_reading)
+		{
+			sound->m_old_volume = sound->m_volume;
+			sound->m_first_reading = false;
+		}
+
+		sound->m_angle = b.m_angle[i];
+		sound->m_height = b.m_height[i];
+	}
+}
+
+void SoftwareDevice::setPanning(IHandle* handle, float pan)
+{
+	SoftwareDevice::SoftwareHandle* h = dynamic_cast<SoftwareDevice::SoftwareHandle*>(handle);
+	h->m_user_pan = pan;
+}
+
+void SoftwareDevice::setPriority(IHandle* handle, int priority)
+{
+	SoftwareDevice::SoftwareHandle* h = dynamic_cast<SoftwareDevice::SoftwareHandle*>(handle);
+	h->m_priority = priority;
+}
+
+bool SoftwareDevice::setBus(IHandle* handle, std::shared_ptr<SubmixBus> bus)
+{
+	SoftwareDevice::SoftwareHandle* h = dynamic_cast<SoftwareDevice::SoftwareHandle*>(handle);
+
+	if(!h || (bus && bus->m_device != h->m_device))
+		return false;
+
+	std::lock_guard<ILockable> lock(*h->m_device);
+
+	if(h->m_bus != bus)
+		h->m_first_encoding = true;
+
+	h->m_bus = bus;
+
+	return true;
+}
+
+void SoftwareDevice::setQuality(ResampleQuality quality)
+{
+	std::lock_guard<ILockable> lock(*this);
+
+	// pooled handles use the resampler of the old quality
+	if(quality != m_quality)
+	{
+		m_pooledSounds.clear();
+		m_pooledBufferSounds.clear();
+	}
+
+	m_quality = quality;
+}
+
+bool SoftwareDevice::isDithering()
+{
+	std::lock_guard<ILockable> lock(*this);
+
+	return m_mixer->isDithering();
+}
+
+void SoftwareDevice::setDithering(bool dither)
+{
+	std::lock_guard<ILockable> lock(*this);
+
+	m_mixer->setDithering(dither);
+}
+
+void SoftwareDevice::setStatisticsEnabled(bool enabled)
+{
+	m_statistics = enabled;
+}
+
+bool SoftwareDevice::isStatisticsEnabled() const
+{
+	return m_statistics;
+}
+
+DeviceStatistics SoftwareDevice::getStatistics() const
+{
+	DeviceStatistics statistics;
+
+	statistics.mixes = m_mixTime.getCount();
+	statistics.mix_time_mean = m_mixTime.getMean() * 1e-9;
+	statistics.mix_time_median = m_mixTime.getPercentile(0.5) * 1e-9;
+	statistics.mix_time_p99 = m_mixTime.getPercentile(0.99) * 1e-9;
+	statistics.mix_time_max = m_mixTime.getMaximum() * 1e-9;
+	statistics.voices_mean = m_mixVoices.getMean();
+	statistics.voices_max = int(m_mixVoices.getMaximum());
+	statistics.callbacks = m_callbackInterval.getCount();
+	statistics.interval_mean = m_callbackInterval.getMean() * 1e-9;
+	statistics.jitter_p99 = m_callbackJitter.getPercentile(0.99) * 1e-9;
+	statistics.jitter_max = m_callbackJitter.getMaximum() * 1e-9;
+	statistics.fill_mean = m_callbackFill.getCount() ? float(m_callbackFill.getMean() / 1000) : 1.0f;
+	statistics.fill_min = m_callbackFill.getCount() ? m_callbackFill.getMinimum() / 1000.0f : 1.0f;
+	statistics.underruns = m_underruns;
+
+	return statistics;
+}
+
+void SoftwareDevice::resetStatistics()
+{
+	m_mixTime.reset();
+	m_mixVoices.reset();
+	m_callbackInterval.reset();
+	m_callbackJitter.reset();
+	m_callbackFill.reset();
+	m_underruns = 0;
+}
+
+void SoftwareDevice::setOfflineRendering(bool offline)
+{
+	std::lock_guard<ILockable> lock(*this);
+
+	m_offline = offline;
+}
+
+void SoftwareDevice::updateDeviceBuffers(Specs specs)
+{
+	std::vector<std::shared_ptr<DeviceBuffer>> buffers;
+
+	{
+		std::lock_guard<std::mutex> lock(m_deviceBuffersMutex);
+
+		for(auto it = m_deviceBuffers.begin(); it != m_deviceBuffers.end();)
+		{
+			std::shared_ptr<DeviceBuffer> buffer = it->lock();
+
+			if(buffer)
+			{
+				buffers.push_back(buffer);
+				it++;
+			}
+			else
+				it = m_deviceBuffers.erase(it);
+		}
+	}
+
+	// the conversions run without any lock, handles keep playing the previous data
+	for(auto& buffer : buffers)
+		buffer->setSpecs(specs);
+}
+
+std::shared_ptr<SoftwareDevice::SoftwareHandle> SoftwareDevice::createHandle(std::shared_ptr<IReader> reader, std::shared_ptr<BufferReader> buffer_source, bool keep)
+{
+	// prepare the reader
+	// pitch
+
+	std::shared_ptr<PitchReader> pitch = std::shared_ptr<PitchReader>(new PitchReader(reader, 1));
+	reader = std::shared_ptr<IReader>(pitch);
+
+	std::shared_ptr<ResampleReader> resampler;
+
+	// resample
+	if (m_quality == ResampleQuality::FASTEST)
 	{
 		resampler = std::shared_ptr<ResampleReader>(new LinearResampleReader(reader, m_specs.rate));
 	}
@@ -897,15 +1923,89 @@ std::shared_ptr<IHandle> SoftwareDevice::play(std::shared_ptr<IReader> reader, b
 	std::shared_ptr<ChannelMapperReader> mapper = std::shared_ptr<ChannelMapperReader>(new ChannelMapperReader(reader, m_specs.channels));
 	reader = std::shared_ptr<IReader>(mapper);
 
+	return std::shared_ptr<SoftwareDevice::SoftwareHandle>(new SoftwareDevice::SoftwareHandle(this, reader, pitch, resampler, mapper, buffer_source, keep));
+}
+
+std::shared_ptr<IHandle> SoftwareDevice::playHandle(std::shared_ptr<IReader> reader, std::shared_ptr<StreamBuffer> buffer, bool keep, uint64_t start)
+{
+	// sounds in memory can bypass the reader chain if they match the device
+	// when profiling, the handle's profile node records these reads instead of the profile reader
+	std::shared_ptr<ProfileReader> profile = std::dynamic_pointer_cast<ProfileReader>(reader);
+	std::shared_ptr<BufferReader> buffer_source = std::dynamic_pointer_cast<BufferReader>(profile ? profile->getReader() : reader);
+	std::shared_ptr<SoftwareDevice::SoftwareHandle> sound;
+
+	{
+		std::lock_guard<ILockable> lock(*this);
+
+		// prefer handles with a buffer reader for buffers
+		auto* pool = buffer ? &m_pooledBufferSounds : &m_pooledSounds;
+		auto found = findPooledHandle(*pool);
+
+		if(found == pool->end())
+		{
+			pool = buffer ? &m_pooledSounds : &m_pooledBufferSounds;
+			found = findPooledHandle(*pool);
+		}
+
+		if(found != pool->end())
+		{
+			sound = *found;
+
+			if(buffer)
+			{
+				buffer_source = sound->m_buffer_source;
+
+				if(buffer_source)
+					buffer_source->setBuffer(buffer->getBuffer(), buffer->getSpecs());
+				else
+					buffer_source = std::shared_ptr<BufferReader>(new BufferReader(buffer->getBuffer(), buffer->getSpecs()));
+
+				reader = buffer_source;
+			}
+
+			sound->reuse(reader, buffer_source, keep);
+
+			// scheduled sounds keep the device running so that the clock advances
+			if(start > m_clock)
+			{
+				sound->m_start_sample = start;
+				m_scheduledSounds.splice(getSchedulePosition(start), *pool, found);
+			}
+			else
+				m_playingSounds.splice(m_playingSounds.end(), *pool, found);
+
+			reserveSounds();
+
+			if(!m_playback)
+				playing(m_playback = true);
+
+			return std::shared_ptr<IHandle>(sound);
+		}
+	}
+
+	if(buffer)
+	{
+		buffer_source = std::shared_ptr<BufferReader>(new BufferReader(buffer->getBuffer(), buffer->getSpecs()));
+		reader = buffer_source;
+	}
+
 	if(!reader.get())
 		return std::shared_ptr<IHandle>();
 
 	// play sound
-	std::shared_ptr<SoftwareDevice::SoftwareHandle> sound = std::shared_ptr<SoftwareDevice::SoftwareHandle>(new SoftwareDevice::SoftwareHandle(this, reader, pitch, resampler, mapper, keep));
+	sound = createHandle(reader, buffer_source, keep);
 
 	std::lock_guard<ILockable> lock(*this);
 
-	m_playingSounds.push_back(sound);
+	if(start > m_clock)
+	{
+		sound->m_start_sample = start;
+		m_scheduledSounds.insert(getSchedulePosition(start), sound);
+	}
+	else
+		m_playingSounds.push_back(sound);
+
+	reserveSounds();
 
 	if(!m_playback)
 		playing(m_playback = true);
@@ -913,9 +2013,342 @@ std::shared_ptr<IHandle> SoftwareDevice::play(std::shared_ptr<IReader> reader, b
 	return std::shared_ptr<IHandle>(sound);
 }
 
+std::list<std::shared_ptr<SoftwareDevice::SoftwareHandle> >::iterator SoftwareDevice::getSchedulePosition(uint64_t start)
+{
+	return std::find_if(m_scheduledSounds.begin(), m_scheduledSounds.end(), [start](const std::shared_ptr<SoftwareHandle>& sound)
+	{
+		return sound->m_start_sample > start;
+	});
+}
+
+void SoftwareDevice::addDeviceBuffer(std::shared_ptr<DeviceBuffer> buffer)
+{
+	Specs specs;
+
+	{
+		std::lock_guard<ILockable> lock(*this);
+
+		specs = m_specs.specs;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_deviceBuffersMutex);
+
+		m_deviceBuffers.push_back(buffer);
+	}
+
+	buffer->setSpecs(specs);
+}
+
+int SoftwareDevice::getMaximumVoices() const
+{
+	return m_max_voices;
+}
+
+void SoftwareDevice::setMaximumVoices(int count)
+{
+	m_max_voices = count;
+}
+
+float SoftwareDevice::getVirtualizationVolume() const
+{
+	return m_virtual_volume;
+}
+
+void SoftwareDevice::setVirtualizationVolume(float volume)
+{
+	m_virtual_volume = volume;
+}
+
+int SoftwareDevice::getRealVoiceCount() const
+{
+	return m_real_voices;
+}
+
+int SoftwareDevice::getVirtualVoiceCount() const
+{
+	return m_virtual_voices;
+}
+
+std::shared_ptr<SubmixBus> SoftwareDevice::createBus(std::shared_ptr<SubmixBus> parent)
+{
+	if(parent && parent->m_device != this)
+		AUD_THROW(StateException, "The parent bus belongs to another device.");
+
+	std::lock_guard<ILockable> lock(*this);
+
+	std::shared_ptr<SubmixBus> bus = SubmixBus::create(this, parent, m_specs.specs);
+
+	m_buses.push_back(bus);
+	m_mixBuses.reserve(m_buses.size());
+
+	return bus;
+}
+
+std::shared_ptr<SubmixBus> SoftwareDevice::createAmbisonicsBus(std::shared_ptr<AmbisonicsDecoder> decoder, std::shared_ptr<SubmixBus> parent)
+{
+	if(parent && parent->m_device != this)
+		AUD_THROW(StateException, "The parent bus belongs to another device.");
+
+	std::lock_guard<ILockable> lock(*this);
+
+	std::shared_ptr<SubmixBus> bus = SubmixBus::create(this, parent, m_specs.specs, decoder);
+
+	m_buses.push_back(bus);
+	m_mixBuses.reserve(m_buses.size());
+
+	return bus;
+}
+
+void SoftwareDevice::poolHandle(std::list<std::shared_ptr<SoftwareHandle> >& list, std::list<std::shared_ptr<SoftwareHandle> >::iterator it)
+{
+	if(m_pooledSounds.size() + m_pooledBufferSounds.size() >= size_t(m_poolSize))
+	{
+		list.erase(it);
+		return;
+	}
+
+	auto& pool = (*it)->m_buffer_source ? m_pooledBufferSounds : m_pooledSounds;
+
+	pool.splice(pool.end(), list, it);
+}
+
+std::list<std::shared_ptr<SoftwareDevice::SoftwareHandle> >::iterator SoftwareDevice::findPooledHandle(std::list<std::shared_ptr<SoftwareHandle> >& pool)
+{
+	// handles that are still referenced can't be reused
+	for(size_t i = 0; i < pool.size() && pool.front().use_count() > 1; i++)
+		pool.splice(pool.end(), pool, pool.begin());
+
+	if(pool.empty() || pool.front().use_count() > 1)
+		return pool.end();
+
+	return pool.begin();
+}
+
+void SoftwareDevice::prewarm(int count)
+{
+	std::shared_ptr<Buffer> empty = std::shared_ptr<Buffer>(new Buffer());
+
+	{
+		std::lock_guard<ILockable> lock(*this);
+
+		m_poolSize = std::max(count, DEFAULT_POOL_SIZE);
+	}
+
+	for(int i = getPooledHandleCount(); i < count; i++)
+	{
+		std::shared_ptr<BufferReader> buffer_source = std::shared_ptr<BufferReader>(new BufferReader(empty, m_specs.specs));
+		std::shared_ptr<SoftwareDevice::SoftwareHandle> sound = createHandle(buffer_source, buffer_source, false);
+
+		sound->m_status = STATUS_INVALID;
+		sound->release();
+
+		std::lock_guard<ILockable> lock(*this);
+
+		m_pooledBufferSounds.push_back(sound);
+	}
+}
+
+int SoftwareDevice::getPooledHandleCount()
+{
+	std::lock_guard<ILockable> lock(*this);
+
+	return int(m_pooledSounds.size() + m_pooledBufferSounds.size());
+}
+
+void SoftwareDevice::rescaleClock(SampleRate rate)
+{
+	if(rate == m_specs.rate || m_specs.rate <= 0)
+		return;
+
+	double factor = rate / m_specs.rate;
+
+	m_clock = uint64_t(std::llround(m_clock * factor));
+
+	for(auto list : {&m_playingSounds, &m_pausedSounds, &m_scheduledSounds})
+	{
+		for(auto& sound : *list)
+		{
+			sound->m_start_sample = uint64_t(std::llround(sound->m_start_sample * factor));
+
+			uint64_t stop_sample = sound->m_stop_sample;
+
+			if(stop_sample != std::numeric_limits<uint64_t>::max())
+				sound->m_stop_sample = uint64_t(std::llround(stop_sample * factor));
+		}
+	}
+}
+
+void SoftwareDevice::setSpecs(Specs specs)
+{
+	rescaleClock(specs.rate);
+
+	m_specs.specs = specs;
+	m_mixer->setSpecs(specs);
+
+	for(auto& sound : m_playingSounds)
+	{
+		sound->setSpecs(specs);
+	}
+
+	for(auto& sound : m_pausedSounds)
+	{
+		sound->setSpecs(specs);
+	}
+
+	for(auto& sound : m_scheduledSounds)
+	{
+		sound->setSpecs(specs);
+	}
+
+	for(auto& sound : m_pooledSounds)
+	{
+		sound->setSpecs(specs);
+	}
+
+	for(auto& sound : m_pooledBufferSounds)
+	{
+		sound->setSpecs(specs);
+	}
+
+	for(auto& weak_bus : m_buses)
+	{
+		std::shared_ptr<SubmixBus> bus = weak_bus.lock();
+
+		if(bus)
+			bus->setSpecs(specs);
+	}
+
+	allocateMixing();
+
+	updateDeviceBuffers(m_specs.specs);
+}
+
+void SoftwareDevice::setSpecs(DeviceSpecs specs)
+{
+	rescaleClock(specs.rate);
+
+	m_specs = specs;
+	m_mixer->setSpecs(specs);
+
+	for(auto& sound : m_playingSounds)
+	{
+		sound->setSpecs(specs.specs);
+	}
+
+	for(auto& sound : m_pausedSounds)
+	{
+		sound->setSpecs(specs.specs);
+	}
+
+	for(auto& sound : m_scheduledSounds)
+	{
+		sound->setSpecs(specs.specs);
+	}
+
+	for(auto& sound : m_pooledSounds)
+	{
+		sound->setSpecs(specs.specs);
+	}
+
+	for(auto& sound : m_pooledBufferSounds)
+	{
+		sound->setSpecs(specs.specs);
+	}
+
+	for(auto& weak_bus : m_buses)
+	{
+		std::shared_ptr<SubmixBus> bus = weak_bus.lock();
+
+		if(bus)
+			bus->setSpecs(specs.specs);
+	}
+
+	allocateMixing();
+
+	updateDeviceBuffers(m_specs.specs);
+}
+
+SoftwareDevice::SoftwareDevice()
+{
+}
+
+DeviceSpecs SoftwareDevice::getSpecs() const
+{
+	return m_specs;
+}
+
+std::shared_ptr<IHandle> SoftwareDevice::play(std::shared_ptr<IReader> reader, bool keep)
+{
+	return playHandle(reader, nullptr, keep);
+}
+
 std::shared_ptr<IHandle> SoftwareDevice::play(std::shared_ptr<ISound> sound, bool keep)
 {
-	return play(sound->createReader(), keep);
+	return playAt(sound, 0, keep);
+}
+
+std::shared_ptr<IHandle> SoftwareDevice::playAt(std::shared_ptr<ISound> sound, double time, bool keep)
+{
+	uint64_t start = time > 0 ? uint64_t(std::llround(time * m_specs.rate)) : 0;
+
+	// sounds in memory can be played from the pool without creating a reader
+	std::shared_ptr<StreamBuffer> buffer = std::dynamic_pointer_cast<StreamBuffer>(sound);
+	std::shared_ptr<DeviceBuffer> device_buffer = std::dynamic_pointer_cast<DeviceBuffer>(sound);
+
+	if(device_buffer)
+		buffer = device_buffer->getCurrentBuffer();
+
+	if(buffer)
+		return playHandle(nullptr, buffer, keep, start);
+
+	std::shared_ptr<IReader> reader;
+
+	{
+		OfflineRender scope(m_offline);
+		reader = Profiler::createReader(sound);
+	}
+
+	return playHandle(reader, nullptr, keep, start);
+}
+
+std::shared_ptr<IHandle> SoftwareDevice::playAt(std::shared_ptr<IReader> reader, double time, bool keep)
+{
+	return playHandle(reader, nullptr, keep, time > 0 ? uint64_t(std::llround(time * m_specs.rate)) : 0);
+}
+
+bool SoftwareDevice::stopAt(std::shared_ptr<IHandle> handle, double time)
+{
+	std::shared_ptr<SoftwareHandle> sound = std::dynamic_pointer_cast<SoftwareHandle>(handle);
+
+	if(!sound || sound->m_device != this || !sound->m_status)
+		return false;
+
+	sound->m_stop_sample = time > 0 ? uint64_t(std::llround(time * m_specs.rate)) : 0;
+
+	return true;
+}
+
+std::shared_ptr<ProfileNode> SoftwareDevice::getProfile(std::shared_ptr<IHandle> handle)
+{
+	std::shared_ptr<SoftwareHandle> sound = std::dynamic_pointer_cast<SoftwareHandle>(handle);
+
+	if(!sound || sound->m_device != this)
+		return nullptr;
+
+	std::lock_guard<ILockable> lock(*this);
+
+	return sound->m_profile;
+}
+
+double SoftwareDevice::getLatency()
+{
+	return 0;
+}
+
+double SoftwareDevice::getClock() const
+{
+	return m_clock / m_specs.rate;
 }
 
 void SoftwareDevice::stopAll()
@@ -927,6 +2360,9 @@ void SoftwareDevice::stopAll()
 
 	while(!m_pausedSounds.empty())
 		m_pausedSounds.front()->stop();
+
+	while(!m_scheduledSounds.empty())
+		m_scheduledSounds.front()->stop();
 }
 
 void SoftwareDevice::lock()
@@ -0,0 +1,337 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "devices/SubmixBus.h"
+#include "devices/SoftwareDevice.h"
+#include "fx/AmbisonicsDecoder.h"
+#include "respec/Mixer.h"
+#include "Exception.h"
+#include "IReader.h"
+#include "ISound.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+
+AUD_NAMESPACE_BEGIN
+
+/**
+ * Reads the samples of the current mix of a bus.
+ */
+class SubmixBus::InputReader : public IReader
+{
+private:
+	/// The bus to read from, the reader is silent once the bus is destroyed.
+	std::weak_ptr<SubmixBus> m_bus;
+
+	/// The specification of the bus when the reader was created.
+	Specs m_specs;
+
+	/// The number of the mix the position belongs to.
+	unsigned int m_mix;
+
+	/// The position within the current mix.
+	int m_position;
+
+	// delete copy constructor and operator=
+	InputReader(const InputReader&) = delete;
+	InputReader& operator=(const InputReader&) = delete;
+
+public:
+	InputReader(std::shared_ptr<SubmixBus> bus) :
+		m_bus(bus), m_specs(bus->m_mixer->getSpecs().specs), m_mix(bus->m_mix), m_position(0)
+	{
+	}
+
+	virtual bool isSeekable() const
+	{
+		return false;
+	}
+
+	virtual void seek([[maybe_unused]] int position)
+	{
+	}
+
+	virtual int getLength() const
+	{
+		return -1;
+	}
+
+	virtual int getPosition() const
+	{
+		return m_position;
+	}
+
+	virtual Specs getSpecs() const
+	{
+		std::shared_ptr<SubmixBus> bus = m_bus.lock();
+
+		return bus ? bus->m_mixer->getSpecs().specs : m_specs;
+	}
+
+	virtual void read(int& length, bool& eos, sample_t* buffer)
+	{
+		std::shared_ptr<SubmixBus> bus = m_bus.lock();
+
+		if(!bus)
+		{
+			length = 0;
+			eos = true;
+			return;
+		}
+
+		if(m_mix != bus->m_mix)
+		{
+			m_mix = bus->m_mix;
+			m_position = 0;
+		}
+
+		int channels = bus->m_mixer->getSpecs().channels;
+		int len = std::max(0, std::min(length, bus->m_length - m_position));
+
+		std::memcpy(buffer, bus->m_mixer->getBuffer() + m_position * channels, len * channels * sizeof(sample_t));
+
+		// effects reading ahead of the mix get silence
+		std::memset(buffer + len * channels, 0, (length - len) * channels * sizeof(sample_t));
+
+		m_position += len;
+		eos = false;
+	}
+};
+
+/**
+ * The sound representing the mix of a bus.
+ */
+class SubmixBus::InputSound : public ISound
+{
+private:
+	/// The bus to read from.
+	std::weak_ptr<SubmixBus> m_bus;
+
+	// delete copy constructor and operator=
+	InputSound(const InputSound&) = delete;
+	InputSound& operator=(const InputSound&) = delete;
+
+public:
+	InputSound(std::shared_ptr<SubmixBus> bus) :
+		m_bus(bus)
+	{
+	}
+
+	virtual std::shared_ptr<IReader> createReader()
+	{
+		std::shared_ptr<SubmixBus> bus = m_bus.lock();
+
+		if(!bus)
+			AUD_THROW(StateException, "The submix bus of the input sound has been destroyed.");
+
+		return std::shared_ptr<IReader>(new InputReader(bus));
+	}
+};
+
+SubmixBus::SubmixBus(SoftwareDevice* device, std::shared_ptr<SubmixBus> parent, Specs specs, std::shared_ptr<AmbisonicsDecoder> decoder) :
+	m_device(device), m_parent(parent), m_decoder(decoder), m_decoding(false), m_length(0), m_mix(0), m_volume(1.0f), m_old_volume(1.0f), m_time(0), m_last_time(0)
+{
+	DeviceSpecs mixer_specs;
+	mixer_specs.specs = specs;
+	mixer_specs.format = FORMAT_FLOAT32;
+
+	if(m_decoder)
+	{
+		m_decoder->setSpecs(specs);
+		m_decoding = true;
+	}
+
+	m_mixer = std::shared_ptr<Mixer>(new Mixer(mixer_specs));
+}
+
+std::shared_ptr<SubmixBus> SubmixBus::create(SoftwareDevice* device, std::shared_ptr<SubmixBus> parent, Specs specs, std::shared_ptr<AmbisonicsDecoder> decoder)
+{
+	std::shared_ptr<SubmixBus> bus = std::shared_ptr<SubmixBus>(new SubmixBus(device, parent, specs, decoder));
+
+	// the input only references the bus weakly, readers of it outliving the bus are silent
+	bus->m_input = std::shared_ptr<ISound>(new InputSound(bus));
+
+	return bus;
+}
+
+SubmixBus::~SubmixBus()
+{
+}
+
+void SubmixBus::setSpecs(Specs specs)
+{
+	m_mixer->setSpecs(specs);
+
+	if(m_decoder)
+	{
+		try
+		{
+			m_decoder->setSpecs(specs);
+			m_decoding = true;
+		}
+		catch(Exception&)
+		{
+			// the sound field stays silent
+			m_decoding = false;
+		}
+	}
+
+	if(m_effect)
+	{
+		try
+		{
+			m_reader = m_effect->createReader();
+		}
+		catch(Exception&)
+		{
+			// the mix passes the bus unprocessed
+			m_reader = nullptr;
+		}
+	}
+}
+
+void SubmixBus::clear(int length)
+{
+	m_mixer->clear(length);
+	m_length = length;
+
+	if(m_decoder)
+	{
+		int size = length * m_decoder->getChannels() * sizeof(sample_t);
+
+		m_ambisonics.assureSize(size);
+		std::memset(m_ambisonics.getBuffer(), 0, size);
+	}
+
+	m_mix++;
+	m_time = 0;
+}
+
+void SubmixBus::encode(sample_t* buffer, int start, int length, const float* coefficients_to, const float* coefficients_from)
+{
+	const int channels = m_decoder->getChannels();
+	sample_t* out = m_ambisonics.getBuffer() + start * channels;
+
+	length = std::min(m_length, length + start) - start;
+
+	for(int i = 0; i < length; i++)
+	{
+		float t = i / float(length);
+
+		for(int k = 0; k < channels; k++)
+			out[i * channels + k] += buffer[i] * (coefficients_from[k] * (1.0f - t) + coefficients_to[k] * t);
+	}
+}
+
+void SubmixBus::addTime(double time)
+{
+	m_time += time;
+}
+
+void SubmixBus::process(Mixer& target, bool timing)
+{
+	std::chrono::steady_clock::time_point start;
+
+	if(timing)
+		start = std::chrono::steady_clock::now();
+
+	sample_t* buffer = m_mixer->getBuffer();
+	int length = m_length;
+
+	if(m_decoding)
+		m_decoder->decode(m_ambisonics.getBuffer(), buffer, length);
+
+	if(m_reader)
+	{
+		bool eos;
+
+		m_buffer.assureSize(m_length * AUD_SAMPLE_SIZE(m_mixer->getSpecs()));
+		buffer = m_buffer.getBuffer();
+
+		m_reader->read(length, eos, buffer);
+	}
+
+	float volume = m_volume;
+
+	target.mix(buffer, 0, length, volume, m_old_volume);
+	m_old_volume = volume;
+
+	if(timing)
+		addTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+	m_last_time = m_time;
+}
+
+std::shared_ptr<SubmixBus> SubmixBus::getParent() const
+{
+	return m_parent;
+}
+
+std::shared_ptr<AmbisonicsDecoder> SubmixBus::getDecoder() const
+{
+	return m_decoder;
+}
+
+std::shared_ptr<ISound> SubmixBus::getInput() const
+{
+	return m_input;
+}
+
+std::shared_ptr<ISound> SubmixBus::getEffect() const
+{
+	return m_effect;
+}
+
+void SubmixBus::setEffect(std::shared_ptr<ISound> effect)
+{
+	std::shared_ptr<IReader> reader;
+
+	if(effect)
+		reader = effect->createReader();
+
+	SoftwareDevice* device = m_device;
+
+	if(!device)
+	{
+		m_effect = effect;
+		m_reader = reader;
+		return;
+	}
+
+	std::lock_guard<ILockable> lock(*device);
+
+	m_effect = effect;
+	m_reader = reader;
+}
+
+float SubmixBus::getVolume() const
+{
+	return m_volume;
+}
+
+void SubmixBus::setVolume(float volume)
+{
+	m_volume = volume;
+}
+
+double SubmixBus::getProcessingTime() const
+{
+	return m_last_time;
+}
+
+AUD_NAMESPACE_END
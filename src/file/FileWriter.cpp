@@ -17,6 +17,7 @@
 #include "file/FileWriter.h"
 #include "file/FileManager.h"
 #include "util/Buffer.h"
+#include "util/PlanarBuffer.h"
 #include "IReader.h"
 #include "Exception.h"
 
@@ -69,36 +70,35 @@ void FileWriter::writeReader(std::shared_ptr<IReader> reader, std::shared_ptr<IW
 
 void FileWriter::writeReader(std::shared_ptr<IReader> reader, std::vector<std::shared_ptr<IWriter> >& writers, unsigned int length, unsigned int buffersize, bool(*callback)(float, void*), void* data)
 {
-	Buffer buffer(buffersize * AUD_SAMPLE_SIZE(reader->getSpecs()));
-	Buffer buffer2(buffersize * sizeof(sample_t));
-	sample_t* buf = buffer.getBuffer();
-	sample_t* buf2 = buffer2.getBuffer();
+	int channels = reader->getSpecs().channels;
+	PlanarBuffer buffer(buffersize, channels);
 
 	int len;
 	bool eos = false;
-	int channels = reader->getSpecs().channels;
 
 	for(unsigned int pos = 0; ((pos < length) || (length <= 0)) && !eos; pos += len)
 	{
 		len = buffersize;
 		if((len > length - pos) && (length > 0))
 			len = length - pos;
-		reader->read(len, eos, buf);
+
+		// planar readers fill the channel buffers without interleaving
+		buffer.read(*reader, len, eos);
 
 		for(int channel = 0; channel < channels; channel++)
 		{
+			sample_t* buf = buffer.getChannel(channel);
+
 			for(int i = 0; i < len; i++)
 			{
 				// clamping!
-				if(buf[i * channels + channel] > 1)
-					buf2[i] = 1;
-				else if(buf[i * channels + channel] < -1)
-					buf2[i] = -1;
-				else
-					buf2[i] = buf[i * channels + channel];
+				if(buf[i] > 1)
+					buf[i] = 1;
+				else if(buf[i] < -1)
+					buf[i] = -1;
 			}
 
-			writers[channel]->write(len, buf2);
+			writers[channel]->write(len, buf);
 		}
 
 		if(callback)
@@ -0,0 +1,265 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "fx/AmbisonicsBinauralDecoder.h"
+#include "Exception.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstring>
+
+#define NUM_EARS 2
+#define NORMALIZATION_DIRECTIONS 72
+#define VIRTUAL_SPEAKERS_PER_CHANNEL 2
+#define GOLDEN_ANGLE 137.50776f
+
+AUD_NAMESPACE_BEGIN
+
+AmbisonicsBinauralDecoder::AmbisonicsBinauralDecoder(int order, std::shared_ptr<HRTF> hrtfs, std::shared_ptr<ThreadPool> threadPool, std::shared_ptr<FFTPlan> plan) :
+	AmbisonicsDecoder(order), m_hrtfs(hrtfs), m_speakers(0), m_L(plan->getSize() / 2), m_position(0), m_channels(CHANNELS_STEREO)
+{
+	if(m_hrtfs->isEmpty())
+		AUD_THROW(StateException, "The provided HRTF object is empty.");
+
+	const int channels = getChannels();
+	const int count = VIRTUAL_SPEAKERS_PER_CHANNEL * channels;
+	const int bins = m_L + 1;
+
+	// virtual speakers on a spherical fibonacci lattice, snapped to the measured HRTFs
+
+	std::vector<std::pair<float, float>> directions;
+	std::vector<std::pair<std::shared_ptr<ImpulseResponse>, std::shared_ptr<ImpulseResponse>>> irs;
+	int parts = 0;
+	int irLength = 0;
+
+	for(int i = 0; i < count; i++)
+	{
+		float azimuth = i * GOLDEN_ANGLE;
+		float elevation = float(std::asin(1.0f - (2 * i + 1) / float(count)) * 180.0 / M_PI);
+
+		auto ir = m_hrtfs->getImpulseResponse(azimuth, elevation);
+
+		if(!ir.first || !ir.second)
+			continue;
+
+		// speakers that snap to the same HRTFs would only duplicate them
+		if(std::find(irs.begin(), irs.end(), ir) != irs.end())
+			continue;
+
+		for(auto& channel : {ir.first->getChannel(0), ir.second->getChannel(0)})
+		{
+			if(channel->size() && int((*channel)[0]->size()) != bins)
+				AUD_THROW(StateException, "The HRTFs have to be processed with a plan of the same size.");
+
+			parts = std::max(parts, int(channel->size()));
+		}
+
+		irLength = std::max(irLength, std::max(ir.first->getLength(), ir.second->getLength()));
+
+		directions.push_back(std::make_pair(azimuth, elevation));
+		irs.push_back(ir);
+	}
+
+	m_speakers = directions.size();
+
+	if(!m_speakers || !parts)
+		AUD_THROW(StateException, "The provided HRTF object is empty.");
+
+	// sampling decoder with max-rE weighting
+
+	float weights[AUD_AMBISONICS_CHANNELS(AUD_AMBISONICS_MAX_ORDER)];
+
+	for(int degree = 0; degree <= m_order; degree++)
+		for(int k = degree * degree; k < (degree + 1) * (degree + 1); k++)
+			weights[k] = (2 * degree + 1) * getMaxREWeight(degree);
+
+	std::vector<float> matrix(m_speakers * channels);
+
+	for(int speaker = 0; speaker < m_speakers; speaker++)
+	{
+		float azimuth = float(directions[speaker].first * M_PI / 180.0);
+		float elevation = float(directions[speaker].second * M_PI / 180.0);
+		float* row = &matrix[speaker * channels];
+
+		// the azimuth of the HRTFs goes clockwise
+		AmbisonicsDecoder::encode(m_order, std::cos(elevation) * std::cos(azimuth), -std::cos(elevation) * std::sin(azimuth), std::sin(elevation), row);
+
+		for(int k = 0; k < channels; k++)
+			row[k] *= weights[k];
+	}
+
+	// the virtual speakers add up coherently, so normalize the mean pressure of sources in the horizontal plane
+
+	float coefficients[AUD_AMBISONICS_CHANNELS(AUD_AMBISONICS_MAX_ORDER)];
+	float pressure = 0;
+
+	for(int i = 0; i < NORMALIZATION_DIRECTIONS; i++)
+	{
+		float angle = float(2.0 * M_PI * i / NORMALIZATION_DIRECTIONS);
+
+		AmbisonicsDecoder::encode(m_order, std::cos(angle), std::sin(angle), 0, coefficients);
+
+		for(int speaker = 0; speaker < m_speakers; speaker++)
+			for(int k = 0; k < channels; k++)
+				pressure += matrix[speaker * channels + k] * coefficients[k];
+	}
+
+	if(pressure > 0)
+	{
+		for(float& coefficient : matrix)
+			coefficient *= NORMALIZATION_DIRECTIONS / pressure;
+	}
+
+	// combine the HRTFs of the virtual speakers into the filters of the ambisonic channels
+
+	std::vector<std::shared_ptr<std::vector<std::shared_ptr<std::vector<std::complex<sample_t>>>>>> filters;
+
+	for(int i = 0; i < channels * NUM_EARS; i++)
+	{
+		filters.push_back(std::make_shared<std::vector<std::shared_ptr<std::vector<std::complex<sample_t>>>>>());
+
+		for(int part = 0; part < parts; part++)
+			filters.back()->push_back(std::make_shared<std::vector<std::complex<sample_t>>>(bins));
+	}
+
+	for(int speaker = 0; speaker < m_speakers; speaker++)
+	{
+		auto ears = {irs[speaker].first->getChannel(0), irs[speaker].second->getChannel(0)};
+
+		for(int k = 0; k < channels; k++)
+		{
+			float gain = matrix[speaker * channels + k];
+			int ear = 0;
+
+			for(auto& ir : ears)
+			{
+				auto& filter = *filters[k * NUM_EARS + ear++];
+
+				for(int part = 0; part < int(ir->size()); part++)
+				{
+					std::complex<sample_t>* target = filter[part]->data();
+					const std::complex<sample_t>* source = (*ir)[part]->data();
+
+					for(int bin = 0; bin < bins; bin++)
+						target[bin] += gain * source[bin];
+				}
+			}
+		}
+	}
+
+	for(auto& filter : filters)
+		m_convolvers.push_back(std::unique_ptr<Convolver>(new Convolver(filter, irLength, threadPool, plan)));
+
+	m_input.assureSize(channels * m_L * sizeof(sample_t));
+	m_output.assureSize(NUM_EARS * m_L * sizeof(sample_t));
+	m_temp.assureSize(m_L * sizeof(sample_t));
+
+	reset();
+}
+
+void AmbisonicsBinauralDecoder::process()
+{
+	sample_t* output = m_output.getBuffer();
+	sample_t* temp = m_temp.getBuffer();
+
+	std::memset(output, 0, NUM_EARS * m_L * sizeof(sample_t));
+
+	for(int i = 0; i < int(m_convolvers.size()); i++)
+	{
+		int length = m_L;
+		bool eos;
+
+		m_convolvers[i]->getNext(m_input.getBuffer() + (i / NUM_EARS) * m_L, temp, length, eos);
+
+		sample_t* ear = output + (i % NUM_EARS) * m_L;
+
+		for(int j = 0; j < length; j++)
+			ear[j] += temp[j];
+	}
+}
+
+void AmbisonicsBinauralDecoder::reset()
+{
+	for(auto& convolver : m_convolvers)
+		convolver->reset();
+
+	std::memset(m_input.getBuffer(), 0, m_input.getSize());
+	std::memset(m_output.getBuffer(), 0, m_output.getSize());
+
+	m_position = 0;
+}
+
+int AmbisonicsBinauralDecoder::getVirtualSpeakerCount() const
+{
+	return m_speakers;
+}
+
+void AmbisonicsBinauralDecoder::setSpecs(Specs specs)
+{
+	if(specs.rate != m_hrtfs->getSpecs().rate)
+		AUD_THROW(StateException, "The device and the HRTFs must have the same rate.");
+
+	m_channels = specs.channels;
+
+	reset();
+}
+
+void AmbisonicsBinauralDecoder::decode(const sample_t* input, sample_t* output, int length)
+{
+	const int channels = getChannels();
+	sample_t* buffer = m_input.getBuffer();
+	const sample_t* left = m_output.getBuffer();
+	const sample_t* right = left + m_L;
+
+	for(int position = 0; position < length;)
+	{
+		int len = std::min(length - position, m_L - m_position);
+
+		for(int k = 0; k < channels; k++)
+		{
+			sample_t* in = buffer + k * m_L + m_position;
+
+			for(int i = 0; i < len; i++)
+				in[i] = input[(position + i) * channels + k];
+		}
+
+		if(m_channels == CHANNELS_MONO)
+		{
+			for(int i = 0; i < len; i++)
+				output[position + i] += 0.5f * (left[m_position + i] + right[m_position + i]);
+		}
+		else
+		{
+			for(int i = 0; i < len; i++)
+			{
+				output[(position + i) * m_channels] += left[m_position + i];
+				output[(position + i) * m_channels + 1] += right[m_position + i];
+			}
+		}
+
+		position += len;
+		m_position += len;
+
+		if(m_position == m_L)
+		{
+			process();
+			m_position = 0;
+		}
+	}
+}
+
+AUD_NAMESPACE_END
@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "fx/AmbisonicsDecoder.h"
+#include "Exception.h"
+
+#include <cmath>
+
+AUD_NAMESPACE_BEGIN
+
+AmbisonicsDecoder::AmbisonicsDecoder(int order) :
+	m_order(order)
+{
+	if(order < 1 || order > AUD_AMBISONICS_MAX_ORDER)
+		AUD_THROW(StateException, "The ambisonics order is not supported.");
+}
+
+AmbisonicsDecoder::~AmbisonicsDecoder()
+{
+}
+
+float AmbisonicsDecoder::getMaxREWeight(int degree) const
+{
+	float x = std::cos(float(137.9 * M_PI / 180.0) / (m_order + 1.51f));
+
+	switch(degree)
+	{
+	case 0:
+		return 1.0f;
+	case 1:
+		return x;
+	case 2:
+		return 0.5f * (3.0f * x * x - 1.0f);
+	default:
+		return 0.5f * (5.0f * x * x - 3.0f) * x;
+	}
+}
+
+int AmbisonicsDecoder::getOrder() const
+{
+	return m_order;
+}
+
+int AmbisonicsDecoder::getChannels() const
+{
+	return AUD_AMBISONICS_CHANNELS(m_order);
+}
+
+void AmbisonicsDecoder::encode(int order, float x, float y, float z, float* coefficients)
+{
+	coefficients[0] = 1.0f;
+
+	if(order < 1)
+		return;
+
+	coefficients[1] = y;
+	coefficients[2] = z;
+	coefficients[3] = x;
+
+	if(order < 2)
+		return;
+
+	const float sqrt3 = std::sqrt(3.0f);
+
+	coefficients[4] = sqrt3 * x * y;
+	coefficients[5] = sqrt3 * y * z;
+	coefficients[6] = 0.5f * (3.0f * z * z - 1.0f);
+	coefficients[7] = sqrt3 * x * z;
+	coefficients[8] = 0.5f * sqrt3 * (x * x - y * y);
+
+	if(order < 3)
+		return;
+
+	const float a = std::sqrt(5.0f / 8.0f);
+	const float b = std::sqrt(15.0f);
+	const float c = std::sqrt(3.0f / 8.0f);
+
+	coefficients[9] = a * y * (3.0f * x * x - y * y);
+	coefficients[10] = b * x * y * z;
+	coefficients[11] = c * y * (5.0f * z * z - 1.0f);
+	coefficients[12] = 0.5f * z * (5.0f * z * z - 3.0f);
+	coefficients[13] = c * x * (5.0f * z * z - 1.0f);
+	coefficients[14] = 0.5f * b * z * (x * x - y * y);
+	coefficients[15] = a * x * (x * x - 3.0f * y * y);
+}
+
+AUD_NAMESPACE_END
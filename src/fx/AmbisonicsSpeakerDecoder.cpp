@@ -0,0 +1,126 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "fx/AmbisonicsSpeakerDecoder.h"
+#include "respec/ChannelMapperReader.h"
+
+#include <algorithm>
+#include <cmath>
+
+#define NORMALIZATION_DIRECTIONS 72
+
+AUD_NAMESPACE_BEGIN
+
+AmbisonicsSpeakerDecoder::AmbisonicsSpeakerDecoder(int order) :
+	AmbisonicsDecoder(order), m_channels(0)
+{
+}
+
+float AmbisonicsSpeakerDecoder::getCoefficient(int channel, int ambisonic_channel) const
+{
+	return m_matrix[channel * getChannels() + ambisonic_channel];
+}
+
+void AmbisonicsSpeakerDecoder::setSpecs(Specs specs)
+{
+	const int channels = getChannels();
+
+	m_channels = specs.channels;
+	m_matrix.assign(m_channels * channels, 0.0f);
+
+	if(m_channels == CHANNELS_MONO)
+	{
+		m_matrix[0] = 1.0f;
+		return;
+	}
+
+	float weights[AUD_AMBISONICS_CHANNELS(AUD_AMBISONICS_MAX_ORDER)];
+
+	for(int degree = 0; degree <= m_order; degree++)
+		for(int k = degree * degree; k < (degree + 1) * (degree + 1); k++)
+			weights[k] = (2 * degree + 1) * getMaxREWeight(degree);
+
+	int speakers = std::min(m_channels, int(CHANNELS_SURROUND71));
+
+	for(int channel = 0; channel < speakers; channel++)
+	{
+		if(ChannelMapperReader::getChannel(specs.channels, channel) == CHANNEL_LFE)
+			continue;
+
+		float angle = ChannelMapperReader::getChannelAngle(specs.channels, channel);
+		float* row = &m_matrix[channel * channels];
+
+		AmbisonicsDecoder::encode(m_order, std::cos(angle), -std::sin(angle), 0, row);
+
+		for(int k = 0; k < channels; k++)
+			row[k] *= weights[k];
+	}
+
+	// normalize the mean energy of sources in the horizontal plane
+
+	float coefficients[AUD_AMBISONICS_CHANNELS(AUD_AMBISONICS_MAX_ORDER)];
+	float energy = 0;
+
+	for(int i = 0; i < NORMALIZATION_DIRECTIONS; i++)
+	{
+		float angle = float(2.0 * M_PI * i / NORMALIZATION_DIRECTIONS);
+
+		AmbisonicsDecoder::encode(m_order, std::cos(angle), std::sin(angle), 0, coefficients);
+
+		for(int channel = 0; channel < m_channels; channel++)
+		{
+			float gain = 0;
+
+			for(int k = 0; k < channels; k++)
+				gain += m_matrix[channel * channels + k] * coefficients[k];
+
+			energy += gain * gain;
+		}
+	}
+
+	if(energy > 0)
+	{
+		float normalization = 1.0f / std::sqrt(energy / NORMALIZATION_DIRECTIONS);
+
+		for(float& coefficient : m_matrix)
+			coefficient *= normalization;
+	}
+}
+
+void AmbisonicsSpeakerDecoder::decode(const sample_t* input, sample_t* output, int length)
+{
+	const int channels = getChannels();
+	const float* matrix = m_matrix.data();
+
+	for(int i = 0; i < length; i++)
+	{
+		const sample_t* in = input + i * channels;
+		sample_t* out = output + i * m_channels;
+
+		for(int channel = 0; channel < m_channels; channel++)
+		{
+			const float* row = matrix + channel * channels;
+			float sample = 0;
+
+			for(int k = 0; k < channels; k++)
+				sample += row[k] * in[k];
+
+			out[channel] += sample;
+		}
+	}
+}
+
+AUD_NAMESPACE_END
@@ -29,7 +29,7 @@ AnimateableTimeStretchPitchScaleReader::AnimateableTimeStretchPitchScaleReader(s
 {
 }
 
-void AnimateableTimeStretchPitchScaleReader::read(int& length, bool& eos, sample_t* buffer)
+void AnimateableTimeStretchPitchScaleReader::updateAnimation()
 {
 	int position = getPosition();
 
@@ -40,9 +40,20 @@ void AnimateableTimeStretchPitchScaleReader::read(int& length, bool& eos, sample
 	setTimeRatio(timeRatio);
 	float pitchScale = m_pitchScale->readSingle(frame);
 	setPitchScale(pitchScale);
+}
+
+void AnimateableTimeStretchPitchScaleReader::read(int& length, bool& eos, sample_t* buffer)
+{
+	updateAnimation();
 	TimeStretchPitchScaleReader::read(length, eos, buffer);
 }
 
+void AnimateableTimeStretchPitchScaleReader::readPlanar(int& length, bool& eos, sample_t* const* buffers)
+{
+	updateAnimation();
+	TimeStretchPitchScaleReader::readPlanar(length, eos, buffers);
+}
+
 void AnimateableTimeStretchPitchScaleReader::seek(int position)
 {
 	const double sampleRate = double(m_reader->getSpecs().rate);
@@ -15,6 +15,7 @@
  ******************************************************************************/
 
 #include "fx/BaseIIRFilterReader.h"
+#include "util/PlanarBuffer.h"
 
 #include <cstring>
 
@@ -26,11 +27,13 @@ BaseIIRFilterReader::BaseIIRFilterReader(std::shared_ptr<IReader> reader, int in
 	m_xlen(in), m_ylen(out),
 	m_xpos(0), m_ypos(0), m_channel(0)
 {
-	m_x = new sample_t[m_xlen * m_specs.channels];
-	m_y = new sample_t[m_ylen * m_specs.channels];
+	m_x = new sample_t[2 * m_xlen * m_specs.channels];
+	m_y = new sample_t[2 * m_ylen * m_specs.channels];
 
-	std::memset(m_x, 0, sizeof(sample_t) * m_xlen * m_specs.channels);
-	std::memset(m_y, 0, sizeof(sample_t) * m_ylen * m_specs.channels);
+	std::memset(m_x, 0, sizeof(sample_t) * 2 * m_xlen * m_specs.channels);
+	std::memset(m_y, 0, sizeof(sample_t) * 2 * m_ylen * m_specs.channels);
+
+	selectChannel(0);
 }
 
 BaseIIRFilterReader::~BaseIIRFilterReader()
@@ -39,19 +42,28 @@ BaseIIRFilterReader::~BaseIIRFilterReader()
 	delete[] m_y;
 }
 
+void BaseIIRFilterReader::selectChannel(int channel)
+{
+	m_channel = channel;
+	m_xchannel = m_x + (2 * m_channel + 1) * m_xlen;
+	m_ychannel = m_y + (2 * m_channel + 1) * m_ylen;
+}
+
 void BaseIIRFilterReader::setLengths(int in, int out)
 {
 	if(in != m_xlen)
 	{
-		sample_t* xn = new sample_t[in * m_specs.channels];
-		std::memset(xn, 0, sizeof(sample_t) * in * m_specs.channels);
+		sample_t* xn = new sample_t[2 * in * m_specs.channels];
+		std::memset(xn, 0, sizeof(sample_t) * 2 * in * m_specs.channels);
 
-		for(m_channel = 0; m_channel < m_specs.channels; m_channel++)
+		for(int channel = 0; channel < m_specs.channels; channel++)
 		{
+			selectChannel(channel);
+
+			sample_t* history = xn + 2 * channel * in;
+
 			for(int i = 1; i <= in && i <= m_xlen; i++)
-			{
-				xn[(in - i) * m_specs.channels + m_channel] = x(-i);
-			}
+				history[in - i] = history[2 * in - i] = x(-i);
 		}
 
 		delete[] m_x;
@@ -62,15 +74,17 @@ void BaseIIRFilterReader::setLengths(int in, int out)
 
 	if(out != m_ylen)
 	{
-		sample_t* yn = new sample_t[out * m_specs.channels];
-		std::memset(yn, 0, sizeof(sample_t) * out * m_specs.channels);
+		sample_t* yn = new sample_t[2 * out * m_specs.channels];
+		std::memset(yn, 0, sizeof(sample_t) * 2 * out * m_specs.channels);
 
-		for(m_channel = 0; m_channel < m_specs.channels; m_channel++)
+		for(int channel = 0; channel < m_specs.channels; channel++)
 		{
+			selectChannel(channel);
+
+			sample_t* history = yn + 2 * channel * out;
+
 			for(int i = 1; i <= out && i <= m_ylen; i++)
-			{
-				yn[(out - i) * m_specs.channels + m_channel] = y(-i);
-			}
+				history[out - i] = history[2 * out - i] = y(-i);
 		}
 
 		delete[] m_y;
@@ -78,9 +92,11 @@ void BaseIIRFilterReader::setLengths(int in, int out)
 		m_ypos = 0;
 		m_ylen = out;
 	}
+
+	selectChannel(0);
 }
 
-void BaseIIRFilterReader::read(int& length, bool& eos, sample_t* buffer)
+void BaseIIRFilterReader::updateSpecs()
 {
 	Specs specs = m_reader->getSpecs();
 	if(specs.channels != m_specs.channels)
@@ -90,11 +106,13 @@ void BaseIIRFilterReader::read(int& length, bool& eos, sample_t* buffer)
 		delete[] m_x;
 		delete[] m_y;
 
-		m_x = new sample_t[m_xlen * m_specs.channels];
-		m_y = new sample_t[m_ylen * m_specs.channels];
+		m_x = new sample_t[2 * m_xlen * m_specs.channels];
+		m_y = new sample_t[2 * m_ylen * m_specs.channels];
+
+		std::memset(m_x, 0, sizeof(sample_t) * 2 * m_xlen * m_specs.channels);
+		std::memset(m_y, 0, sizeof(sample_t) * 2 * m_ylen * m_specs.channels);
 
-		std::memset(m_x, 0, sizeof(sample_t) * m_xlen * m_specs.channels);
-		std::memset(m_y, 0, sizeof(sample_t) * m_ylen * m_specs.channels);
+		selectChannel(0);
 	}
 
 	if(specs.rate != m_specs.rate)
@@ -102,19 +120,65 @@ void BaseIIRFilterReader::read(int& length, bool& eos, sample_t* buffer)
 		m_specs = specs;
 		sampleRateChanged(m_specs.rate);
 	}
+}
+
+void BaseIIRFilterReader::filterChannel(sample_t* buffer, int stride, int length, int xpos, int ypos)
+{
+	m_xpos = xpos;
+	m_ypos = ypos;
+
+	// the history of each channel is stored twice in a row, so that x() and y() don't need to wrap
+	sample_t* xhistory = m_xchannel - m_xlen;
+	sample_t* yhistory = m_ychannel - m_ylen;
+
+	for(int i = 0; i < length; i++)
+	{
+		if(m_xlen)
+			xhistory[m_xpos] = xhistory[m_xpos + m_xlen] = buffer[i * stride];
+
+		sample_t out = filter();
+		buffer[i * stride] = out;
+
+		if(m_ylen)
+			yhistory[m_ypos] = yhistory[m_ypos + m_ylen] = out;
+
+		if(++m_xpos >= m_xlen)
+			m_xpos = 0;
+		if(++m_ypos >= m_ylen)
+			m_ypos = 0;
+	}
+}
+
+void BaseIIRFilterReader::read(int& length, bool& eos, sample_t* buffer)
+{
+	updateSpecs();
 
 	m_reader->read(length, eos, buffer);
 
-	for(m_channel = 0; m_channel < m_specs.channels; m_channel++)
+	// every channel starts at the same position in the history
+	int xpos = m_xpos;
+	int ypos = m_ypos;
+
+	for(int channel = 0; channel < m_specs.channels; channel++)
 	{
-		for(int i = 0; i < length; i++)
-		{
-			m_x[m_xpos * m_specs.channels + m_channel] = buffer[i * m_specs.channels + m_channel];
-			m_y[m_ypos * m_specs.channels + m_channel] = buffer[i * m_specs.channels + m_channel] = filter();
+		selectChannel(channel);
+		filterChannel(buffer + channel, m_specs.channels, length, xpos, ypos);
+	}
+}
 
-			m_xpos = m_xlen ? (m_xpos + 1) % m_xlen : 0;
-			m_ypos = m_ylen ? (m_ypos + 1) % m_ylen : 0;
-		}
+void BaseIIRFilterReader::readPlanar(int& length, bool& eos, sample_t* const* buffers)
+{
+	updateSpecs();
+
+	PlanarBuffer::read(*m_reader, length, eos, buffers, m_buffer);
+
+	int xpos = m_xpos;
+	int ypos = m_ypos;
+
+	for(int channel = 0; channel < m_specs.channels; channel++)
+	{
+		selectChannel(channel);
+		filterChannel(buffers[channel], 1, length, xpos, ypos);
 	}
 }
 
@@ -22,12 +22,10 @@
 #include <algorithm>
 
 #define NUM_OUTCHANNELS 2
-#define NUM_CONVOLVERS 4
-#define CROSSFADE_SAMPLES 1024
 
 AUD_NAMESPACE_BEGIN
 BinauralReader::BinauralReader(std::shared_ptr<IReader> reader, std::shared_ptr<HRTF> hrtfs, std::shared_ptr<Source> source, std::shared_ptr<ThreadPool> threadPool, std::shared_ptr<FFTPlan> plan) :
-	m_position(0), m_reader(reader), m_hrtfs(hrtfs), m_source(source), m_N(plan->getSize()), m_transition(false), m_transPos(CROSSFADE_SAMPLES*NUM_OUTCHANNELS), m_eosReader(false), m_eosTail(false), m_threadPool(threadPool)
+	m_position(0), m_reader(reader), m_hrtfs(hrtfs), m_source(source), m_plan(plan), m_N(plan->getSize()), m_transition(false), m_parts(1), m_spectrumPos(0), m_outBufferPos(0), m_outBufLen(0), m_tailLength(0), m_eosReader(false), m_eosTail(false), m_threadPool(threadPool)
 {
 	if(m_hrtfs->isEmpty())
 		AUD_THROW(StateException, "The provided HRTF object is empty");
@@ -36,30 +34,39 @@ BinauralReader::BinauralReader(std::shared_ptr<IReader> reader, std::shared_ptr<
 	if(m_reader->getSpecs().rate != m_hrtfs->getSpecs().rate)
 		AUD_THROW(StateException, "The sound and the HRTFs must have the same rate");
 	m_M = m_L = m_N / 2;
-	
+
 	m_RealAzimuth = m_Azimuth = m_source->getAzimuth();
 	m_RealElevation = m_Elevation = m_source->getElevation();
-	auto irs = m_hrtfs->getImpulseResponse(m_RealAzimuth, m_RealElevation);
-	for(unsigned int i = 0; i < NUM_CONVOLVERS; i++)
-		if(i%NUM_OUTCHANNELS==0)
-			m_convolvers.push_back(std::unique_ptr<Convolver>(new Convolver(irs.first->getChannel(0), irs.first->getLength(), m_threadPool, plan)));
-		else
-			m_convolvers.push_back(std::unique_ptr<Convolver>(new Convolver(irs.second->getChannel(0), irs.second->getLength(), m_threadPool, plan)));
-	m_futures.resize(NUM_CONVOLVERS);
-
-	m_outBuffer = (sample_t*)std::malloc(m_L*NUM_OUTCHANNELS*sizeof(sample_t));
-	m_eOutBufLen = m_outBufLen = m_outBufferPos = m_L * NUM_OUTCHANNELS;
-	m_inBuffer = (sample_t*)std::malloc(m_L * sizeof(sample_t));
-	for(int i = 0; i < NUM_CONVOLVERS; i++)
-		m_vecOut.push_back((sample_t*)std::calloc(m_L, sizeof(sample_t)));
+	m_oldImpulseResponses = m_impulseResponses = m_hrtfs->getImpulseResponse(m_RealAzimuth, m_RealElevation);
+
+	// the delay line has to be long enough for the longest HRTF
+	float azimuth, elevation;
+	for(int i = 0; i < m_hrtfs->getCount(); i++)
+		m_parts = std::max(m_parts, int(m_hrtfs->getMeasurement(i, azimuth, elevation)->getChannel(0)->size()));
+
+	m_spectra.resize(m_parts * (m_M + 1));
+	m_fftBuffer = reinterpret_cast<std::complex<sample_t>*>(m_plan->getBuffer());
+	for(int i = 0; i < NUM_OUTCHANNELS; i++)
+	{
+		m_accBuffers.push_back(reinterpret_cast<std::complex<sample_t>*>(m_plan->getBuffer()));
+		m_oldAccBuffers.push_back(reinterpret_cast<std::complex<sample_t>*>(m_plan->getBuffer()));
+	}
+	m_futures.resize(NUM_OUTCHANNELS);
+
+	m_outBuffer = (sample_t*)std::malloc(m_L * NUM_OUTCHANNELS * sizeof(sample_t));
+	m_inBuffer = (sample_t*)std::calloc(m_N, sizeof(sample_t));
 }
 
 BinauralReader::~BinauralReader()
 {
 	std::free(m_outBuffer);
 	std::free(m_inBuffer);
-	for(int i = 0; i < m_vecOut.size(); i++)
-		std::free(m_vecOut[i]);
+	m_plan->freeBuffer(m_fftBuffer);
+	for(int i = 0; i < NUM_OUTCHANNELS; i++)
+	{
+		m_plan->freeBuffer(m_accBuffers[i]);
+		m_plan->freeBuffer(m_oldAccBuffers[i]);
+	}
 }
 
 bool BinauralReader::isSeekable() const
@@ -71,13 +78,13 @@ void BinauralReader::seek(int position)
 {
 	m_position = position;
 	m_reader->seek(position);
-	for(int i = 0; i < NUM_CONVOLVERS; i++)
-		m_convolvers[i]->reset();
+	std::fill(m_spectra.begin(), m_spectra.end(), std::complex<sample_t>(0));
+	std::memset(m_inBuffer, 0, m_N * sizeof(sample_t));
+	m_tailLength = 0;
 	m_eosTail = false;
 	m_eosReader = false;
-	m_outBufferPos = m_eOutBufLen = m_outBufLen;
+	m_outBufferPos = m_outBufLen = 0;
 	m_transition = false;
-	m_transPos = CROSSFADE_SAMPLES*NUM_OUTCHANNELS;
 }
 
 int BinauralReader::getLength() const
@@ -100,55 +107,30 @@ Specs BinauralReader::getSpecs() const
 void BinauralReader::read(int& length, bool& eos, sample_t* buffer)
 {
 	int samples = 0;
-	int iteration = 0;
-	if(length <= 0)
-	{
-		length = 0;
-		eos = (m_eosTail && m_outBufferPos >= m_eOutBufLen);
-		return;
-	}
 
-	eos = false;
-	int writePos = 0;
-	do
+	while(samples < length)
 	{
-		int bufRest = m_eOutBufLen - m_outBufferPos;
-		int writeLength = std::min((length*NUM_OUTCHANNELS) - writePos, m_eOutBufLen + bufRest);
-		if(bufRest < writeLength || (m_eOutBufLen == 0 && m_eosTail))
-		{
-			if(bufRest > 0)
-				std::memcpy(buffer + writePos, m_outBuffer + m_outBufferPos, bufRest*sizeof(sample_t));
-			if(!m_eosTail)
-			{
-				int n = NUM_OUTCHANNELS;
-				if(m_transition)
-					n = NUM_CONVOLVERS;
-				else if(checkSource())
-					n = NUM_CONVOLVERS;
-				loadBuffer(n);
-
-				int len = std::min(std::abs(writeLength - bufRest), m_eOutBufLen);
-				std::memcpy(buffer + writePos + bufRest, m_outBuffer, len*sizeof(sample_t));
-				samples += len;
-				m_outBufferPos = len;
-				writeLength = std::min((length*NUM_OUTCHANNELS) - writePos, m_eOutBufLen + bufRest);
-			}
-			else
-			{
-				m_outBufferPos += bufRest;
-				length = (writePos+bufRest) / NUM_OUTCHANNELS;
-				eos = true;
-				return;
-			}
-		}
-		else
+		if(m_outBufferPos >= m_outBufLen)
 		{
-			std::memcpy(buffer + writePos, m_outBuffer + m_outBufferPos, writeLength*sizeof(sample_t));
-			m_outBufferPos += writeLength;
+			if(m_eosTail)
+				break;
+
+			loadBuffer();
+
+			if(m_outBufLen == 0 && !m_eosTail)
+				break;
+
+			continue;
 		}
-		writePos += writeLength;
-		iteration++;
-	} while(writePos < length*NUM_OUTCHANNELS);
+
+		int len = std::min(length - samples, m_outBufLen - m_outBufferPos);
+		std::memcpy(buffer + samples * NUM_OUTCHANNELS, m_outBuffer + m_outBufferPos * NUM_OUTCHANNELS, len * NUM_OUTCHANNELS * sizeof(sample_t));
+		m_outBufferPos += len;
+		samples += len;
+	}
+
+	length = samples;
+	eos = m_eosTail && m_outBufferPos >= m_outBufLen;
 	m_position += length;
 }
 
@@ -158,98 +140,116 @@ bool BinauralReader::checkSource()
 	{
 		float az = m_Azimuth = m_source->getAzimuth();
 		float el = m_Elevation = m_source->getElevation();
-		auto irs = m_hrtfs->getImpulseResponse(az, el);
 		if(az != m_RealAzimuth || el != m_RealElevation)
 		{
 			m_RealAzimuth = az;
 			m_RealElevation = el;
-			for(int i = 0; i < NUM_OUTCHANNELS; i++)
-			{
-				auto temp = std::move(m_convolvers[i]);
-				m_convolvers[i] = std::move(m_convolvers[i + NUM_OUTCHANNELS]);
-				m_convolvers[i + NUM_OUTCHANNELS] = std::move(temp);
-			}
-			for(int i = 0; i < NUM_OUTCHANNELS; i++)
-				if(i%NUM_OUTCHANNELS == 0)
-					m_convolvers[i]->setImpulseResponse(irs.first->getChannel(0));
-				else
-					m_convolvers[i]->setImpulseResponse(irs.second->getChannel(0));
-
-			m_transPos = CROSSFADE_SAMPLES*NUM_OUTCHANNELS;
-			m_transition = true;
+			m_oldImpulseResponses = m_impulseResponses;
+			m_impulseResponses = m_hrtfs->getImpulseResponse(az, el);
 			return true;
 		}
 	}
 	return false;
 }
 
-void BinauralReader::loadBuffer(int nConvolvers)
+void BinauralReader::loadBuffer()
 {
-	m_lastLengthIn = m_L;
-	m_reader->read(m_lastLengthIn, m_eosReader, m_inBuffer);
-	if(!m_eosReader || m_lastLengthIn > 0)
+	m_transition = checkSource();
+
+	// the input buffer holds the last and the current input slice (overlap-save)
+	std::memmove(m_inBuffer, m_inBuffer + m_L, m_L * sizeof(sample_t));
+
+	int length = 0;
+	if(!m_eosReader)
 	{
-		int len = m_lastLengthIn;
-		for(int i = 0; i < nConvolvers; i++)
-			m_futures[i] = m_threadPool->enqueue(&BinauralReader::threadFunction, this, i, true);
-		for(int i = 0; i < nConvolvers; i++)
-			len = m_futures[i].get();
-
-		joinByChannel(0, len, nConvolvers);
-		m_eOutBufLen = len*NUM_OUTCHANNELS;
+		length = m_L;
+		m_reader->read(length, m_eosReader, m_inBuffer + m_L);
+
+		if(m_eosReader)
+			m_tailLength = std::max(m_impulseResponses.first->getLength(), m_impulseResponses.second->getLength()) - 1;
 	}
-	else if(!m_eosTail)
+	std::memset(m_inBuffer + m_L + length, 0, (m_L - length) * sizeof(sample_t));
+
+	m_outBufLen = length;
+	if(m_eosReader)
 	{
-		int len = m_lastLengthIn = m_L;
-		for(int i = 0; i < nConvolvers; i++)
-			m_futures[i] = m_threadPool->enqueue(&BinauralReader::threadFunction, this, i, false);
-		for(int i = 0; i < nConvolvers; i++)
-			len = m_futures[i].get();
-
-		joinByChannel(0, len, nConvolvers);
-		m_eOutBufLen = len*NUM_OUTCHANNELS;
+		int tail = std::min(m_tailLength, m_L - length);
+		m_outBufLen += tail;
+		m_tailLength -= tail;
+		m_eosTail = m_tailLength <= 0;
 	}
+	m_outBufferPos = 0;
+
+	// one forward FFT per slice, shared by both ears and the old and new impulse responses
+	std::fill(m_fftBuffer, m_fftBuffer + m_M + 1, std::complex<sample_t>(0));
+	std::memcpy(reinterpret_cast<sample_t*>(m_fftBuffer), m_inBuffer, m_N * sizeof(sample_t));
+	m_plan->FFT(m_fftBuffer);
+
+	m_spectrumPos = (m_spectrumPos + m_parts - 1) % m_parts;
+	std::memcpy(&m_spectra[m_spectrumPos * (m_M + 1)], m_fftBuffer, (m_M + 1) * sizeof(std::complex<sample_t>));
+
+	for(int i = 0; i < NUM_OUTCHANNELS; i++)
+		m_futures[i] = m_threadPool->enqueue(&BinauralReader::threadFunction, this, i);
+	for(int i = 0; i < NUM_OUTCHANNELS; i++)
+		m_futures[i].get();
 }
 
-void BinauralReader::joinByChannel(int start, int len, int nConvolvers)
+bool BinauralReader::threadFunction(int ear)
 {
-	int k = 0;
-	float vol = 0;
-	const int l = CROSSFADE_SAMPLES*NUM_OUTCHANNELS;
-	for(int i = 0; i < len*NUM_OUTCHANNELS; i += NUM_OUTCHANNELS)
+	const int bins = m_M + 1;
+	std::complex<sample_t>* acc = m_accBuffers[ear];
+	std::complex<sample_t>* oldAcc = m_oldAccBuffers[ear];
+
+	auto accumulate = [&](const std::shared_ptr<ImpulseResponse>& ir, std::complex<sample_t>* buffer)
 	{
-		if(m_transition)
+		auto irParts = ir->getChannel(0);
+		int parts = std::min(int(irParts->size()), m_parts);
+
+		std::fill(buffer, buffer + bins, std::complex<sample_t>(0));
+		for(int p = 0; p < parts; p++)
 		{
-			vol = (m_transPos - i) / (float)l;
-			if(vol > 1.0f)
-				vol = 1.0f;
-			else if(vol < 0.0f)
-				vol = 0.0f;
+			const std::complex<sample_t>* spectrum = &m_spectra[((m_spectrumPos + p) % m_parts) * bins];
+			const std::complex<sample_t>* response = (*irParts)[p]->data();
+
+			for(int i = 0; i < bins; i++)
+				buffer[i] += spectrum[i] * response[i];
 		}
+	};
+
+	accumulate(ear ? m_impulseResponses.second : m_impulseResponses.first, acc);
 
-		for(int j = 0; j < NUM_OUTCHANNELS; j++)
-			m_outBuffer[i + j + start] = ((m_vecOut[j][k] * (1.0f - vol)) + (m_vecOut[j + NUM_OUTCHANNELS][k] * vol))*m_source->getVolume();
-		k++;
-	}
 	if(m_transition)
 	{
-		m_transPos -= len*NUM_OUTCHANNELS;
-		if(m_transPos <= 0)
+		accumulate(ear ? m_oldImpulseResponses.second : m_oldImpulseResponses.first, oldAcc);
+
+		/*
+		* The fade from the old to the new output is the window w(t) = 0.5 + 0.5 cos(2 pi t / N),
+		* which rises from 0 to 1 over the second half of the block, the part overlap-save outputs.
+		* Its spectrum has only three bins, so old + w * (new - old) is calculated here in the
+		* frequency domain and one inverse FFT per ear is enough even while the source moves.
+		*/
+		for(int i = 0; i < bins; i++)
+			acc[i] -= oldAcc[i];
+
+		std::complex<sample_t> previous = std::conj(acc[1]);
+		for(int i = 0; i < bins; i++)
 		{
-			m_transition = false;
-			m_transPos = l;
+			std::complex<sample_t> current = acc[i];
+			std::complex<sample_t> next = i + 1 < bins ? acc[i + 1] : std::conj(previous);
+			acc[i] = oldAcc[i] + sample_t(0.5f) * current + sample_t(0.25f) * (previous + next);
+			previous = current;
 		}
 	}
-}
 
-int BinauralReader::threadFunction(int id, bool input)
-{
-	int l = m_lastLengthIn;
-	if(input)
-		m_convolvers[id]->getNext(m_inBuffer, m_vecOut[id], l, m_eosTail);
-	else
-		m_convolvers[id]->getNext(nullptr, m_vecOut[id], l, m_eosTail);
-	return l;
+	m_plan->IFFT(acc);
+
+	const sample_t* output = reinterpret_cast<sample_t*>(acc) + m_L;
+	const sample_t volume = m_source->getVolume() / sample_t(m_N);
+
+	for(int i = 0; i < m_outBufLen; i++)
+		m_outBuffer[i * NUM_OUTCHANNELS + ear] = output[i] * volume;
+
+	return true;
 }
 
 AUD_NAMESPACE_END
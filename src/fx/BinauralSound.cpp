@@ -16,6 +16,7 @@
 
 #include "fx/BinauralSound.h"
 #include "fx/BinauralReader.h"
+#include "util/Profiler.h"
 #include "Exception.h"
 
 #include <cstring>
@@ -23,7 +24,7 @@
 AUD_NAMESPACE_BEGIN
 
 BinauralSound::BinauralSound(std::shared_ptr<ISound> sound, std::shared_ptr<HRTF> hrtfs, std::shared_ptr<Source> source, std::shared_ptr<ThreadPool> threadPool) :
-	BinauralSound(sound, hrtfs, source, threadPool, std::make_shared<FFTPlan>(0.0))
+	BinauralSound(sound, hrtfs, source, threadPool, FFTPlan::get())
 {
 }
 
@@ -34,7 +35,7 @@ BinauralSound::BinauralSound(std::shared_ptr<ISound> sound, std::shared_ptr<HRTF
 
 std::shared_ptr<IReader> BinauralSound::createReader()
 {
-	return std::make_shared<BinauralReader>(m_sound->createReader(), m_hrtfs, m_source, m_threadPool, m_plan);
+	return std::make_shared<BinauralReader>(Profiler::createReader(m_sound), m_hrtfs, m_source, m_threadPool, m_plan);
 }
 
 std::shared_ptr<HRTF> BinauralSound::getHRTFs()
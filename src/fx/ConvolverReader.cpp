@@ -16,6 +16,7 @@
 
 #include "fx/ConvolverReader.h"
 #include "Exception.h"
+#include "util/PlanarBuffer.h"
 
 #include <cstring>
 #include <algorithm>
@@ -24,7 +25,7 @@
 
 AUD_NAMESPACE_BEGIN
 ConvolverReader::ConvolverReader(std::shared_ptr<IReader> reader, std::shared_ptr<ImpulseResponse> ir, std::shared_ptr<ThreadPool> threadPool, std::shared_ptr<FFTPlan> plan) :
-	m_position(0), m_reader(reader), m_ir(ir), m_N(plan->getSize()), m_eosReader(false), m_eosTail(false), m_inChannels(reader->getSpecs().channels), m_irChannels(ir->getSpecs().channels), m_threadPool(threadPool)
+	m_position(0), m_reader(reader), m_planarReader(dynamic_cast<IPlanarReader*>(reader.get())), m_ir(ir), m_N(plan->getSize()), m_eosReader(false), m_eosTail(false), m_inChannels(reader->getSpecs().channels), m_irChannels(ir->getSpecs().channels), m_threadPool(threadPool)
 {
 	m_nChannelThreads = std::min((int)threadPool->getNumOfThreads(), m_inChannels);
 	m_futures.resize(m_nChannelThreads);
@@ -135,10 +136,18 @@ void ConvolverReader::read(int& length, bool& eos, sample_t* buffer)
 void ConvolverReader::loadBuffer()
 {
 	m_lastLengthIn = m_L;
-	m_reader->read(m_lastLengthIn, m_eosReader, m_outBuffer);
-	if(!m_eosReader || m_lastLengthIn>0)
+
+	// planar input is read directly into the channel buffers
+	if(m_planarReader)
+		m_planarReader->readPlanar(m_lastLengthIn, m_eosReader, m_vecInOut.data());
+	else
 	{
+		m_reader->read(m_lastLengthIn, m_eosReader, m_outBuffer);
 		divideByChannel(m_outBuffer, m_lastLengthIn*m_inChannels);
+	}
+
+	if(!m_eosReader || m_lastLengthIn>0)
+	{
 		int len = m_lastLengthIn;
 
 		for(int i = 0; i < m_futures.size(); i++)
@@ -164,24 +173,12 @@ void ConvolverReader::loadBuffer()
 
 void ConvolverReader::divideByChannel(const sample_t* buffer, int len)
 {
-	int k = 0;
-	for(int i = 0; i < len; i += m_inChannels)
-	{	
-		for(int j = 0; j < m_inChannels; j++)
-			m_vecInOut[j][k] = buffer[i + j];
-		k++;
-	}
+	PlanarBuffer::deinterleave(buffer, m_vecInOut.data(), len / m_inChannels, m_inChannels);
 }
 
 void ConvolverReader::joinByChannel(int start, int len)
 {
-	int k = 0;
-	for(int i = 0; i < len*m_inChannels; i += m_inChannels)
-	{
-		for(int j = 0; j < m_vecInOut.size(); j++)
-			m_outBuffer[i + j + start] = m_vecInOut[j][k];
-		k++;
-	}
+	PlanarBuffer::interleave(m_vecInOut.data(), m_outBuffer + start, len, m_inChannels);
 }
 
 int ConvolverReader::threadFunction(int id, bool input)
@@ -16,6 +16,7 @@
 
 #include "fx/ConvolverSound.h"
 #include "fx/ConvolverReader.h"
+#include "util/Profiler.h"
 #include "Exception.h"
 
 #include <cstring>
@@ -23,7 +24,7 @@
 AUD_NAMESPACE_BEGIN
 
 ConvolverSound::ConvolverSound(std::shared_ptr<ISound> sound, std::shared_ptr<ImpulseResponse> impulseResponse, std::shared_ptr<ThreadPool> threadPool) :
-	ConvolverSound(sound, impulseResponse, threadPool, std::make_shared<FFTPlan>(0.0))
+	ConvolverSound(sound, impulseResponse, threadPool, FFTPlan::get())
 {
 }
 
@@ -34,7 +35,7 @@ ConvolverSound::ConvolverSound(std::shared_ptr<ISound> sound, std::shared_ptr<Im
 
 std::shared_ptr<IReader> ConvolverSound::createReader()
 {
-	return std::make_shared<ConvolverReader>(m_sound->createReader(), m_impulseResponse, m_threadPool, m_plan);
+	return std::make_shared<ConvolverReader>(Profiler::createReader(m_sound), m_impulseResponse, m_threadPool, m_plan);
 }
 
 std::shared_ptr<ImpulseResponse> ConvolverSound::getImpulseResponse()
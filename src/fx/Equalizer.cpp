@@ -30,6 +30,7 @@
 #include "fx/ImpulseResponse.h"
 #include "util/Buffer.h"
 #include "util/FFTPlan.h"
+#include "util/Profiler.h"
 #include "util/ThreadPool.h"
 
 AUD_NAMESPACE_BEGIN
@@ -48,9 +49,11 @@ Equalizer::~Equalizer()
 
 std::shared_ptr<IReader> Equalizer::createReader()
 {
-	std::shared_ptr<FFTPlan> fp = std::shared_ptr<FFTPlan>(new FFTPlan(filter_length));
-	// 2 threads to start with
-	return std::shared_ptr<ConvolverReader>(new ConvolverReader(m_sound->createReader(), createImpulseResponse(), std::shared_ptr<ThreadPool>(new ThreadPool(2)), fp));
+	// all equalizers share one pool with 2 threads to start with
+	static std::shared_ptr<ThreadPool> threadPool = std::make_shared<ThreadPool>(2);
+
+	std::shared_ptr<FFTPlan> fp = FFTPlan::get(filter_length);
+	return std::shared_ptr<ConvolverReader>(new ConvolverReader(Profiler::createReader(m_sound), createImpulseResponse(), threadPool, fp));
 }
 
 float calculateValueArray(float* data, float minX, float maxX, int length, float posX)
@@ -84,7 +87,7 @@ void complex_prod(float a, float b, float c, float d, float* r, float* imag)
  */
 std::shared_ptr<ImpulseResponse> Equalizer::createImpulseResponse()
 {
-	std::shared_ptr<FFTPlan> fp = std::shared_ptr<FFTPlan>(new FFTPlan(filter_length));
+	std::shared_ptr<FFTPlan> fp = FFTPlan::get(filter_length);
 	fftwf_complex* buffer = (fftwf_complex*) fp->getBuffer();
 	std::memset(buffer, 0, filter_length * sizeof(fftwf_complex));
 	std::shared_ptr<IReader> soundReader = m_sound.get()->createReader();
@@ -184,7 +187,7 @@ std::shared_ptr<Buffer> Equalizer::minimumPhaseFilterHomomorphic(std::shared_ptr
 		lWork = (int) pow(2, ceil(log2((float) (2 * (lOriginal - 1) / 0.01))));
 	}
 
-	std::shared_ptr<FFTPlan> fp = std::shared_ptr<FFTPlan>(new FFTPlan(lWork, 0.1));
+	std::shared_ptr<FFTPlan> fp = FFTPlan::get(lWork, 0.1);
 	fftwf_complex* buffer = (fftwf_complex*) fp->getBuffer();
 	sample_t* b_work = (sample_t*) buffer;
 	// Padding with 0
@@ -275,7 +278,7 @@ std::shared_ptr<Buffer> Equalizer::minimumPhaseFilterHilbert(std::shared_ptr<Buf
 		lWork = (int) pow(2, ceil(log2((float) (2 * (lOriginal - 1) / 0.01))));
 	}
 
-	std::shared_ptr<FFTPlan> fp = std::shared_ptr<FFTPlan>(new FFTPlan(lWork, 0.1));
+	std::shared_ptr<FFTPlan> fp = FFTPlan::get(lWork, 0.1);
 	fftwf_complex* buffer = (fftwf_complex*) fp->getBuffer();
 	sample_t* b_work = (sample_t*) buffer;
 	// Padding with 0
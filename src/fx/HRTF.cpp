@@ -17,16 +17,35 @@
 #include "fx/HRTF.h"
 #include "Exception.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <numeric>
+
+#define INTERPOLATION_POINTS 3
+#define INTERPOLATION_EPSILON 1e-6f
+#define INTERPOLATION_BUFFERS 16
 
 AUD_NAMESPACE_BEGIN
+
+static inline void getDirection(float azimuth, float elevation, float* direction)
+{
+	azimuth = float(azimuth * M_PI / 180.0);
+	elevation = float(elevation * M_PI / 180.0);
+
+	// x points to the front, y to the right as the azimuth goes clockwise
+	direction[0] = std::cos(elevation) * std::cos(azimuth);
+	direction[1] = std::cos(elevation) * std::sin(azimuth);
+	direction[2] = std::sin(elevation);
+}
+
 HRTF::HRTF() :
-	HRTF(std::make_shared<FFTPlan>(0.0))
+	HRTF(FFTPlan::get())
 {
 }
 
 HRTF::HRTF(std::shared_ptr<FFTPlan> plan) :
-	m_plan(plan)
+	m_plan(plan), m_interpolation(false)
 {
 	m_specs.channels = CHANNELS_INVALID;
 	m_specs.rate = 0;
@@ -37,6 +56,16 @@ bool HRTF::addImpulseResponse(std::shared_ptr<StreamBuffer> impulseResponse, flo
 {
 	Specs spec = impulseResponse->getSpecs();
 
+	if((spec.channels != CHANNELS_MONO) || (spec.rate != m_specs.rate && m_specs.rate > 0.0))
+		return false;
+
+	return addImpulseResponse(std::make_shared<ImpulseResponse>(impulseResponse, m_plan), azimuth, elevation);
+}
+
+bool HRTF::addImpulseResponse(std::shared_ptr<ImpulseResponse> impulseResponse, float azimuth, float elevation)
+{
+	Specs spec = impulseResponse->getSpecs();
+
 	azimuth = std::fmod(azimuth, 360);
 	if(azimuth < 0)
 		azimuth += 360;
@@ -44,70 +73,254 @@ bool HRTF::addImpulseResponse(std::shared_ptr<StreamBuffer> impulseResponse, flo
 	if((spec.channels != CHANNELS_MONO) || (spec.rate != m_specs.rate && m_specs.rate > 0.0))
 		return false;
 
-	m_hrtfs[elevation][azimuth] = std::make_shared<ImpulseResponse>(impulseResponse, m_plan);
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	insert(impulseResponse, azimuth, elevation);
+
+	return true;
+}
+
+void HRTF::insert(std::shared_ptr<ImpulseResponse> impulseResponse, float azimuth, float elevation)
+{
+	auto angles = std::make_pair(azimuth, elevation);
+	auto it = m_angleIndex.find(angles);
+
+	if(it != m_angleIndex.end())
+		m_hrtfs[it->second] = impulseResponse;
+	else
+	{
+		m_angleIndex[angles] = int(m_hrtfs.size());
+		m_hrtfs.push_back(impulseResponse);
+		m_angles.push_back(angles);
+		m_directions.resize(m_directions.size() + 3);
+		getDirection(azimuth, elevation, &m_directions[m_directions.size() - 3]);
+	}
+
 	m_specs.channels = CHANNELS_MONO;
-	m_specs.rate = spec.rate;
+	m_specs.rate = impulseResponse->getSpecs().rate;
 	m_empty = false;
-	return true;
 }
 
-std::pair<std::shared_ptr<ImpulseResponse>, std::shared_ptr<ImpulseResponse>> HRTF::getImpulseResponse(float &azimuth, float &elevation)
+void HRTF::updateIndex()
 {
-	if(m_hrtfs.empty())
-		return std::make_pair(nullptr, nullptr);
-	azimuth = std::fmod(azimuth, 360);
-	if(azimuth < 0)
-		azimuth += 360;
+	m_index.resize(m_hrtfs.size());
+	std::iota(m_index.begin(), m_index.end(), 0);
+	buildIndex(0, m_index.size(), 0);
+}
 
-	std::shared_ptr<ImpulseResponse> R, L;
-	float az = 0, el = 0, dif=0, minDif=360;
+void HRTF::buildIndex(int begin, int end, int depth)
+{
+	if(end - begin < 2)
+		return;
+
+	int middle = (begin + end) / 2;
+	int axis = depth % 3;
 
-	for(auto elem : m_hrtfs)
+	std::nth_element(m_index.begin() + begin, m_index.begin() + middle, m_index.begin() + end, [this, axis](int a, int b)
 	{
-		dif = std::fabs(elevation - elem.first);
-		if(dif < minDif)
+		return m_directions[a * 3 + axis] < m_directions[b * 3 + axis];
+	});
+
+	buildIndex(begin, middle, depth + 1);
+	buildIndex(middle + 1, end, depth + 1);
+}
+
+void HRTF::findNearest(const float* direction, int begin, int end, int depth, int count, int* nearest, float* distances) const
+{
+	if(begin >= end)
+		return;
+
+	int middle = (begin + end) / 2;
+	int axis = depth % 3;
+	int hrtf = m_index[middle];
+	const float* point = &m_directions[hrtf * 3];
+
+	float distance = 0;
+	for(int i = 0; i < 3; i++)
+		distance += (direction[i] - point[i]) * (direction[i] - point[i]);
+
+	if(distance < distances[count - 1])
+	{
+		int i = count - 1;
+		for(; i > 0 && distances[i - 1] > distance; i--)
 		{
-			minDif = dif;
-			el = elem.first;
+			distances[i] = distances[i - 1];
+			nearest[i] = nearest[i - 1];
 		}
+		distances[i] = distance;
+		nearest[i] = hrtf;
 	}
-	elevation = el;
-	dif = 0; 
-	minDif = 360;
-	
-	for(auto elem : m_hrtfs[elevation])
+
+	float delta = direction[axis] - point[axis];
+
+	if(delta < 0)
 	{
-		dif = std::fabs(azimuth - elem.first);
-		if(dif < minDif)
-		{
-			minDif = dif;
-			az = elem.first;
-			R = elem.second;
-		}
+		findNearest(direction, begin, middle, depth + 1, count, nearest, distances);
+		if(delta * delta < distances[count - 1])
+			findNearest(direction, middle + 1, end, depth + 1, count, nearest, distances);
 	}
-	azimuth = az;
-	float azL = 360 - azimuth;
-	if(azL == 360)
-		azL = 0;
-
-	auto iter = m_hrtfs[elevation].find(azL);
-	if(iter != m_hrtfs[elevation].end())
-		L = iter->second;
 	else
 	{
-		dif = 0;
-		minDif = 360;
-		for(auto elem : m_hrtfs[elevation])
+		findNearest(direction, middle + 1, end, depth + 1, count, nearest, distances);
+		if(delta * delta < distances[count - 1])
+			findNearest(direction, begin, middle, depth + 1, count, nearest, distances);
+	}
+}
+
+std::shared_ptr<ImpulseResponse> HRTF::getInterpolationBuffer(int parts, int bins, int length)
+{
+	for(auto& ir : m_interpolated)
+	{
+		// convolvers keep references to the channel or its parts
+		if(ir.use_count() > 1 || ir->getLength() != length)
+			continue;
+
+		auto channel = ir->getChannel(0);
+
+		if(channel.use_count() > 2 || int(channel->size()) != parts || int((*channel)[0]->size()) != bins)
+			continue;
+
+		bool used = false;
+
+		for(auto& part : *channel)
+			used = used || part.use_count() > 1;
+
+		if(used)
+			continue;
+
+		for(auto& part : *channel)
+			std::fill(part->begin(), part->end(), std::complex<sample_t>(0));
+
+		return ir;
+	}
+
+	auto channel = std::make_shared<std::vector<std::shared_ptr<std::vector<std::complex<sample_t>>>>>();
+
+	for(int part = 0; part < parts; part++)
+		channel->push_back(std::make_shared<std::vector<std::complex<sample_t>>>(bins));
+
+	std::vector<std::shared_ptr<std::vector<std::shared_ptr<std::vector<std::complex<sample_t>>>>>> processedIR;
+	processedIR.push_back(channel);
+
+	auto ir = std::make_shared<ImpulseResponse>(processedIR, length, m_specs);
+
+	if(m_interpolated.size() < INTERPOLATION_BUFFERS)
+		m_interpolated.push_back(ir);
+
+	return ir;
+}
+
+std::shared_ptr<ImpulseResponse> HRTF::interpolate(const float* direction)
+{
+	int nearest[INTERPOLATION_POINTS];
+	float distances[INTERPOLATION_POINTS];
+
+	std::fill(nearest, nearest + INTERPOLATION_POINTS, -1);
+	std::fill(distances, distances + INTERPOLATION_POINTS, std::numeric_limits<float>::infinity());
+
+	findNearest(direction, 0, m_index.size(), 0, INTERPOLATION_POINTS, nearest, distances);
+
+	if(distances[0] < INTERPOLATION_EPSILON || nearest[1] < 0)
+		return m_hrtfs[nearest[0]];
+
+	// inverse distance weighting with the angles between the directions
+	float weights[INTERPOLATION_POINTS];
+	float sum = 0;
+	int points = 0;
+	int parts = 0;
+	int length = 0;
+
+	for(; points < INTERPOLATION_POINTS && nearest[points] >= 0; points++)
+	{
+		weights[points] = 1.0f / (2.0f * std::asin(std::min(1.0f, std::sqrt(distances[points]) / 2.0f)));
+		sum += weights[points];
+		parts = std::max(parts, int(m_hrtfs[nearest[points]]->getChannel(0)->size()));
+		length = std::max(length, m_hrtfs[nearest[points]]->getLength());
+	}
+
+	int bins = (*m_hrtfs[nearest[0]]->getChannel(0))[0]->size();
+	auto result = getInterpolationBuffer(parts, bins, length);
+	auto channel = result->getChannel(0);
+
+	for(int i = 0; i < points; i++)
+	{
+		auto ir = m_hrtfs[nearest[i]]->getChannel(0);
+		float weight = weights[i] / sum;
+
+		for(int part = 0; part < int(ir->size()); part++)
 		{
-			dif = std::fabs(azL - elem.first);
-			if(dif < minDif)
-			{
-				minDif = dif;
-				L = elem.second;
-			}
+			std::complex<sample_t>* target = (*channel)[part]->data();
+			const std::complex<sample_t>* source = (*ir)[part]->data();
+
+			for(int bin = 0; bin < bins; bin++)
+				target[bin] += weight * source[bin];
 		}
 	}
-	return std::make_pair(L, R);
+
+	return result;
+}
+
+std::pair<std::shared_ptr<ImpulseResponse>, std::shared_ptr<ImpulseResponse>> HRTF::getImpulseResponse(float &azimuth, float &elevation)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if(m_hrtfs.empty())
+		return std::make_pair(nullptr, nullptr);
+
+	if(m_index.size() != m_hrtfs.size())
+		updateIndex();
+
+	if(m_interpolation)
+	{
+		azimuth = std::round(azimuth);
+		elevation = std::round(elevation);
+	}
+
+	azimuth = std::fmod(azimuth, 360);
+	if(azimuth < 0)
+		azimuth += 360;
+
+	// the left ear uses the HRTF of the mirrored direction
+	float right[3];
+	getDirection(azimuth, elevation, right);
+	float left[3] = {right[0], -right[1], right[2]};
+
+	if(m_interpolation)
+		return std::make_pair(interpolate(left), interpolate(right));
+
+	int R = 0, L = 0;
+	float distance = std::numeric_limits<float>::infinity();
+	findNearest(right, 0, m_index.size(), 0, 1, &R, &distance);
+
+	distance = std::numeric_limits<float>::infinity();
+	findNearest(left, 0, m_index.size(), 0, 1, &L, &distance);
+
+	azimuth = m_angles[R].first;
+	elevation = m_angles[R].second;
+
+	return std::make_pair(m_hrtfs[L], m_hrtfs[R]);
+}
+
+int HRTF::getCount() const
+{
+	return m_hrtfs.size();
+}
+
+std::shared_ptr<ImpulseResponse> HRTF::getMeasurement(int index, float& azimuth, float& elevation) const
+{
+	azimuth = m_angles[index].first;
+	elevation = m_angles[index].second;
+	return m_hrtfs[index];
+}
+
+bool HRTF::getInterpolation() const
+{
+	return m_interpolation;
+}
+
+void HRTF::setInterpolation(bool interpolation)
+{
+	m_interpolation = interpolation;
 }
 
 Specs HRTF::getSpecs()
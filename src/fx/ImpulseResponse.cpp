@@ -23,7 +23,7 @@
 
 AUD_NAMESPACE_BEGIN
 ImpulseResponse::ImpulseResponse(std::shared_ptr<StreamBuffer> impulseResponse) :
-	ImpulseResponse(impulseResponse, std::make_shared<FFTPlan>(0.0))
+	ImpulseResponse(impulseResponse, FFTPlan::get())
 {
 }
 
@@ -34,6 +34,11 @@ ImpulseResponse::ImpulseResponse(std::shared_ptr<StreamBuffer> impulseResponse,
 	processImpulseResponse(impulseResponse->createReader(), plan);
 }
 
+ImpulseResponse::ImpulseResponse(std::vector<std::shared_ptr<std::vector<std::shared_ptr<std::vector<std::complex<sample_t>>>>>> processedIR, int length, Specs specs) :
+	m_processedIR(processedIR), m_specs(specs), m_length(length)
+{
+}
+
 Specs ImpulseResponse::getSpecs()
 {
 	return m_specs;
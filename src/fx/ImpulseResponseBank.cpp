@@ -0,0 +1,351 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "fx/ImpulseResponseBank.h"
+#include "Exception.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <vector>
+
+#ifdef _WIN32
+	#include <iterator>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+#define BANK_MAGIC "AUDIRBK"
+#define BANK_VERSION 1
+#define BANK_BYTE_ORDER 0x01020304
+#define BANK_ALIGNMENT 32
+
+#define BANK_TYPE_IMPULSE_RESPONSE 0
+#define BANK_TYPE_HRTF 1
+
+AUD_NAMESPACE_BEGIN
+
+struct BankHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t byte_order;
+	uint32_t type;
+	uint32_t fft_size;
+	uint32_t channels;
+	uint32_t count;
+	double rate;
+};
+
+struct BankEntry
+{
+	float azimuth;
+	float elevation;
+	uint32_t length;
+	uint32_t parts;
+	uint64_t offset;
+};
+
+/**
+ * A read only memory mapping of a bank file.
+ */
+class MappedBank
+{
+private:
+	/// The mapped memory.
+	const char* m_data;
+
+	/// The size of the file.
+	size_t m_size;
+
+#ifdef _WIN32
+	/// The file contents, as there is no mapping on this platform.
+	std::vector<char> m_buffer;
+#endif
+
+	// delete copy constructor and operator=
+	MappedBank(const MappedBank&) = delete;
+	MappedBank& operator=(const MappedBank&) = delete;
+
+public:
+	MappedBank(const std::string& filename) :
+		m_data(nullptr), m_size(0)
+	{
+#ifdef _WIN32
+		std::ifstream file(filename, std::ios::binary);
+
+		if(!file)
+			AUD_THROW(FileException, "The impulse response bank couldn't be opened: " + filename);
+
+		m_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		m_data = m_buffer.data();
+		m_size = m_buffer.size();
+#else
+		int fd = open(filename.c_str(), O_RDONLY);
+
+		if(fd < 0)
+			AUD_THROW(FileException, "The impulse response bank couldn't be opened: " + filename);
+
+		struct stat status;
+
+		if(fstat(fd, &status) == 0 && status.st_size > 0)
+		{
+			void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+			if(data != MAP_FAILED)
+			{
+				m_data = static_cast<const char*>(data);
+				m_size = status.st_size;
+			}
+		}
+
+		close(fd);
+
+		if(!m_data)
+			AUD_THROW(FileException, "The impulse response bank couldn't be mapped: " + filename);
+#endif
+	}
+
+	~MappedBank()
+	{
+#ifndef _WIN32
+		if(m_data)
+			munmap(const_cast<char*>(m_data), m_size);
+#endif
+	}
+
+	const char* getData() const
+	{
+		return m_data;
+	}
+
+	size_t getSize() const
+	{
+		return m_size;
+	}
+};
+
+static void writeBank(const std::string& filename, uint32_t type, const std::vector<std::shared_ptr<ImpulseResponse>>& impulseResponses, const std::vector<std::pair<float, float>>& angles)
+{
+	Specs specs = impulseResponses.front()->getSpecs();
+	uint32_t bins = 0;
+
+	for(auto& impulseResponse : impulseResponses)
+	{
+		auto channel = impulseResponse->getChannel(0);
+
+		if(!channel->empty())
+		{
+			bins = (*channel)[0]->size();
+			break;
+		}
+	}
+
+	if(bins < 2)
+		AUD_THROW(StateException, "The impulse responses are empty.");
+
+	BankHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, BANK_MAGIC, sizeof(BANK_MAGIC));
+	header.version = BANK_VERSION;
+	header.byte_order = BANK_BYTE_ORDER;
+	header.type = type;
+	header.fft_size = (bins - 1) * 2;
+	header.channels = specs.channels;
+	header.count = impulseResponses.size();
+	header.rate = specs.rate;
+
+	std::vector<BankEntry> entries(impulseResponses.size());
+	uint64_t offset = sizeof(BankHeader) + entries.size() * sizeof(BankEntry);
+
+	for(int i = 0; i < int(entries.size()); i++)
+	{
+		offset = (offset + BANK_ALIGNMENT - 1) / BANK_ALIGNMENT * BANK_ALIGNMENT;
+
+		entries[i].azimuth = angles[i].first;
+		entries[i].elevation = angles[i].second;
+		entries[i].length = impulseResponses[i]->getLength();
+		entries[i].parts = impulseResponses[i]->getChannel(0)->size();
+		entries[i].offset = offset;
+
+		offset += uint64_t(header.channels) * entries[i].parts * bins * sizeof(std::complex<sample_t>);
+	}
+
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+
+	if(!file)
+		AUD_THROW(FileException, "The impulse response bank couldn't be created: " + filename);
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(BankEntry));
+
+	const char padding[BANK_ALIGNMENT] = {0};
+
+	for(int i = 0; i < int(entries.size()); i++)
+	{
+		file.write(padding, entries[i].offset - uint64_t(file.tellp()));
+
+		for(int channel = 0; channel < int(header.channels); channel++)
+		{
+			auto parts = impulseResponses[i]->getChannel(channel);
+
+			if(parts->size() != entries[i].parts)
+				AUD_THROW(StateException, "The channels of an impulse response have to be split into the same number of parts.");
+
+			for(auto& part : *parts)
+			{
+				if(part->size() != bins)
+					AUD_THROW(StateException, "The impulse responses have to be processed with a plan of the same size.");
+
+				file.write(reinterpret_cast<const char*>(part->data()), bins * sizeof(std::complex<sample_t>));
+			}
+		}
+	}
+
+	if(!file)
+		AUD_THROW(FileException, "The impulse response bank couldn't be written: " + filename);
+}
+
+static void readBank(const std::string& filename, uint32_t type, std::shared_ptr<FFTPlan> plan, const std::function<void(std::shared_ptr<ImpulseResponse>, float, float)>& add)
+{
+	MappedBank bank(filename);
+
+	const char* data = bank.getData();
+	size_t size = bank.getSize();
+
+	BankHeader header;
+
+	if(size < sizeof(header))
+		AUD_THROW(FileException, "The impulse response bank is truncated: " + filename);
+
+	std::memcpy(&header, data, sizeof(header));
+
+	if(std::memcmp(header.magic, BANK_MAGIC, sizeof(BANK_MAGIC)) != 0)
+		AUD_THROW(FileException, "The file is not an impulse response bank: " + filename);
+
+	if(header.version != BANK_VERSION || header.byte_order != BANK_BYTE_ORDER)
+		AUD_THROW(FileException, "The version or byte order of the impulse response bank is not supported: " + filename);
+
+	if(header.type != type)
+		AUD_THROW(FileException, "The impulse response bank contains the wrong type of impulse responses: " + filename);
+
+	if(int(header.fft_size) != plan->getSize())
+		AUD_THROW(StateException, "The impulse response bank was created for a different FFT size.");
+
+	if(header.channels < 1 || header.count < 1 || size < sizeof(header) + uint64_t(header.count) * sizeof(BankEntry))
+		AUD_THROW(FileException, "The impulse response bank is truncated: " + filename);
+
+	// HRTFs are inserted without the checks of HRTF::addImpulseResponse
+	if(type == BANK_TYPE_HRTF && header.channels != CHANNELS_MONO)
+		AUD_THROW(FileException, "The HRTF bank contains impulse responses that aren't mono: " + filename);
+
+	Specs specs;
+	specs.channels = Channels(header.channels);
+	specs.rate = header.rate;
+
+	const uint64_t bins = header.fft_size / 2 + 1;
+	const uint64_t part_size = bins * sizeof(std::complex<sample_t>);
+
+	// the number of parts that fit into the file limits all counts, so that the bounds checks can't overflow
+	if(header.channels > size / part_size)
+		AUD_THROW(FileException, "The impulse response bank is truncated: " + filename);
+
+	for(uint32_t i = 0; i < header.count; i++)
+	{
+		BankEntry entry;
+		std::memcpy(&entry, data + sizeof(header) + i * sizeof(BankEntry), sizeof(entry));
+
+		if(entry.parts < 1 || entry.offset > size || entry.parts > (size - entry.offset) / part_size / header.channels)
+			AUD_THROW(FileException, "The impulse response bank is truncated: " + filename);
+
+		if(entry.length > uint64_t(entry.parts) * (header.fft_size / 2))
+			AUD_THROW(FileException, "The impulse response bank is corrupt: " + filename);
+
+		const char* spectra = data + entry.offset;
+		std::vector<std::shared_ptr<std::vector<std::shared_ptr<std::vector<std::complex<sample_t>>>>>> processedIR;
+
+		for(uint32_t channel = 0; channel < header.channels; channel++)
+		{
+			processedIR.push_back(std::make_shared<std::vector<std::shared_ptr<std::vector<std::complex<sample_t>>>>>());
+
+			for(uint32_t part = 0; part < entry.parts; part++)
+			{
+				auto values = std::make_shared<std::vector<std::complex<sample_t>>>(bins);
+				std::memcpy(values->data(), spectra, part_size);
+				processedIR.back()->push_back(values);
+				spectra += part_size;
+			}
+		}
+
+		add(std::make_shared<ImpulseResponse>(processedIR, entry.length, specs), entry.azimuth, entry.elevation);
+	}
+}
+
+void ImpulseResponseBank::writeHRTF(std::shared_ptr<HRTF> hrtfs, const std::string& filename)
+{
+	std::vector<std::shared_ptr<ImpulseResponse>> impulseResponses;
+	std::vector<std::pair<float, float>> angles;
+
+	for(int i = 0; i < hrtfs->getCount(); i++)
+	{
+		float azimuth, elevation;
+		impulseResponses.push_back(hrtfs->getMeasurement(i, azimuth, elevation));
+		angles.push_back(std::make_pair(azimuth, elevation));
+	}
+
+	if(impulseResponses.empty())
+		AUD_THROW(StateException, "The provided HRTF object is empty.");
+
+	writeBank(filename, BANK_TYPE_HRTF, impulseResponses, angles);
+}
+
+void ImpulseResponseBank::writeImpulseResponse(std::shared_ptr<ImpulseResponse> impulseResponse, const std::string& filename)
+{
+	writeBank(filename, BANK_TYPE_IMPULSE_RESPONSE, {impulseResponse}, {std::make_pair(0.0f, 0.0f)});
+}
+
+std::shared_ptr<HRTF> ImpulseResponseBank::readHRTF(const std::string& filename, std::shared_ptr<FFTPlan> plan)
+{
+	std::shared_ptr<HRTF> hrtfs = std::make_shared<HRTF>(plan);
+
+	// the bank is consistent, so the directions are indexed once at the end
+	readBank(filename, BANK_TYPE_HRTF, plan, [&hrtfs](std::shared_ptr<ImpulseResponse> impulseResponse, float azimuth, float elevation)
+	{
+		hrtfs->insert(impulseResponse, azimuth, elevation);
+	});
+
+	hrtfs->updateIndex();
+
+	return hrtfs;
+}
+
+std::shared_ptr<ImpulseResponse> ImpulseResponseBank::readImpulseResponse(const std::string& filename, std::shared_ptr<FFTPlan> plan)
+{
+	std::shared_ptr<ImpulseResponse> result;
+
+	readBank(filename, BANK_TYPE_IMPULSE_RESPONSE, plan, [&result](std::shared_ptr<ImpulseResponse> impulseResponse, [[maybe_unused]] float azimuth, [[maybe_unused]] float elevation)
+	{
+		result = impulseResponse;
+	});
+
+	return result;
+}
+
+AUD_NAMESPACE_END
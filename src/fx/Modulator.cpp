@@ -16,6 +16,7 @@
 
 #include "fx/Modulator.h"
 #include "fx/ModulatorReader.h"
+#include "util/Profiler.h"
 
 AUD_NAMESPACE_BEGIN
 
@@ -26,8 +27,8 @@ Modulator::Modulator(std::shared_ptr<ISound> sound1, std::shared_ptr<ISound> sou
 
 std::shared_ptr<IReader> Modulator::createReader()
 {
-	std::shared_ptr<IReader> reader1 = m_sound1->createReader();
-	std::shared_ptr<IReader> reader2 = m_sound2->createReader();
+	std::shared_ptr<IReader> reader1 = Profiler::createReader(m_sound1);
+	std::shared_ptr<IReader> reader2 = Profiler::createReader(m_sound2);
 
 	return std::shared_ptr<IReader>(new ModulatorReader(reader1, reader2));
 }
@@ -15,6 +15,7 @@
 ******************************************************************************/
 
 #include "fx/MutableReader.h"
+#include "util/Profiler.h"
 
 #include <cstring>
 
@@ -23,7 +24,7 @@ AUD_NAMESPACE_BEGIN
 MutableReader::MutableReader(std::shared_ptr<ISound> sound) :
 m_sound(sound)
 {
-	m_reader = m_sound->createReader();
+	m_reader = Profiler::createReader(m_sound);
 }
 
 bool MutableReader::isSeekable() const
@@ -35,7 +36,7 @@ void MutableReader::seek(int position)
 {
 	if(position < m_reader->getPosition())
 	{
-		m_reader = m_sound->createReader();
+		m_reader = Profiler::createReader(m_sound);
 	}
 	else
 		m_reader->seek(position);
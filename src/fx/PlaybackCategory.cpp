@@ -16,6 +16,8 @@
 
 #include "fx/PlaybackCategory.h"
 #include "fx/VolumeSound.h"
+#include "devices/SoftwareDevice.h"
+#include "devices/SubmixBus.h"
 
 AUD_NAMESPACE_BEGIN
 
@@ -40,7 +42,12 @@ std::shared_ptr<IHandle> PlaybackCategory::play(std::shared_ptr<ISound> sound)
 	m_device->lock();
 	auto handle = m_device->play(vs);
 	if(handle == nullptr)
+	{
+		m_device->unlock();
 		return nullptr;
+	}
+	if(m_bus)
+		SoftwareDevice::setBus(handle.get(), m_bus);
 	switch (m_status) 
 	{
 	case STATUS_PAUSED:
@@ -124,6 +131,23 @@ std::shared_ptr<VolumeStorage> PlaybackCategory::getSharedVolume()
 	return m_volumeStorage;
 }
 
+std::shared_ptr<SubmixBus> PlaybackCategory::getBus()
+{
+	return m_bus;
+}
+
+void PlaybackCategory::setBus(std::shared_ptr<SubmixBus> bus)
+{
+	m_device->lock();
+	m_bus = bus;
+	for(auto i = m_handles.begin(); i != m_handles.end(); i++)
+	{
+		if(i->second->getStatus() != STATUS_INVALID)
+			SoftwareDevice::setBus(i->second.get(), bus);
+	}
+	m_device->unlock();
+}
+
 void PlaybackCategory::cleanHandles()
 {
 	for(auto i = m_handles.begin(); i != m_handles.end();)
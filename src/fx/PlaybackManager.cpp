@@ -143,6 +143,35 @@ bool PlaybackManager::setVolume(float volume, unsigned int catKey)
 	}
 }
 
+std::shared_ptr<SubmixBus> PlaybackManager::getBus(unsigned int catKey)
+{
+	auto iter = m_categories.find(catKey);
+
+	if(iter != m_categories.end())
+	{
+		return iter->second->getBus();
+	}
+	else
+	{
+		return nullptr;
+	}
+}
+
+bool PlaybackManager::setBus(std::shared_ptr<SubmixBus> bus, unsigned int catKey)
+{
+	auto iter = m_categories.find(catKey);
+
+	if(iter != m_categories.end())
+	{
+		iter->second->setBus(bus);
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
 bool PlaybackManager::stop(unsigned int catKey)
 {
 	auto iter = m_categories.find(catKey);
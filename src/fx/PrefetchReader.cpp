@@ -0,0 +1,174 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "fx/PrefetchReader.h"
+#include "Exception.h"
+
+#include <algorithm>
+
+AUD_NAMESPACE_BEGIN
+
+PrefetchReader::PrefetchReader(std::shared_ptr<IReader> reader, int size, int block) :
+	EffectReader(reader),
+	m_blockSize(block),
+	m_position(reader->getPosition()),
+	m_eos(false),
+	m_stop(false)
+{
+	if(size <= 0 || block <= 0)
+		AUD_THROW(StateException, "The prefetch and block sizes have to be positive.");
+
+	int sample_size = AUD_SAMPLE_SIZE(m_reader->getSpecs());
+
+	// one additional sample, as a full ring buffer can hold one byte less than its size
+	m_ring.resize((std::max(size, block) + 1) * sample_size);
+	m_buffer.resize(block * sample_size);
+
+	start();
+}
+
+PrefetchReader::~PrefetchReader()
+{
+	stop();
+}
+
+void PrefetchReader::prefetch()
+{
+	int sample_size = AUD_SAMPLE_SIZE(m_reader->getSpecs());
+	size_t block_bytes = size_t(m_blockSize) * sample_size;
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while(!m_stop && !m_eos && !m_error)
+	{
+		if(m_ring.getWriteSize() < block_bytes)
+		{
+			m_condition.wait(lock);
+			continue;
+		}
+
+		lock.unlock();
+
+		int length = m_blockSize;
+		bool eos = false;
+		std::exception_ptr error;
+
+		try
+		{
+			m_reader->read(length, eos, m_buffer.getBuffer());
+		}
+		catch(...)
+		{
+			// anything escaping the thread would terminate the program
+			error = std::current_exception();
+		}
+
+		lock.lock();
+
+		if(error)
+			m_error = error;
+		else
+		{
+			m_ring.write(reinterpret_cast<data_t*>(m_buffer.getBuffer()), size_t(length) * sample_size);
+			m_eos = eos;
+		}
+
+		m_condition.notify_all();
+	}
+}
+
+void PrefetchReader::start()
+{
+	m_stop = false;
+	m_thread = std::thread(&PrefetchReader::prefetch, this);
+}
+
+void PrefetchReader::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+
+	m_condition.notify_all();
+
+	if(m_thread.joinable())
+		m_thread.join();
+}
+
+void PrefetchReader::seek(int position)
+{
+	stop();
+
+	m_reader->seek(position);
+	m_position = m_reader->getPosition();
+
+	m_ring.reset();
+	m_eos = false;
+	m_error = nullptr;
+
+	start();
+}
+
+int PrefetchReader::getPosition() const
+{
+	return m_position;
+}
+
+void PrefetchReader::read(int& length, bool& eos, sample_t* buffer)
+{
+	int sample_size = AUD_SAMPLE_SIZE(m_reader->getSpecs());
+	size_t requested = size_t(length) * sample_size;
+	size_t done = 0;
+
+	data_t* target = reinterpret_cast<data_t*>(buffer);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while(done < requested)
+	{
+		size_t available = m_ring.getReadSize();
+
+		if(available)
+		{
+			done += m_ring.read(target + done, std::min(available, requested - done));
+			m_condition.notify_all();
+		}
+		else if(m_error)
+		{
+			// return what was read before reporting the error with the next read
+			if(done)
+				break;
+
+			std::exception_ptr error = m_error;
+			m_error = nullptr;
+			m_eos = true;
+			length = 0;
+			eos = true;
+			std::rethrow_exception(error);
+		}
+		else if(m_eos)
+			break;
+		else
+			m_condition.wait(lock);
+	}
+
+	length = int(done / sample_size);
+	eos = m_eos && !m_ring.getReadSize();
+	m_position += length;
+}
+
+AUD_NAMESPACE_END
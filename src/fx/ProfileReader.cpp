@@ -0,0 +1,58 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "fx/ProfileReader.h"
+#include "util/PlanarBuffer.h"
+#include "util/Profiler.h"
+#include "util/ProfileScope.h"
+
+AUD_NAMESPACE_BEGIN
+
+ProfileReader::ProfileReader(std::shared_ptr<IReader> reader, const std::string& name) :
+	EffectReader(reader),
+	m_node(std::make_shared<ProfileNode>(name, Profiler::getTypeNode(name)))
+{
+}
+
+std::shared_ptr<ProfileNode> ProfileReader::getProfile() const
+{
+	return m_node;
+}
+
+std::shared_ptr<IReader> ProfileReader::getReader() const
+{
+	return m_reader;
+}
+
+void ProfileReader::read(int& length, bool& eos, sample_t* buffer)
+{
+	ProfileScope scope(m_node);
+
+	m_reader->read(length, eos, buffer);
+
+	scope.setSamples(length);
+}
+
+void ProfileReader::readPlanar(int& length, bool& eos, sample_t* const* buffers)
+{
+	ProfileScope scope(m_node);
+
+	PlanarBuffer::read(*m_reader, length, eos, buffers, m_buffer);
+
+	scope.setSamples(length);
+}
+
+AUD_NAMESPACE_END
@@ -15,6 +15,7 @@
 ******************************************************************************/
 
 #include "fx/SoundList.h"
+#include "util/Profiler.h"
 #include "Exception.h"
 
 #include <cstring>
@@ -54,7 +55,7 @@ std::shared_ptr<IReader> SoundList::createReader()
 			} while(temp == m_index && m_list.size()>1);
 			m_index = temp;
 		}
-		auto reader = m_list[m_index]->createReader();
+		auto reader = Profiler::createReader(m_list[m_index]);
 		m_mutex.unlock();
 		return reader;
 	}
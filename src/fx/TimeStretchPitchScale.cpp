@@ -17,6 +17,7 @@
 #include "fx/TimeStretchPitchScale.h"
 
 #include "fx/TimeStretchPitchScaleReader.h"
+#include "util/OfflineRender.h"
 
 AUD_NAMESPACE_BEGIN
 
@@ -28,7 +29,7 @@ TimeStretchPitchScale::TimeStretchPitchScale(std::shared_ptr<ISound> sound, doub
 
 std::shared_ptr<IReader> TimeStretchPitchScale::createReader()
 {
-	return std::shared_ptr<IReader>(new TimeStretchPitchScaleReader(getReader(), m_timeRatio, m_pitchScale, m_quality, m_preserveFormant));
+	return std::shared_ptr<IReader>(new TimeStretchPitchScaleReader(getReader(), m_timeRatio, m_pitchScale, m_quality, m_preserveFormant, OfflineRender::isActive()));
 }
 
 double TimeStretchPitchScale::getTimeRatio() const
@@ -16,34 +16,75 @@
 
 #include "fx/TimeStretchPitchScaleReader.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <thread>
 
 #include "Exception.h"
 #include "IReader.h"
 
 #include "util/Buffer.h"
+#include "util/PlanarBuffer.h"
+
+#define STRETCHER_BLOCK_SIZE 2048
+
+// maximum number of milliseconds to wait for the stretcher threads to process the final input
+#define STRETCHER_MAX_WAITS 1000
 
 using namespace RubberBand;
 
 AUD_NAMESPACE_BEGIN
 
+void TimeStretchPitchScaleReader::readInput(int& length, bool& eos)
+{
+	// mono input is already planar, so m_inputData points into m_buffer and no conversion happens
+	PlanarBuffer::read(*m_reader, length, eos, m_inputData.data(), m_buffer);
+}
+
+void TimeStretchPitchScaleReader::study()
+{
+	int position = m_reader->getPosition();
+	bool eos = false;
+
+	while(!eos)
+	{
+		int len = STRETCHER_BLOCK_SIZE;
+		readInput(len, eos);
+		m_stretcher->study(m_inputData.data(), len, eos);
+	}
+
+	m_reader->seek(position);
+}
+
 void TimeStretchPitchScaleReader::reset()
 {
-	auto startPad{m_stretcher->getPreferredStartPad()};
+	if(m_offline)
+	{
+		// the offline stretcher compensates its delay itself, the expected
+		// duration replaces a new study pass after seeking
+		m_samplesToDrop = 0;
+		m_stretcher->setExpectedInputDuration(std::max(m_reader->getLength() - m_reader->getPosition(), 0));
+		return;
+	}
 
-	m_samplesToDrop = m_stretcher->getStartDelay();
+	int startPad = m_stretcher->getPreferredStartPad();
 
-	m_deinterleaved[0].assureSize(startPad * sizeof(sample_t));
-	std::memset(m_deinterleaved[0].getBuffer(), 0, startPad * sizeof(sample_t));
+	m_samplesToDrop = m_stretcher->getStartDelay();
 
-	for(auto& channel : m_channelData)
-		channel = m_deinterleaved[0].getBuffer();
+	for(auto& channel : m_inputData)
+		std::memset(channel, 0, STRETCHER_BLOCK_SIZE * sizeof(sample_t));
 
-	m_stretcher->process(m_channelData.data(), startPad, m_finishedReader);
+	while(startPad > 0)
+	{
+		int len = std::min(startPad, STRETCHER_BLOCK_SIZE);
+		m_stretcher->process(m_inputData.data(), len, m_finishedReader);
+		startPad -= len;
+	}
 }
 
-TimeStretchPitchScaleReader::TimeStretchPitchScaleReader(std::shared_ptr<IReader> reader, double timeRatio, double pitchScale, StretcherQuality quality, bool preserveFormant) :
-    EffectReader(reader), m_position(0), m_finishedReader(false), m_deinterleaved(reader->getSpecs().channels), m_channelData(reader->getSpecs().channels)
+TimeStretchPitchScaleReader::TimeStretchPitchScaleReader(std::shared_ptr<IReader> reader, double timeRatio, double pitchScale, StretcherQuality quality, bool preserveFormant, bool offline) :
+    EffectReader(reader), m_inputData(reader->getSpecs().channels), m_outputData(reader->getSpecs().channels), m_targetData(reader->getSpecs().channels), m_offline(offline), m_position(0), m_finishedReader(false)
 {
 	if (pitchScale < 1.0 / 256.0 || pitchScale > 256.0)
 		AUD_THROW(StateException, "The pitch scale must be between 1/256 and 256");
@@ -51,7 +92,16 @@ TimeStretchPitchScaleReader::TimeStretchPitchScaleReader(std::shared_ptr<IReader
 	if (timeRatio < 1.0 / 256.0 || timeRatio > 256.0)
 		AUD_THROW(StateException, "The time-stretch ratio must be between 1/256 and 256");
 
-	RubberBandStretcher::Options options = RubberBandStretcher::OptionProcessRealTime | RubberBandStretcher::OptionEngineFiner | RubberBandStretcher::OptionChannelsTogether;
+	// the study pass needs to read the whole input and seek back
+	if(m_offline && (!m_reader->isSeekable() || m_reader->getLength() < 0))
+		m_offline = false;
+
+	RubberBandStretcher::Options options = RubberBandStretcher::OptionEngineFiner | RubberBandStretcher::OptionChannelsTogether;
+
+	if(m_offline)
+		options |= RubberBandStretcher::OptionProcessOffline | RubberBandStretcher::OptionThreadingAuto;
+	else
+		options |= RubberBandStretcher::OptionProcessRealTime;
 
 	switch(quality)
 	{
@@ -71,77 +121,87 @@ TimeStretchPitchScaleReader::TimeStretchPitchScaleReader(std::shared_ptr<IReader
 
 	options |= preserveFormant ? RubberBandStretcher::OptionFormantPreserved : RubberBandStretcher::OptionFormantShifted;
 	m_stretcher = std::make_unique<RubberBandStretcher>(m_reader->getSpecs().rate, m_reader->getSpecs().channels, options, timeRatio, pitchScale);
+	m_stretcher->setMaxProcessSize(STRETCHER_BLOCK_SIZE);
+
+	int channels = m_reader->getSpecs().channels;
+
+	m_buffer.resize(STRETCHER_BLOCK_SIZE * AUD_SAMPLE_SIZE(m_reader->getSpecs()));
+	m_input.resize(STRETCHER_BLOCK_SIZE * AUD_SAMPLE_SIZE(m_reader->getSpecs()));
+	m_output.resize(STRETCHER_BLOCK_SIZE * AUD_SAMPLE_SIZE(m_reader->getSpecs()));
+
+	for(int channel = 0; channel < channels; channel++)
+	{
+		m_inputData[channel] = channels == 1 ? m_buffer.getBuffer() : m_input.getBuffer() + channel * STRETCHER_BLOCK_SIZE;
+		m_outputData[channel] = m_output.getBuffer() + channel * STRETCHER_BLOCK_SIZE;
+	}
 
 	reset();
+
+	if(m_offline)
+		study();
 }
 
-void TimeStretchPitchScaleReader::read(int& length, bool& eos, sample_t* buffer)
+void TimeStretchPitchScaleReader::readStretched(int& length, bool& eos, sample_t* buffer, sample_t* const* buffers)
 {
 	if(length == 0)
 		return;
 
-	int samplesize = AUD_SAMPLE_SIZE(m_reader->getSpecs());
 	int channels = m_reader->getSpecs().channels;
 	int samplesRead = 0;
+	int waits = 0;
 
 	eos = false;
 	while(samplesRead < length)
 	{
-		int len = m_stretcher->getSamplesRequired();
-		if(!m_finishedReader && len != 0)
-		{
-			m_buffer.assureSize(len * samplesize);
-			sample_t* buf = m_buffer.getBuffer();
-
-			m_reader->read(len, m_finishedReader, buf);
-
-			// Deinterleave the input reader buffer for processing
-			for(int channel = 0; channel < channels; channel++)
-			{
-				m_deinterleaved[channel].assureSize(len * sizeof(sample_t));
-				sample_t* channelBuf = m_deinterleaved[channel].getBuffer();
-
-				for(int i = 0; i < len; i++)
-				{
-					channelBuf[i] = buf[i * channels + channel];
-				}
-
-				m_channelData[channel] = channelBuf;
-			}
-
-			m_stretcher->process(m_channelData.data(), len, m_finishedReader);
-		}
-
 		int available = m_stretcher->available();
 		if(available == -1)
-		{
-			eos = true;
 			break;
-		}
 
 		if(available == 0)
-			continue;
+		{
+			if(m_finishedReader)
+			{
+				// the stretcher is still processing the final input on its threads
+				if(++waits > STRETCHER_MAX_WAITS)
+					break;
 
-		available = std::min(m_samplesToDrop ? m_samplesToDrop : length - samplesRead, available);
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				continue;
+			}
 
-		for(int channel = 0; channel < channels; channel++)
-		{
-			m_deinterleaved[channel].assureSize(available * sizeof(sample_t));
-			m_channelData[channel] = m_deinterleaved[channel].getBuffer();
+			int len = m_stretcher->getSamplesRequired();
+			if(len <= 0 || len > STRETCHER_BLOCK_SIZE)
+				len = STRETCHER_BLOCK_SIZE;
+
+			readInput(len, m_finishedReader);
+			m_stretcher->process(m_inputData.data(), len, m_finishedReader);
+			continue;
 		}
 
-		m_stretcher->retrieve(m_channelData.data(), available);
+		available = std::min(std::min(m_samplesToDrop ? m_samplesToDrop : length - samplesRead, available), STRETCHER_BLOCK_SIZE);
 
 		if(m_samplesToDrop)
 		{
+			m_stretcher->retrieve(m_outputData.data(), available);
 			m_samplesToDrop -= available;
 		}
+		else if(buffers || channels == 1)
+		{
+			// planar and mono output is retrieved directly into the target buffers
+			for(int channel = 0; channel < channels; channel++)
+				m_targetData[channel] = (buffers ? buffers[channel] : buffer) + samplesRead;
+
+			m_stretcher->retrieve(m_targetData.data(), available);
+			samplesRead += available;
+		}
 		else
 		{
+			m_stretcher->retrieve(m_outputData.data(), available);
+
 			// Interleave the retrieved data into the buffer
 			for(int channel = 0; channel < channels; channel++)
 			{
-				sample_t* outputBuf = m_deinterleaved[channel].getBuffer();
+				const sample_t* outputBuf = m_outputData[channel];
 				for(int i = 0; i < available; i++)
 				{
 					buffer[(samplesRead + i) * channels + channel] = outputBuf[i];
@@ -157,6 +217,16 @@ void TimeStretchPitchScaleReader::read(int& length, bool& eos, sample_t* buffer)
 	eos = m_stretcher->available() == -1;
 }
 
+void TimeStretchPitchScaleReader::read(int& length, bool& eos, sample_t* buffer)
+{
+	readStretched(length, eos, buffer, nullptr);
+}
+
+void TimeStretchPitchScaleReader::readPlanar(int& length, bool& eos, sample_t* const* buffers)
+{
+	readStretched(length, eos, nullptr, buffers);
+}
+
 double TimeStretchPitchScaleReader::getTimeRatio() const
 {
 	return m_stretcher->getTimeRatio();
@@ -166,6 +236,25 @@ void TimeStretchPitchScaleReader::setTimeRatio(double timeRatio)
 {
 	if(timeRatio >= 1.0 / 256.0 && timeRatio <= 256.0)
 	{
+		if(m_offline)
+		{
+			if(timeRatio == m_stretcher->getTimeRatio())
+				return;
+
+			// the ratios of an offline stretcher are fixed once it started studying,
+			// so it restarts at the input position reached with the previous ratio
+			int position = int(m_position / m_stretcher->getTimeRatio());
+
+			m_stretcher->reset();
+			m_stretcher->setTimeRatio(timeRatio);
+			m_reader->seek(position);
+			m_finishedReader = false;
+			reset();
+			m_position = int(position * timeRatio);
+			study();
+			return;
+		}
+
 		m_stretcher->setTimeRatio(timeRatio);
 	}
 }
@@ -179,10 +268,27 @@ void TimeStretchPitchScaleReader::setPitchScale(double pitchScale)
 {
 	if(pitchScale >= 1.0 / 256.0 && pitchScale <= 256.0)
 	{
+		if(m_offline)
+		{
+			if(pitchScale == m_stretcher->getPitchScale())
+				return;
+
+			m_stretcher->reset();
+			m_stretcher->setPitchScale(pitchScale);
+			seek(m_position);
+			study();
+			return;
+		}
+
 		m_stretcher->setPitchScale(pitchScale);
 	}
 }
 
+bool TimeStretchPitchScaleReader::isOffline() const
+{
+	return m_offline;
+}
+
 void TimeStretchPitchScaleReader::seek(int position)
 {
 	m_reader->seek(int(position / getTimeRatio()));
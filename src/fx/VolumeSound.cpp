@@ -16,6 +16,7 @@
 
 #include "fx/VolumeSound.h"
 #include "fx/VolumeReader.h"
+#include "util/Profiler.h"
 #include "Exception.h"
 
 #include <cstring>
@@ -29,7 +30,7 @@ VolumeSound::VolumeSound(std::shared_ptr<ISound> sound, std::shared_ptr<VolumeSt
 
 std::shared_ptr<IReader> VolumeSound::createReader()
 {
-	return std::make_shared<VolumeReader>(m_sound->createReader(), m_volumeStorage);
+	return std::make_shared<VolumeReader>(Profiler::createReader(m_sound), m_volumeStorage);
 }
 
 std::shared_ptr<VolumeStorage> VolumeSound::getSharedVolume()
@@ -20,11 +20,155 @@
 #include <cmath>
 #include <limits>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define AUD_MAPPER_SSE
+#ifdef __AVX__
+#define AUD_MAPPER_AVX
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AUD_MAPPER_NEON
+#endif
+
 AUD_NAMESPACE_BEGIN
 
+/*
+* The dense kernel computes a whole output frame at once as sum of the mapping
+* columns weighted with the source samples. The columns are padded to the
+* vector width and the padding of a frame is overwritten by the next one, only
+* the last frames, whose padding would exceed the buffer, are mapped without
+* vector instructions.
+*/
+
+namespace {
+
+struct ScalarVector
+{
+	typedef float type;
+	static const int width = 1;
+
+	static inline type load(const float* p) { return *p; }
+	static inline void store(float* p, type v) { *p = v; }
+	static inline type set(float v) { return v; }
+	static inline type add(type a, type b) { return a + b; }
+	static inline type mul(type a, type b) { return a * b; }
+};
+
+#if defined(AUD_MAPPER_AVX)
+struct Vector8
+{
+	typedef __m256 type;
+	static const int width = 8;
+
+	static inline type load(const float* p) { return _mm256_loadu_ps(p); }
+	static inline void store(float* p, type v) { _mm256_storeu_ps(p, v); }
+	static inline type set(float v) { return _mm256_set1_ps(v); }
+	static inline type add(type a, type b) { return _mm256_add_ps(a, b); }
+	static inline type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+};
+
+typedef Vector8 MappingVector;
+#elif defined(AUD_MAPPER_SSE)
+struct Vector4
+{
+	typedef __m128 type;
+	static const int width = 4;
+
+	static inline type load(const float* p) { return _mm_loadu_ps(p); }
+	static inline void store(float* p, type v) { _mm_storeu_ps(p, v); }
+	static inline type set(float v) { return _mm_set1_ps(v); }
+	static inline type add(type a, type b) { return _mm_add_ps(a, b); }
+	static inline type mul(type a, type b) { return _mm_mul_ps(a, b); }
+};
+
+typedef Vector4 MappingVector;
+#elif defined(AUD_MAPPER_NEON)
+struct Vector4
+{
+	typedef float32x4_t type;
+	static const int width = 4;
+
+	static inline type load(const float* p) { return vld1q_f32(p); }
+	static inline void store(float* p, type v) { vst1q_f32(p, v); }
+	static inline type set(float v) { return vdupq_n_f32(v); }
+	static inline type add(type a, type b) { return vaddq_f32(a, b); }
+	static inline type mul(type a, type b) { return vmulq_f32(a, b); }
+};
+
+typedef Vector4 MappingVector;
+#else
+typedef ScalarVector MappingVector;
+#endif
+
+}
+
+template <class V>
+static inline void mapFrame(const float* in, float* out, int source_channels, const float* columns, int column_size, int channels)
+{
+	typedef typename V::type T;
+
+	for(int i = 0; i < channels; i += V::width)
+	{
+		T sum = V::mul(V::load(columns + i), V::set(in[0]));
+
+		for(int j = 1; j < source_channels; j++)
+			sum = V::add(sum, V::mul(V::load(columns + j * column_size + i), V::set(in[j])));
+
+		V::store(out + i, sum);
+	}
+}
+
+template <class V>
+static void mapDense(const float* in, float* out, int length, int source_channels, int target_channels, const float* columns, int column_size)
+{
+	int direct = 0;
+
+	if(length * target_channels >= column_size)
+		direct = std::min(length, (length * target_channels - column_size) / target_channels + 1);
+
+	for(int i = 0; i < direct; i++)
+		mapFrame<V>(in + i * source_channels, out + i * target_channels, source_channels, columns, column_size, column_size);
+
+	// the padding of the last frames would be written behind the buffer
+	for(int i = direct; i < length; i++)
+		mapFrame<ScalarVector>(in + i * source_channels, out + i * target_channels, source_channels, columns, column_size, target_channels);
+}
+
+static void mapPermutation(const float* in, float* out, int length, int source_channels, int target_channels, const int* routes)
+{
+	for(int i = 0; i < length; i++)
+	{
+		for(int j = 0; j < target_channels; j++)
+			out[j] = routes[j] < 0 ? 0 : in[routes[j]];
+
+		in += source_channels;
+		out += target_channels;
+	}
+}
+
+static void mapSparse(const float* in, float* out, int length, int source_channels, int target_channels, const int* offsets, const int* sources, const float* weights)
+{
+	for(int i = 0; i < length; i++)
+	{
+		for(int j = 0; j < target_channels; j++)
+		{
+			float sum = 0;
+
+			for(int k = offsets[j]; k < offsets[j + 1]; k++)
+				sum += weights[k] * in[sources[k]];
+
+			out[j] = sum;
+		}
+
+		in += source_channels;
+		out += target_channels;
+	}
+}
+
 ChannelMapperReader::ChannelMapperReader(std::shared_ptr<IReader> reader,
 												 Channels channels) :
-		EffectReader(reader), m_target_channels(channels),
+		EffectReader(reader), m_kernel(KERNEL_IDENTITY), m_column_size(0), m_target_channels(channels),
 	m_source_channels(CHANNELS_INVALID), m_mapping(nullptr), m_map_size(0), m_mono_angle(0)
 {
 }
@@ -69,11 +213,23 @@ void ChannelMapperReader::setMonoAngle(float angle)
 {
 	if(angle != angle)
 		angle = 0;
+	if(angle == m_mono_angle)
+		return;
 	m_mono_angle = angle;
 	if(m_source_channels == CHANNELS_MONO)
 		calculateMapping();
 }
 
+Channel ChannelMapperReader::getChannel(Channels channels, int index)
+{
+	return CHANNEL_MAPS[std::min(channels, CHANNELS_SURROUND71) - 1][index];
+}
+
+float ChannelMapperReader::getChannelAngle(Channels channels, int index)
+{
+	return CHANNEL_ANGLES[std::min(channels, CHANNELS_SURROUND71) - 1][index];
+}
+
 float ChannelMapperReader::angleDistance(float alpha, float beta)
 {
 	alpha = beta - alpha;
@@ -176,6 +332,102 @@ void ChannelMapperReader::calculateMapping()
 			m_mapping[channel_right * m_source_channels + i] = std::cos(M_PI_2 * angle_right / angle);
 		}
 	}
+
+	optimizeMapping();
+}
+
+void ChannelMapperReader::optimizeMapping()
+{
+	const int source_channels = m_source_channels;
+	const int target_channels = m_target_channels;
+
+	if(source_channels == target_channels)
+	{
+		m_kernel = KERNEL_IDENTITY;
+		return;
+	}
+
+	const int width = MappingVector::width;
+	m_column_size = (target_channels + width - 1) / width * width;
+
+	// mono sources are panned on every change of their angle, the dense kernel only needs a single column for them
+	if(source_channels > 1)
+	{
+		int entries = 0;
+		bool permutation = true;
+
+		for(int i = 0; i < target_channels; i++)
+		{
+			int row_entries = 0;
+
+			for(int j = 0; j < source_channels; j++)
+			{
+				float weight = m_mapping[i * source_channels + j];
+
+				if(weight != 0)
+				{
+					row_entries++;
+
+					if(weight != 1)
+						permutation = false;
+				}
+			}
+
+			if(row_entries > 1)
+				permutation = false;
+
+			entries += row_entries;
+		}
+
+		if(permutation)
+		{
+			m_kernel = KERNEL_PERMUTATION;
+			m_routes.assign(target_channels, -1);
+
+			for(int i = 0; i < target_channels; i++)
+				for(int j = 0; j < source_channels; j++)
+					if(m_mapping[i * source_channels + j] != 0)
+						m_routes[i] = j;
+
+			return;
+		}
+
+		// the dense kernel needs one multiply-add per vector and source channel
+		if(entries < source_channels * m_column_size / width)
+		{
+			m_kernel = KERNEL_SPARSE;
+			m_sparse_offsets.resize(target_channels + 1);
+			m_sparse_sources.clear();
+			m_sparse_weights.clear();
+
+			for(int i = 0; i < target_channels; i++)
+			{
+				m_sparse_offsets[i] = m_sparse_sources.size();
+
+				for(int j = 0; j < source_channels; j++)
+				{
+					float weight = m_mapping[i * source_channels + j];
+
+					if(weight != 0)
+					{
+						m_sparse_sources.push_back(j);
+						m_sparse_weights.push_back(weight);
+					}
+				}
+			}
+
+			m_sparse_offsets[target_channels] = m_sparse_sources.size();
+
+			return;
+		}
+	}
+
+	m_kernel = KERNEL_DENSE;
+	m_columns.assign(source_channels * m_column_size, 0);
+
+	for(int i = 0; i < target_channels; i++)
+		for(int j = 0; j < source_channels; j++)
+			m_columns[j * m_column_size + i] = m_mapping[i * source_channels + j];
 }
 
 Specs ChannelMapperReader::getSpecs() const
@@ -194,7 +446,7 @@ void ChannelMapperReader::read(int& length, bool& eos, sample_t* buffer)
 		calculateMapping();
 	}
 
-	if(m_source_channels == m_target_channels)
+	if(m_kernel == KERNEL_IDENTITY)
 	{
 		m_reader->read(length, eos, buffer);
 		return;
@@ -206,17 +458,17 @@ void ChannelMapperReader::read(int& length, bool& eos, sample_t* buffer)
 
 	m_reader->read(length, eos, in);
 
-	sample_t sum;
-
-	for(int i = 0; i < length; i++)
+	switch(m_kernel)
 	{
-		for(int j = 0; j < m_target_channels; j++)
-		{
-			sum = 0;
-			for(int k = 0; k < m_source_channels; k++)
-				sum += m_mapping[j * m_source_channels + k] * in[i * m_source_channels + k];
-			buffer[i * m_target_channels + j] = sum;
-		}
+	case KERNEL_PERMUTATION:
+		mapPermutation(in, buffer, length, m_source_channels, m_target_channels, m_routes.data());
+		break;
+	case KERNEL_SPARSE:
+		mapSparse(in, buffer, length, m_source_channels, m_target_channels, m_sparse_offsets.data(), m_sparse_sources.data(), m_sparse_weights.data());
+		break;
+	default:
+		mapDense<MappingVector>(in, buffer, length, m_source_channels, m_target_channels, m_columns.data(), m_column_size);
+		break;
 	}
 }
 
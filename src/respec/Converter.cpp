@@ -20,8 +20,8 @@
 AUD_NAMESPACE_BEGIN
 
 Converter::Converter(std::shared_ptr<ISound> sound,
-										   DeviceSpecs specs) :
-		SpecsChanger(sound, specs)
+										   DeviceSpecs specs, bool dither) :
+		SpecsChanger(sound, specs), m_dither(dither)
 {
 }
 
@@ -30,7 +30,7 @@ std::shared_ptr<IReader> Converter::createReader()
 	std::shared_ptr<IReader> reader = getReader();
 
 	if(m_specs.format != FORMAT_FLOAT32)
-		reader = std::shared_ptr<IReader>(new ConverterReader(reader, m_specs));
+		reader = std::shared_ptr<IReader>(new ConverterReader(reader, m_specs, m_dither));
 
 	return reader;
 }
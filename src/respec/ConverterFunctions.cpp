@@ -15,9 +15,20 @@
  ******************************************************************************/
 
 #include "respec/ConverterFunctions.h"
+#include "ConverterKernels.h"
 
+#include <cmath>
+#include <cstring>
 #include <stdint.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define AUD_CONVERTER_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AUD_CONVERTER_NEON
+#endif
+
 #define U8_0		0x80
 #define S16_MAX		((int16_t)0x7FFF)
 #define S16_MIN		((int16_t)0x8000)
@@ -64,7 +75,7 @@ void convert_u8_s32(data_t* target, data_t* source, int length)
 		t[i] = (((int32_t)source[i]) - U8_0) << 24;
 }
 
-void convert_u8_float(data_t* target, data_t* source, int length)
+void convert_u8_float_scalar(data_t* target, data_t* source, int length)
 {
 	float* t = (float*) target;
 	for(int i = length - 1; i >= 0; i--)
@@ -119,7 +130,7 @@ void convert_s16_s32(data_t* target, data_t* source, int length)
 		t[i] = ((int32_t)s[i]) << 16;
 }
 
-void convert_s16_float(data_t* target, data_t* source, int length)
+void convert_s16_float_scalar(data_t* target, data_t* source, int length)
 {
 	int16_t* s = (int16_t*) source;
 	float* t = (float*) target;
@@ -226,7 +237,7 @@ void convert_s24_double_le(data_t* target, data_t* source, int length)
 
 void convert_s32_u8(data_t* target, data_t* source, int length)
 {
-	int16_t* s = (int16_t*) source;
+	int32_t* s = (int32_t*) source;
 	for(int i = 0; i < length; i++)
 		target[i] = (unsigned char)((s[i] >> 24) + U8_0);
 }
@@ -265,7 +276,7 @@ void convert_s32_s24_le(data_t* target, data_t* source, int length)
 	}
 }
 
-void convert_s32_float(data_t* target, data_t* source, int length)
+void convert_s32_float_scalar(data_t* target, data_t* source, int length)
 {
 	int32_t* s = (int32_t*) source;
 	float* t = (float*) target;
@@ -281,7 +292,7 @@ void convert_s32_double(data_t* target, data_t* source, int length)
 		t[i] = s[i] / S32_FLT;
 }
 
-void convert_float_u8(data_t* target, data_t* source, int length)
+void convert_float_u8_scalar(data_t* target, data_t* source, int length)
 {
 	float* s = (float*) source;
 	float t;
@@ -292,12 +303,14 @@ void convert_float_u8(data_t* target, data_t* source, int length)
 			target[i] = 0;
 		else if(t >= 2.0f)
 			target[i] = 255;
+		else if(std::isnan(t))
+			target[i] = 127;
 		else
 			target[i] = (unsigned char)(t*127);
 	}
 }
 
-void convert_float_s16(data_t* target, data_t* source, int length)
+void convert_float_s16_scalar(data_t* target, data_t* source, int length)
 {
 	int16_t* t = (int16_t*) target;
 	float* s = (float*) source;
@@ -307,12 +320,14 @@ void convert_float_s16(data_t* target, data_t* source, int length)
 			t[i] = S16_MIN;
 		else if(s[i] >= FLT_MAX)
 			t[i] = S16_MAX;
+		else if(std::isnan(s[i]))
+			t[i] = 0;
 		else
 			t[i] = (int16_t)(s[i] * S16_MAX);
 	}
 }
 
-void convert_float_s24_be(data_t* target, data_t* source, int length)
+void convert_float_s24_be_scalar(data_t* target, data_t* source, int length)
 {
 	int32_t t;
 	float* s = (float*) source;
@@ -322,6 +337,8 @@ void convert_float_s24_be(data_t* target, data_t* source, int length)
 			t = S32_MIN;
 		else if(s[i] >= FLT_MAX)
 			t = S32_MAX;
+		else if(std::isnan(s[i]))
+			t = 0;
 		else
 			t = (int32_t)(s[i]*S32_MAX);
 		target[i*3] = t >> 24 & 0xFF;
@@ -330,7 +347,7 @@ void convert_float_s24_be(data_t* target, data_t* source, int length)
 	}
 }
 
-void convert_float_s24_le(data_t* target, data_t* source, int length)
+void convert_float_s24_le_scalar(data_t* target, data_t* source, int length)
 {
 	int32_t t;
 	float* s = (float*) source;
@@ -340,6 +357,8 @@ void convert_float_s24_le(data_t* target, data_t* source, int length)
 			t = S32_MIN;
 		else if(s[i] >= FLT_MAX)
 			t = S32_MAX;
+		else if(std::isnan(s[i]))
+			t = 0;
 		else
 			t = (int32_t)(s[i]*S32_MAX);
 		target[i*3+2] = t >> 24 & 0xFF;
@@ -348,7 +367,7 @@ void convert_float_s24_le(data_t* target, data_t* source, int length)
 	}
 }
 
-void convert_float_s32(data_t* target, data_t* source, int length)
+void convert_float_s32_scalar(data_t* target, data_t* source, int length)
 {
 	int32_t* t = (int32_t*) target;
 	float* s = (float*) source;
@@ -358,6 +377,8 @@ void convert_float_s32(data_t* target, data_t* source, int length)
 			t[i] = S32_MIN;
 		else if(s[i] >= FLT_MAX)
 			t[i] = S32_MAX;
+		else if(std::isnan(s[i]))
+			t[i] = 0;
 		else
 			t[i] = (int32_t)(s[i]*S32_MAX);
 	}
@@ -461,4 +482,307 @@ void convert_double_float(data_t* target, data_t* source, int length)
 		t[i] = s[i];
 }
 
+static inline float uniformNoise(uint32_t& state)
+{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+
+	return (state >> 8) / 16777216.0f;
+}
+
+static inline float triangularNoise()
+{
+	static thread_local uint32_t state = 0x2545F491;
+
+	float a = uniformNoise(state);
+	return a - uniformNoise(state);
+}
+
+static inline float clampSample(float x)
+{
+	return x <= FLT_MIN ? FLT_MIN : (x >= FLT_MAX ? FLT_MAX : (std::isnan(x) ? 0.0f : x));
+}
+
+static inline int32_t ditherSample(float x, float offset, float scale, float min, float max)
+{
+	float y = (clampSample(x) + offset) * scale + triangularNoise();
+	return int32_t(std::lrint(y <= min ? min : (y >= max ? max : y)));
+}
+
+void convert_float_u8_dither_scalar(data_t* target, data_t* source, int length)
+{
+	float* s = (float*) source;
+	for(int i = 0; i < length; i++)
+		target[i] = (unsigned char)ditherSample(s[i], FLT_MAX, 127.0f, 0.0f, 255.0f);
+}
+
+void convert_float_s16_dither_scalar(data_t* target, data_t* source, int length)
+{
+	int16_t* t = (int16_t*) target;
+	float* s = (float*) source;
+	for(int i = 0; i < length; i++)
+		t[i] = (int16_t)ditherSample(s[i], 0.0f, S16_FLT, -32768.0f, S16_FLT);
+}
+
+void convert_float_s24_be_dither_scalar(data_t* target, data_t* source, int length)
+{
+	int32_t t;
+	float* s = (float*) source;
+	for(int i = 0; i < length; i++)
+	{
+		t = ditherSample(s[i], 0.0f, 8388607.0f, -8388608.0f, 8388607.0f);
+		target[i*3] = t >> 16 & 0xFF;
+		target[i*3+1] = t >> 8 & 0xFF;
+		target[i*3+2] = t & 0xFF;
+	}
+}
+
+void convert_float_s24_le_dither_scalar(data_t* target, data_t* source, int length)
+{
+	int32_t t;
+	float* s = (float*) source;
+	for(int i = 0; i < length; i++)
+	{
+		t = ditherSample(s[i], 0.0f, 8388607.0f, -8388608.0f, 8388607.0f);
+		target[i*3+2] = t >> 16 & 0xFF;
+		target[i*3+1] = t >> 8 & 0xFF;
+		target[i*3] = t & 0xFF;
+	}
+}
+
+namespace {
+
+#ifdef AUD_CONVERTER_SSE
+struct Vector4
+{
+	typedef __m128 F;
+	typedef __m128i I;
+	static const int width = 4;
+
+	static inline F load(const float* p) { return _mm_loadu_ps(p); }
+	static inline void store(float* p, F v) { _mm_storeu_ps(p, v); }
+	static inline F set(float v) { return _mm_set1_ps(v); }
+	static inline F add(F a, F b) { return _mm_add_ps(a, b); }
+	static inline F sub(F a, F b) { return _mm_sub_ps(a, b); }
+	static inline F mul(F a, F b) { return _mm_mul_ps(a, b); }
+	static inline F div(F a, F b) { return _mm_div_ps(a, b); }
+	static inline F min(F a, F b) { return _mm_min_ps(a, b); }
+	static inline F max(F a, F b) { return _mm_max_ps(a, b); }
+	static inline F cmple(F a, F b) { return _mm_cmple_ps(a, b); }
+	static inline F cmpge(F a, F b) { return _mm_cmpge_ps(a, b); }
+	static inline F cmpord(F a, F b) { return _mm_cmpord_ps(a, b); }
+	static inline F select(F mask, F a, F b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+	static inline I truncate(F v) { return _mm_cvttps_epi32(v); }
+	static inline I round(F v) { return _mm_cvtps_epi32(v); }
+	static inline F convert(I v) { return _mm_cvtepi32_ps(v); }
+
+	static inline I truncateSaturated(F v)
+	{
+		// too large values convert to INT32_MIN and are flipped to INT32_MAX
+		return _mm_xor_si128(_mm_cvttps_epi32(v), _mm_castps_si128(_mm_cmpge_ps(v, _mm_set1_ps(2147483648.0f))));
+	}
+
+	static inline I loadU8(const data_t* p)
+	{
+		int32_t v;
+		std::memcpy(&v, p, sizeof(v));
+		__m128i zero = _mm_setzero_si128();
+		return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(v), zero), zero);
+	}
+
+	static inline I loadS16(const data_t* p)
+	{
+		__m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+		return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+	}
+
+	static inline I loadS32(const data_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+
+	static inline void storeU8(data_t* p, I v)
+	{
+		__m128i s16 = _mm_packs_epi32(v, v);
+		int32_t u8 = _mm_cvtsi128_si32(_mm_packus_epi16(s16, s16));
+		std::memcpy(p, &u8, sizeof(u8));
+	}
+
+	static inline void storeS16(data_t* p, I v) { _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packs_epi32(v, v)); }
+	static inline void storeS32(data_t* p, I v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+
+	static inline I bitXor(I a, I b) { return _mm_xor_si128(a, b); }
+	template <int n> static inline I shiftLeft(I v) { return _mm_slli_epi32(v, n); }
+	template <int n> static inline I shiftRight(I v) { return _mm_srli_epi32(v, n); }
+};
+#endif
+
+#ifdef AUD_CONVERTER_NEON
+struct Vector4
+{
+	typedef float32x4_t F;
+	typedef int32x4_t I;
+	static const int width = 4;
+
+	static inline F load(const float* p) { return vld1q_f32(p); }
+	static inline void store(float* p, F v) { vst1q_f32(p, v); }
+	static inline F set(float v) { return vdupq_n_f32(v); }
+	static inline F add(F a, F b) { return vaddq_f32(a, b); }
+	static inline F sub(F a, F b) { return vsubq_f32(a, b); }
+	static inline F mul(F a, F b) { return vmulq_f32(a, b); }
+	static inline F min(F a, F b) { return vminq_f32(a, b); }
+	static inline F max(F a, F b) { return vmaxq_f32(a, b); }
+	static inline F cmple(F a, F b) { return vreinterpretq_f32_u32(vcleq_f32(a, b)); }
+	static inline F cmpge(F a, F b) { return vreinterpretq_f32_u32(vcgeq_f32(a, b)); }
+	static inline F cmpord(F a, F b) { return vreinterpretq_f32_u32(vandq_u32(vceqq_f32(a, a), vceqq_f32(b, b))); }
+	static inline F select(F mask, F a, F b) { return vbslq_f32(vreinterpretq_u32_f32(mask), a, b); }
+
+#ifdef __aarch64__
+	static inline F div(F a, F b) { return vdivq_f32(a, b); }
+	static inline I round(F v) { return vcvtnq_s32_f32(v); }
+#else
+	static inline F div(F a, F b)
+	{
+		// two Newton-Raphson steps refine the reciprocal estimate
+		float32x4_t r = vrecpeq_f32(b);
+		r = vmulq_f32(vrecpsq_f32(b, r), r);
+		r = vmulq_f32(vrecpsq_f32(b, r), r);
+		return vmulq_f32(a, r);
+	}
+
+	static inline I round(F v)
+	{
+		float32x4_t half = vbslq_f32(vdupq_n_u32(0x80000000), v, vdupq_n_f32(0.5f));
+		return vcvtq_s32_f32(vaddq_f32(v, half));
+	}
+#endif
+
+	// the conversion truncates and saturates
+	static inline I truncate(F v) { return vcvtq_s32_f32(v); }
+	static inline I truncateSaturated(F v) { return vcvtq_s32_f32(v); }
+	static inline F convert(I v) { return vcvtq_f32_s32(v); }
+
+	static inline I loadU8(const data_t* p)
+	{
+		uint32_t v;
+		std::memcpy(&v, p, sizeof(v));
+		uint16x8_t u16 = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(v)));
+		return vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(u16)));
+	}
+
+	static inline I loadS16(const data_t* p) { return vmovl_s16(vld1_s16(reinterpret_cast<const int16_t*>(p))); }
+	static inline I loadS32(const data_t* p) { return vld1q_s32(reinterpret_cast<const int32_t*>(p)); }
+
+	static inline void storeU8(data_t* p, I v)
+	{
+		int16x4_t s16 = vqmovn_s32(v);
+		uint32_t u8 = vget_lane_u32(vreinterpret_u32_u8(vqmovun_s16(vcombine_s16(s16, s16))), 0);
+		std::memcpy(p, &u8, sizeof(u8));
+	}
+
+	static inline void storeS16(data_t* p, I v) { vst1_s16(reinterpret_cast<int16_t*>(p), vqmovn_s32(v)); }
+	static inline void storeS32(data_t* p, I v) { vst1q_s32(reinterpret_cast<int32_t*>(p), v); }
+
+	static inline I bitXor(I a, I b) { return veorq_s32(a, b); }
+	template <int n> static inline I shiftLeft(I v) { return vreinterpretq_s32_u32(vshlq_n_u32(vreinterpretq_u32_s32(v), n)); }
+	template <int n> static inline I shiftRight(I v) { return vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(v), n)); }
+};
+#endif
+
+ConverterKernels createKernels()
+{
+	ConverterKernels kernels;
+
+	kernels.u8_float = convert_u8_float_scalar;
+	kernels.s16_float = convert_s16_float_scalar;
+	kernels.s32_float = convert_s32_float_scalar;
+	kernels.float_u8 = convert_float_u8_scalar;
+	kernels.float_u8_dither = convert_float_u8_dither_scalar;
+	kernels.float_s16 = convert_float_s16_scalar;
+	kernels.float_s16_dither = convert_float_s16_dither_scalar;
+	kernels.float_s24_be = convert_float_s24_be_scalar;
+	kernels.float_s24_be_dither = convert_float_s24_be_dither_scalar;
+	kernels.float_s24_le = convert_float_s24_le_scalar;
+	kernels.float_s24_le_dither = convert_float_s24_le_dither_scalar;
+	kernels.float_s32 = convert_float_s32_scalar;
+
+#if defined(AUD_CONVERTER_SSE) || defined(AUD_CONVERTER_NEON)
+	getConverterKernels<Vector4>(kernels);
+#endif
+
+#ifdef AUD_CONVERTER_AVX2
+	if(__builtin_cpu_supports("avx2"))
+		getConverterKernelsAVX2(kernels);
+#endif
+
+	return kernels;
+}
+
+const ConverterKernels& getKernels()
+{
+	static const ConverterKernels kernels = createKernels();
+	return kernels;
+}
+
+}
+
+void convert_u8_float(data_t* target, data_t* source, int length)
+{
+	getKernels().u8_float(target, source, length);
+}
+
+void convert_s16_float(data_t* target, data_t* source, int length)
+{
+	getKernels().s16_float(target, source, length);
+}
+
+void convert_s32_float(data_t* target, data_t* source, int length)
+{
+	getKernels().s32_float(target, source, length);
+}
+
+void convert_float_u8(data_t* target, data_t* source, int length)
+{
+	getKernels().float_u8(target, source, length);
+}
+
+void convert_float_u8_dither(data_t* target, data_t* source, int length)
+{
+	getKernels().float_u8_dither(target, source, length);
+}
+
+void convert_float_s16(data_t* target, data_t* source, int length)
+{
+	getKernels().float_s16(target, source, length);
+}
+
+void convert_float_s16_dither(data_t* target, data_t* source, int length)
+{
+	getKernels().float_s16_dither(target, source, length);
+}
+
+void convert_float_s24_be(data_t* target, data_t* source, int length)
+{
+	getKernels().float_s24_be(target, source, length);
+}
+
+void convert_float_s24_be_dither(data_t* target, data_t* source, int length)
+{
+	getKernels().float_s24_be_dither(target, source, length);
+}
+
+void convert_float_s24_le(data_t* target, data_t* source, int length)
+{
+	getKernels().float_s24_le(target, source, length);
+}
+
+void convert_float_s24_le_dither(data_t* target, data_t* source, int length)
+{
+	getKernels().float_s24_le_dither(target, source, length);
+}
+
+void convert_float_s32(data_t* target, data_t* source, int length)
+{
+	getKernels().float_s32(target, source, length);
+}
+
 AUD_NAMESPACE_END
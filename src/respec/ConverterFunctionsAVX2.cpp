@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "ConverterKernels.h"
+
+#include <immintrin.h>
+
+AUD_NAMESPACE_BEGIN
+
+namespace {
+
+struct Vector8
+{
+	typedef __m256 F;
+	typedef __m256i I;
+	static const int width = 8;
+
+	static inline F load(const float* p) { return _mm256_loadu_ps(p); }
+	static inline void store(float* p, F v) { _mm256_storeu_ps(p, v); }
+	static inline F set(float v) { return _mm256_set1_ps(v); }
+	static inline F add(F a, F b) { return _mm256_add_ps(a, b); }
+	static inline F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+	static inline F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+	static inline F div(F a, F b) { return _mm256_div_ps(a, b); }
+	static inline F min(F a, F b) { return _mm256_min_ps(a, b); }
+	static inline F max(F a, F b) { return _mm256_max_ps(a, b); }
+	static inline F cmple(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+	static inline F cmpge(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+	static inline F cmpord(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_ORD_Q); }
+	static inline F select(F mask, F a, F b) { return _mm256_blendv_ps(b, a, mask); }
+
+	static inline I truncate(F v) { return _mm256_cvttps_epi32(v); }
+	static inline I round(F v) { return _mm256_cvtps_epi32(v); }
+	static inline F convert(I v) { return _mm256_cvtepi32_ps(v); }
+
+	static inline I truncateSaturated(F v)
+	{
+		// too large values convert to INT32_MIN and are flipped to INT32_MAX
+		return _mm256_xor_si256(_mm256_cvttps_epi32(v), _mm256_castps_si256(cmpge(v, set(2147483648.0f))));
+	}
+
+	static inline I loadU8(const data_t* p) { return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))); }
+	static inline I loadS16(const data_t* p) { return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+	static inline I loadS32(const data_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+
+	static inline __m128i packS16(I v)
+	{
+		return _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+	}
+
+	static inline void storeU8(data_t* p, I v)
+	{
+		__m128i s16 = packS16(v);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packus_epi16(s16, s16));
+	}
+
+	static inline void storeS16(data_t* p, I v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), packS16(v)); }
+	static inline void storeS32(data_t* p, I v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+
+	static inline I bitXor(I a, I b) { return _mm256_xor_si256(a, b); }
+	template <int n> static inline I shiftLeft(I v) { return _mm256_slli_epi32(v, n); }
+	template <int n> static inline I shiftRight(I v) { return _mm256_srli_epi32(v, n); }
+};
+
+}
+
+void getConverterKernelsAVX2(ConverterKernels& kernels)
+{
+	getConverterKernels<Vector8>(kernels);
+}
+
+AUD_NAMESPACE_END
@@ -0,0 +1,291 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/*
+* The vector implementations of the conversion functions. Every instruction set
+* provides a vector type V with the primitives used here and instantiates the
+* conversions with getConverterKernels(). The vector conversions work on blocks
+* of V::width samples with unaligned loads and stores and leave the remainder
+* to the scalar functions. Conversions that widen the samples run backwards
+* like the scalar ones, so that they can be done in place.
+*/
+
+#include "respec/ConverterFunctions.h"
+
+#include <cstdint>
+
+AUD_NAMESPACE_BEGIN
+
+/**
+ * The conversion functions that have vector implementations.
+ */
+struct ConverterKernels
+{
+	convert_f u8_float;
+	convert_f s16_float;
+	convert_f s32_float;
+	convert_f float_u8;
+	convert_f float_u8_dither;
+	convert_f float_s16;
+	convert_f float_s16_dither;
+	convert_f float_s24_be;
+	convert_f float_s24_be_dither;
+	convert_f float_s24_le;
+	convert_f float_s24_le_dither;
+	convert_f float_s32;
+};
+
+void convert_u8_float_scalar(data_t* target, data_t* source, int length);
+void convert_s16_float_scalar(data_t* target, data_t* source, int length);
+void convert_s32_float_scalar(data_t* target, data_t* source, int length);
+void convert_float_u8_scalar(data_t* target, data_t* source, int length);
+void convert_float_u8_dither_scalar(data_t* target, data_t* source, int length);
+void convert_float_s16_scalar(data_t* target, data_t* source, int length);
+void convert_float_s16_dither_scalar(data_t* target, data_t* source, int length);
+void convert_float_s24_be_scalar(data_t* target, data_t* source, int length);
+void convert_float_s24_be_dither_scalar(data_t* target, data_t* source, int length);
+void convert_float_s24_le_scalar(data_t* target, data_t* source, int length);
+void convert_float_s24_le_dither_scalar(data_t* target, data_t* source, int length);
+void convert_float_s32_scalar(data_t* target, data_t* source, int length);
+
+#ifdef AUD_CONVERTER_AVX2
+/**
+ * Sets the AVX2 implementations, the caller has to check processor support.
+ * \param kernels The kernels to set.
+ */
+void getConverterKernelsAVX2(ConverterKernels& kernels);
+#endif
+
+/// Replaces NaN samples with silence like the scalar functions.
+template <class V>
+static inline typename V::F removeNaN(typename V::F x)
+{
+	return V::select(V::cmpord(x, x), x, V::set(0.0f));
+}
+
+/// Clamps the samples to [-1, 1], NaN samples become silence.
+template <class V>
+static inline typename V::F clampSamples(typename V::F x)
+{
+	return V::min(V::max(removeNaN<V>(x), V::set(-1.0f)), V::set(1.0f));
+}
+
+/// Returns uniform noise in [0, 1) from a xorshift generator per lane.
+template <class V>
+static inline typename V::F uniformNoise(typename V::I& state)
+{
+	state = V::bitXor(state, V::template shiftLeft<13>(state));
+	state = V::bitXor(state, V::template shiftRight<17>(state));
+	state = V::bitXor(state, V::template shiftLeft<5>(state));
+
+	return V::mul(V::convert(V::template shiftRight<8>(state)), V::set(1.0f / 16777216.0f));
+}
+
+/// Returns triangular noise in (-1, 1).
+template <class V>
+static inline typename V::F triangularNoise(typename V::I& state)
+{
+	typename V::F a = uniformNoise<V>(state);
+	return V::sub(a, uniformNoise<V>(state));
+}
+
+/// Stores the upper three bytes of 32 bit samples as 24 bit samples.
+template <class V, bool big_endian>
+static inline void storeS24(data_t* target, typename V::I samples)
+{
+	int32_t values[V::width];
+	V::storeS32(reinterpret_cast<data_t*>(values), samples);
+
+	for(int i = 0; i < V::width; i++)
+	{
+		int32_t t = values[i];
+
+		if(big_endian)
+		{
+			target[i*3] = t >> 24 & 0xFF;
+			target[i*3+1] = t >> 16 & 0xFF;
+			target[i*3+2] = t >> 8 & 0xFF;
+		}
+		else
+		{
+			target[i*3+2] = t >> 24 & 0xFF;
+			target[i*3+1] = t >> 16 & 0xFF;
+			target[i*3] = t >> 8 & 0xFF;
+		}
+	}
+}
+
+template <class V>
+static inline void block_u8_float(data_t* target, const data_t* source)
+{
+	V::store(reinterpret_cast<float*>(target), V::mul(V::sub(V::convert(V::loadU8(source)), V::set(128.0f)), V::set(1.0f / 128.0f)));
+}
+
+template <class V>
+static inline void block_s16_float(data_t* target, const data_t* source)
+{
+	V::store(reinterpret_cast<float*>(target), V::div(V::convert(V::loadS16(source)), V::set(32767.0f)));
+}
+
+template <class V>
+static inline void block_s32_float(data_t* target, const data_t* source)
+{
+	V::store(reinterpret_cast<float*>(target), V::mul(V::convert(V::loadS32(source)), V::set(1.0f / 2147483648.0f)));
+}
+
+template <class V>
+static inline void block_float_u8(data_t* target, const data_t* source)
+{
+	typename V::F t = V::add(removeNaN<V>(V::load(reinterpret_cast<const float*>(source))), V::set(1.0f));
+	typename V::F y = V::mul(V::min(V::max(t, V::set(0.0f)), V::set(2.0f)), V::set(127.0f));
+	V::storeU8(target, V::truncate(V::select(V::cmpge(t, V::set(2.0f)), V::set(255.0f), y)));
+}
+
+template <class V>
+static inline void block_float_u8_dither(data_t* target, const data_t* source, typename V::I& state)
+{
+	typename V::F x = clampSamples<V>(V::load(reinterpret_cast<const float*>(source)));
+	typename V::F y = V::add(V::mul(V::add(x, V::set(1.0f)), V::set(127.0f)), triangularNoise<V>(state));
+	V::storeU8(target, V::round(V::min(V::max(y, V::set(0.0f)), V::set(255.0f))));
+}
+
+template <class V>
+static inline void block_float_s16(data_t* target, const data_t* source)
+{
+	typename V::F x = V::load(reinterpret_cast<const float*>(source));
+	typename V::F y = V::mul(clampSamples<V>(x), V::set(32767.0f));
+	V::storeS16(target, V::truncate(V::select(V::cmple(x, V::set(-1.0f)), V::set(-32768.0f), y)));
+}
+
+template <class V>
+static inline void block_float_s16_dither(data_t* target, const data_t* source, typename V::I& state)
+{
+	typename V::F x = clampSamples<V>(V::load(reinterpret_cast<const float*>(source)));
+	typename V::F y = V::add(V::mul(x, V::set(32767.0f)), triangularNoise<V>(state));
+	V::storeS16(target, V::round(V::min(V::max(y, V::set(-32768.0f)), V::set(32767.0f))));
+}
+
+template <class V>
+static inline typename V::I convertS32(const data_t* source)
+{
+	typename V::F x = clampSamples<V>(V::load(reinterpret_cast<const float*>(source)));
+	return V::truncateSaturated(V::mul(x, V::set(2147483648.0f)));
+}
+
+template <class V>
+static inline typename V::I convertS24Dither(const data_t* source, typename V::I& state)
+{
+	typename V::F x = clampSamples<V>(V::load(reinterpret_cast<const float*>(source)));
+	typename V::F y = V::add(V::mul(x, V::set(8388607.0f)), triangularNoise<V>(state));
+	return V::template shiftLeft<8>(V::round(V::min(V::max(y, V::set(-8388608.0f)), V::set(8388607.0f))));
+}
+
+template <class V, bool big_endian>
+static inline void block_float_s24(data_t* target, const data_t* source)
+{
+	storeS24<V, big_endian>(target, convertS32<V>(source));
+}
+
+template <class V, bool big_endian>
+static inline void block_float_s24_dither(data_t* target, const data_t* source, typename V::I& state)
+{
+	storeS24<V, big_endian>(target, convertS24Dither<V>(source, state));
+}
+
+template <class V>
+static inline void block_float_s32(data_t* target, const data_t* source)
+{
+	V::storeS32(target, convertS32<V>(source));
+}
+
+/// Converts in blocks from the start, for conversions that don't widen the samples.
+template <class V, int source_size, int target_size, void (*block)(data_t*, const data_t*), convert_f remainder>
+static void convertForward(data_t* target, data_t* source, int length)
+{
+	int i = 0;
+
+	for(; i + V::width <= length; i += V::width)
+		block(target + i * target_size, source + i * source_size);
+
+	if(i < length)
+		remainder(target + i * target_size, source + i * source_size, length - i);
+}
+
+/// Converts in blocks from the end, for conversions that widen the samples.
+template <class V, int source_size, int target_size, void (*block)(data_t*, const data_t*), convert_f remainder>
+static void convertBackward(data_t* target, data_t* source, int length)
+{
+	int rest = length % V::width;
+
+	for(int i = length - V::width; i >= rest; i -= V::width)
+		block(target + i * target_size, source + i * source_size);
+
+	if(rest)
+		remainder(target, source, rest);
+}
+
+/// Returns the dither noise generator state of the calling thread.
+template <class V>
+static inline uint32_t* getDitherState()
+{
+	static_assert(V::width <= 8, "The dither state has only eight lanes.");
+
+	static thread_local uint32_t state[8] = {0x9E3779B9, 0x7F4A7C15, 0xF39CC060, 0x5CEDC834, 0x2FE12A6D, 0x1B873593, 0xCC9E2D51, 0x85EBCA6B};
+	return state;
+}
+
+/// Converts FORMAT_FLOAT32 samples in blocks from the start with dither.
+template <class V, int target_size, void (*block)(data_t*, const data_t*, typename V::I&), convert_f remainder>
+static void convertDithered(data_t* target, data_t* source, int length)
+{
+	uint32_t* state = getDitherState<V>();
+	typename V::I random = V::loadS32(reinterpret_cast<const data_t*>(state));
+
+	int i = 0;
+
+	for(; i + V::width <= length; i += V::width)
+		block(target + i * target_size, source + i * sizeof(float), random);
+
+	V::storeS32(reinterpret_cast<data_t*>(state), random);
+
+	if(i < length)
+		remainder(target + i * target_size, source + i * sizeof(float), length - i);
+}
+
+/**
+ * Sets the vector implementations of the conversion functions.
+ * \param kernels The kernels to set.
+ */
+template <class V>
+static void getConverterKernels(ConverterKernels& kernels)
+{
+	kernels.u8_float = convertBackward<V, 1, 4, block_u8_float<V>, convert_u8_float_scalar>;
+	kernels.s16_float = convertBackward<V, 2, 4, block_s16_float<V>, convert_s16_float_scalar>;
+	kernels.s32_float = convertForward<V, 4, 4, block_s32_float<V>, convert_s32_float_scalar>;
+	kernels.float_u8 = convertForward<V, 4, 1, block_float_u8<V>, convert_float_u8_scalar>;
+	kernels.float_u8_dither = convertDithered<V, 1, block_float_u8_dither<V>, convert_float_u8_dither_scalar>;
+	kernels.float_s16 = convertForward<V, 4, 2, block_float_s16<V>, convert_float_s16_scalar>;
+	kernels.float_s16_dither = convertDithered<V, 2, block_float_s16_dither<V>, convert_float_s16_dither_scalar>;
+	kernels.float_s24_be = convertForward<V, 4, 3, block_float_s24<V, true>, convert_float_s24_be_scalar>;
+	kernels.float_s24_be_dither = convertDithered<V, 3, block_float_s24_dither<V, true>, convert_float_s24_be_dither_scalar>;
+	kernels.float_s24_le = convertForward<V, 4, 3, block_float_s24<V, false>, convert_float_s24_le_scalar>;
+	kernels.float_s24_le_dither = convertDithered<V, 3, block_float_s24_dither<V, false>, convert_float_s24_le_dither_scalar>;
+	kernels.float_s32 = convertForward<V, 4, 4, block_float_s32<V>, convert_float_s32_scalar>;
+}
+
+AUD_NAMESPACE_END
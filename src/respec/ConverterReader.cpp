@@ -19,23 +19,23 @@
 AUD_NAMESPACE_BEGIN
 
 ConverterReader::ConverterReader(std::shared_ptr<IReader> reader,
-										 DeviceSpecs specs) :
+										 DeviceSpecs specs, bool dither) :
 	EffectReader(reader),
 	m_format(specs.format)
 {
 	switch(m_format)
 	{
 	case FORMAT_U8:
-		m_convert = convert_float_u8;
+		m_convert = dither ? convert_float_u8_dither : convert_float_u8;
 		break;
 	case FORMAT_S16:
-		m_convert = convert_float_s16;
+		m_convert = dither ? convert_float_s16_dither : convert_float_s16;
 		break;
 	case FORMAT_S24:
 #ifdef __BIG_ENDIAN__
-		m_convert = convert_float_s24_be;
+		m_convert = dither ? convert_float_s24_be_dither : convert_float_s24_be;
 #else
-		m_convert = convert_float_s24_le;
+		m_convert = dither ? convert_float_s24_le_dither : convert_float_s24_le;
 #endif
 		break;
 	case FORMAT_S32:
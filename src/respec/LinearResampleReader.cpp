@@ -35,6 +35,11 @@ void LinearResampleReader::seek(int position)
 {
 	position = std::floor(position * double(m_reader->getSpecs().rate) / double(m_rate));
 	m_reader->seek(position);
+	reset();
+}
+
+void LinearResampleReader::reset()
+{
 	m_cache_ok = false;
 	m_cache_pos = 0;
 }
@@ -21,7 +21,8 @@
 
 AUD_NAMESPACE_BEGIN
 
-Mixer::Mixer(DeviceSpecs specs)
+Mixer::Mixer(DeviceSpecs specs) :
+	m_dither(false)
 {
 	setSpecs(specs);
 }
@@ -43,17 +44,17 @@ void Mixer::setSpecs(DeviceSpecs specs)
 	switch(m_specs.format)
 	{
 	case FORMAT_U8:
-		m_convert = convert_float_u8;
+		m_convert = m_dither ? convert_float_u8_dither : convert_float_u8;
 		break;
 	case FORMAT_S16:
-		m_convert = convert_float_s16;
+		m_convert = m_dither ? convert_float_s16_dither : convert_float_s16;
 		break;
 	case FORMAT_S24:
 
 #ifdef __BIG_ENDIAN__
-		m_convert = convert_float_s24_be;
+		m_convert = m_dither ? convert_float_s24_be_dither : convert_float_s24_be;
 #else
-		m_convert = convert_float_s24_le;
+		m_convert = m_dither ? convert_float_s24_le_dither : convert_float_s24_le;
 #endif
 		break;
 	case FORMAT_S32:
@@ -70,6 +71,17 @@ void Mixer::setSpecs(DeviceSpecs specs)
 	}
 }
 
+bool Mixer::isDithering() const
+{
+	return m_dither;
+}
+
+void Mixer::setDithering(bool dither)
+{
+	m_dither = dither;
+	setSpecs(m_specs);
+}
+
 void Mixer::clear(int length)
 {
 	m_buffer.assureSize(length * AUD_SAMPLE_SIZE(m_specs));
@@ -115,4 +127,9 @@ void Mixer::read(data_t* buffer, float volume)
 	m_convert(buffer, (data_t*) out, m_length * m_specs.channels);
 }
 
+sample_t* Mixer::getBuffer()
+{
+	return m_buffer.getBuffer();
+}
+
 AUD_NAMESPACE_END
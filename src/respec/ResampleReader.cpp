@@ -33,4 +33,9 @@ SampleRate ResampleReader::getRate()
 	return m_rate;
 }
 
+void ResampleReader::reset()
+{
+	seek(int(m_reader->getPosition() * double(m_rate) / m_reader->getSpecs().rate));
+}
+
 AUD_NAMESPACE_END
@@ -15,12 +15,13 @@
  ******************************************************************************/
 
 #include "respec/SpecsChanger.h"
+#include "util/Profiler.h"
 
 AUD_NAMESPACE_BEGIN
 
 std::shared_ptr<IReader> SpecsChanger::getReader() const
 {
-	return m_sound->createReader();
+	return Profiler::createReader(m_sound);
 }
 
 SpecsChanger::SpecsChanger(std::shared_ptr<ISound> sound,
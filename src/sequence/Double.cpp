@@ -16,6 +16,7 @@
 
 #include "sequence/Double.h"
 #include "sequence/DoubleReader.h"
+#include "util/Profiler.h"
 
 AUD_NAMESPACE_BEGIN
 
@@ -26,8 +27,8 @@ Double::Double(std::shared_ptr<ISound> sound1, std::shared_ptr<ISound> sound2) :
 
 std::shared_ptr<IReader> Double::createReader()
 {
-	std::shared_ptr<IReader> reader1 = m_sound1->createReader();
-	std::shared_ptr<IReader> reader2 = m_sound2->createReader();
+	std::shared_ptr<IReader> reader1 = Profiler::createReader(m_sound1);
+	std::shared_ptr<IReader> reader2 = Profiler::createReader(m_sound2);
 
 	return std::shared_ptr<IReader>(new DoubleReader(reader1, reader2));
 }
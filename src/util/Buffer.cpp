@@ -25,24 +25,40 @@
 
 AUD_NAMESPACE_BEGIN
 
-Buffer::Buffer(long long size)
+Buffer::Buffer(long long size) :
+	m_external(nullptr)
 {
 	m_size = size;
 	m_buffer = (data_t*) std::malloc(size + ALIGNMENT);
 }
 
+Buffer::Buffer(sample_t* data, long long size, std::function<void()> release) :
+	m_buffer(nullptr), m_external(data), m_release(release)
+{
+	m_size = size;
+}
+
 Buffer::~Buffer()
 {
 	std::free(m_buffer);
+
+	if(m_release)
+		m_release();
 }
 
 const sample_t* Buffer::getBuffer() const
 {
+	if(m_external)
+		return m_external;
+
 	return (sample_t*) ALIGN(m_buffer);
 }
 
 sample_t* Buffer::getBuffer()
 {
+	if(m_external)
+		return m_external;
+
 	return (sample_t*) ALIGN(m_buffer);
 }
 
@@ -53,7 +69,22 @@ long long Buffer::getSize() const
 
 void Buffer::resize(long long size, bool keep)
 {
-	if(keep)
+	if(m_external)
+	{
+		data_t* buffer = (data_t*) std::malloc(size + ALIGNMENT);
+
+		if(keep)
+			std::memcpy(ALIGN(buffer), m_external, std::min(size, m_size));
+
+		m_buffer = buffer;
+		m_external = nullptr;
+
+		if(m_release)
+			m_release();
+
+		m_release = nullptr;
+	}
+	else if(keep)
 	{
 		data_t* buffer = (data_t*) std::malloc(size + ALIGNMENT);
 
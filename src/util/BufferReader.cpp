@@ -27,6 +27,13 @@ BufferReader::BufferReader(std::shared_ptr<Buffer> buffer,
 {
 }
 
+void BufferReader::setBuffer(std::shared_ptr<Buffer> buffer, Specs specs)
+{
+	m_buffer = buffer;
+	m_specs = specs;
+	m_position = 0;
+}
+
 bool BufferReader::isSeekable() const
 {
 	return true;
@@ -52,7 +59,7 @@ Specs BufferReader::getSpecs() const
 	return m_specs;
 }
 
-void BufferReader::read(int& length, bool& eos, sample_t* buffer)
+sample_t* BufferReader::readDirect(int& length, bool& eos)
 {
 	eos = false;
 
@@ -70,11 +77,18 @@ void BufferReader::read(int& length, bool& eos, sample_t* buffer)
 	if(length < 0)
 	{
 		length = 0;
-		return;
+		return buf;
 	}
 
 	m_position += length;
-	std::memcpy(buffer, buf, length * sample_size);
+	return buf;
+}
+
+void BufferReader::read(int& length, bool& eos, sample_t* buffer)
+{
+	sample_t* buf = readDirect(length, eos);
+
+	std::memcpy(buffer, buf, length * AUD_SAMPLE_SIZE(m_specs));
 }
 
 AUD_NAMESPACE_END
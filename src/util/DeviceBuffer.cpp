@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "util/DeviceBuffer.h"
+#include "util/StreamBuffer.h"
+#include "util/ThreadPool.h"
+#include "respec/ChannelMapper.h"
+#include "respec/JOSResample.h"
+#include "Exception.h"
+
+AUD_NAMESPACE_BEGIN
+
+std::shared_ptr<StreamBuffer> DeviceBuffer::convert(std::shared_ptr<StreamBuffer> buffer, Specs specs, ResampleQuality quality)
+{
+	Specs source_specs = buffer->getSpecs();
+
+	DeviceSpecs target_specs;
+	target_specs.format = FORMAT_FLOAT32;
+	target_specs.specs = specs;
+
+	// mono sounds are panned by the device and are only resampled
+	if(source_specs.channels == CHANNELS_MONO)
+		target_specs.channels = CHANNELS_MONO;
+
+	std::shared_ptr<ISound> sound = buffer;
+
+	if(source_specs.rate != target_specs.rate)
+		sound = std::make_shared<JOSResample>(sound, target_specs, quality);
+
+	if(source_specs.channels != target_specs.channels)
+		sound = std::make_shared<ChannelMapper>(sound, target_specs);
+
+	if(sound == buffer)
+		return buffer;
+
+	return std::make_shared<StreamBuffer>(sound);
+}
+
+DeviceBuffer::DeviceBuffer(std::shared_ptr<ISound> sound, std::shared_ptr<ThreadPool> threadPool, ResampleQuality quality) :
+	m_buffer(std::dynamic_pointer_cast<StreamBuffer>(sound)), m_threadPool(threadPool), m_quality(quality), m_generation(0)
+{
+	if(!m_buffer)
+		m_buffer = std::make_shared<StreamBuffer>(sound);
+
+	m_specs = m_buffer->getSpecs();
+	m_converted = m_buffer;
+}
+
+std::shared_ptr<StreamBuffer> DeviceBuffer::getBuffer()
+{
+	return m_buffer;
+}
+
+Specs DeviceBuffer::getSpecs()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_specs;
+}
+
+void DeviceBuffer::setSpecs(Specs specs)
+{
+	unsigned int generation;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if(AUD_COMPARE_SPECS(m_specs, specs))
+			return;
+
+		generation = ++m_generation;
+
+		if(m_threadPool)
+		{
+			m_specs = specs;
+			m_converted = nullptr;
+			m_conversion = m_threadPool->enqueue(&DeviceBuffer::convert, m_buffer, specs, m_quality);
+			return;
+		}
+	}
+
+	// the previous data is played back until the conversion succeeded
+	std::shared_ptr<StreamBuffer> converted = convert(m_buffer, specs, m_quality);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	// a later call to setSpecs has superseded this conversion
+	if(generation != m_generation)
+		return;
+
+	m_specs = specs;
+	m_converted = converted;
+}
+
+std::shared_ptr<StreamBuffer> DeviceBuffer::getConverted()
+{
+	if(!m_converted && m_conversion.valid() && m_conversion.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+	{
+		try
+		{
+			m_converted = m_conversion.get();
+		}
+		catch(std::exception&)
+		{
+			// the original data keeps being played back, also if the memory ran out
+			m_specs = m_buffer->getSpecs();
+			m_converted = m_buffer;
+		}
+	}
+
+	return m_converted;
+}
+
+bool DeviceBuffer::isConverted()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return getConverted() != nullptr;
+}
+
+std::shared_ptr<StreamBuffer> DeviceBuffer::getCurrentBuffer()
+{
+	std::shared_ptr<StreamBuffer> buffer;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		buffer = getConverted();
+	}
+
+	if(!buffer)
+		buffer = m_buffer;
+
+	return buffer;
+}
+
+std::shared_ptr<IReader> DeviceBuffer::createReader()
+{
+	return getCurrentBuffer()->createReader();
+}
+
+AUD_NAMESPACE_END
@@ -17,50 +17,148 @@
 #include "util/FFTPlan.h"
 
 AUD_NAMESPACE_BEGIN
+
+std::mutex FFTPlan::m_cacheMutex;
+std::mutex FFTPlan::m_plannerMutex;
+std::string FFTPlan::m_wisdomFile;
+std::map<std::pair<int, double>, std::shared_future<std::shared_ptr<FFTPlan>>> FFTPlan::m_plans;
+
+/**
+ * Returns whether the creation of a cached plan has failed.
+ * \param plan The cached plan.
+ * \return Whether the plan is ready and holds an exception.
+ */
+static bool hasFailed(const std::shared_future<std::shared_ptr<FFTPlan>>& plan)
+{
+	if(plan.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return false;
+
+	try
+	{
+		plan.get();
+		return false;
+	}
+	catch(...)
+	{
+		return true;
+	}
+}
+
 FFTPlan::FFTPlan(double measureTime) :
 	FFTPlan(DEFAULT_N, measureTime)
 {
 }
 
-FFTPlan::FFTPlan(int n, double measureTime) :
-	m_N(n), m_bufferSize(((n/2)+1)*2*sizeof(fftwf_complex))
+int FFTPlan::getSize()
 {
-	fftwf_set_timelimit(measureTime);
-	void* buf = fftwf_malloc(m_bufferSize);
-	m_fftPlanR2C = fftwf_plan_dft_r2c_1d(m_N, (float*)buf, (fftwf_complex*)buf, FFTW_EXHAUSTIVE);
-	m_fftPlanC2R = fftwf_plan_dft_c2r_1d(m_N, (fftwf_complex*)buf, (float*)buf, FFTW_EXHAUSTIVE);
-	fftwf_free(buf);
+	return m_N;
 }
 
-FFTPlan::~FFTPlan()
+std::shared_ptr<FFTPlan> FFTPlan::get(int n, double measureTime)
 {
-	fftwf_destroy_plan(m_fftPlanC2R);
-	fftwf_destroy_plan(m_fftPlanR2C);
+	std::unique_lock<std::mutex> lock(m_cacheMutex);
+
+	auto key = std::make_pair(n, measureTime);
+	auto it = m_plans.find(key);
+
+	// plans that failed to be created asynchronously are created again
+	if(it != m_plans.end() && hasFailed(it->second))
+	{
+		m_plans.erase(it);
+		it = m_plans.end();
+	}
+
+	if(it != m_plans.end())
+	{
+		auto plan = it->second;
+		lock.unlock();
+		return plan.get();
+	}
+
+	std::promise<std::shared_ptr<FFTPlan>> promise;
+	m_plans[key] = promise.get_future().share();
+	lock.unlock();
+
+	try
+	{
+		auto plan = std::make_shared<FFTPlan>(n, measureTime);
+		promise.set_value(plan);
+		saveWisdom();
+		return plan;
+	}
+	catch(...)
+	{
+		promise.set_exception(std::current_exception());
+
+		lock.lock();
+		m_plans.erase(key);
+		throw;
+	}
 }
 
-int FFTPlan::getSize()
+std::shared_future<std::shared_ptr<FFTPlan>> FFTPlan::getAsync(int n, double measureTime)
 {
-	return m_N;
+	std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+	auto key = std::make_pair(n, measureTime);
+	auto it = m_plans.find(key);
+
+	if(it != m_plans.end() && !hasFailed(it->second))
+		return it->second;
+
+	// the failed plan is replaced here, the task can't erase it itself,
+	// as releasing the last reference to its future would join its own thread
+
+	auto future = std::async(std::launch::async, [n, measureTime]()
+	{
+		auto plan = std::make_shared<FFTPlan>(n, measureTime);
+		saveWisdom();
+		return plan;
+	}).share();
+
+	m_plans[key] = future;
+
+	return future;
 }
 
-void FFTPlan::FFT(void* buffer)
+void FFTPlan::clearCache()
 {
-	fftwf_execute_dft_r2c(m_fftPlanR2C, (float*)buffer, (fftwf_complex*)buffer);
+	std::map<std::pair<int, double>, std::shared_future<std::shared_ptr<FFTPlan>>> plans;
+
+	{
+		std::lock_guard<std::mutex> lock(m_cacheMutex);
+		std::swap(plans, m_plans);
+	}
+
+	// pending plans are waited for here, outside of the lock
+	plans.clear();
 }
 
-void FFTPlan::IFFT(void* buffer)
+bool FFTPlan::setWisdomFile(const std::string& filename)
 {
-	fftwf_execute_dft_c2r(m_fftPlanC2R, (fftwf_complex*)buffer, (float*)buffer);
+	{
+		std::lock_guard<std::mutex> lock(m_cacheMutex);
+		m_wisdomFile = filename;
+	}
+
+	if(filename.empty())
+		return false;
+
+	return importWisdom(filename);
 }
 
-void* FFTPlan::getBuffer()
+std::string FFTPlan::getWisdomFile()
 {
-	return fftwf_malloc(m_bufferSize);
+	std::lock_guard<std::mutex> lock(m_cacheMutex);
+	return m_wisdomFile;
 }
 
-void FFTPlan::freeBuffer(void* buffer)
+void FFTPlan::saveWisdom()
 {
-	fftwf_free(buffer);
+	std::string filename = getWisdomFile();
+
+	if(!filename.empty())
+		exportWisdom(filename);
 }
 
 AUD_NAMESPACE_END
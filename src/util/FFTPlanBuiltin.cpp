@@ -0,0 +1,435 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "util/FFTPlan.h"
+#include "Exception.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define AUD_FFT_SSE
+#ifdef __AVX__
+#define AUD_FFT_AVX
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AUD_FFT_NEON
+#endif
+
+AUD_NAMESPACE_BEGIN
+
+/*
+* The complex FFT of size N/2 is a radix-4 Stockham FFT (with a final
+* radix-2 stage for odd powers of two) on split real and imaginary arrays,
+* so that every stage is plain element wise arithmetic on contiguous data.
+* Stages with a stride of at least the vector width are vectorized over the
+* stride, the first stage with stride 1 is vectorized over the butterflies
+* and transposed before storing.
+*/
+
+struct ScalarVector
+{
+	typedef float type;
+	static const int width = 1;
+
+	static inline type load(const float* p) { return *p; }
+	static inline void store(float* p, type v) { *p = v; }
+	static inline type set(float v) { return v; }
+	static inline type add(type a, type b) { return a + b; }
+	static inline type sub(type a, type b) { return a - b; }
+	static inline type mul(type a, type b) { return a * b; }
+};
+
+#ifdef AUD_FFT_SSE
+struct Vector4
+{
+	typedef __m128 type;
+	static const int width = 4;
+
+	static inline type load(const float* p) { return _mm_loadu_ps(p); }
+	static inline void store(float* p, type v) { _mm_storeu_ps(p, v); }
+	static inline type set(float v) { return _mm_set1_ps(v); }
+	static inline type add(type a, type b) { return _mm_add_ps(a, b); }
+	static inline type sub(type a, type b) { return _mm_sub_ps(a, b); }
+	static inline type mul(type a, type b) { return _mm_mul_ps(a, b); }
+
+	static inline void transpose(type& a, type& b, type& c, type& d)
+	{
+		_MM_TRANSPOSE4_PS(a, b, c, d);
+	}
+};
+#endif
+
+#ifdef AUD_FFT_NEON
+struct Vector4
+{
+	typedef float32x4_t type;
+	static const int width = 4;
+
+	static inline type load(const float* p) { return vld1q_f32(p); }
+	static inline void store(float* p, type v) { vst1q_f32(p, v); }
+	static inline type set(float v) { return vdupq_n_f32(v); }
+	static inline type add(type a, type b) { return vaddq_f32(a, b); }
+	static inline type sub(type a, type b) { return vsubq_f32(a, b); }
+	static inline type mul(type a, type b) { return vmulq_f32(a, b); }
+
+	static inline void transpose(type& a, type& b, type& c, type& d)
+	{
+		float32x4x2_t ab = vtrnq_f32(a, b);
+		float32x4x2_t cd = vtrnq_f32(c, d);
+		a = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+		b = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+		c = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+		d = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+	}
+};
+#endif
+
+#ifdef AUD_FFT_AVX
+struct Vector8
+{
+	typedef __m256 type;
+	static const int width = 8;
+
+	static inline type load(const float* p) { return _mm256_loadu_ps(p); }
+	static inline void store(float* p, type v) { _mm256_storeu_ps(p, v); }
+	static inline type set(float v) { return _mm256_set1_ps(v); }
+	static inline type add(type a, type b) { return _mm256_add_ps(a, b); }
+	static inline type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+	static inline type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+};
+#endif
+
+template <class V>
+static inline void butterfly(typename V::type* r, typename V::type* i, const typename V::type* w)
+{
+	typedef typename V::type T;
+
+	T apcr = V::add(r[0], r[2]);
+	T apci = V::add(i[0], i[2]);
+	T amcr = V::sub(r[0], r[2]);
+	T amci = V::sub(i[0], i[2]);
+	T bpdr = V::add(r[1], r[3]);
+	T bpdi = V::add(i[1], i[3]);
+	T bmdr = V::sub(r[1], r[3]);
+	T bmdi = V::sub(i[1], i[3]);
+
+	r[0] = V::add(apcr, bpdr);
+	i[0] = V::add(apci, bpdi);
+
+	// (a - c) - j(b - d)
+	T xr = V::add(amcr, bmdi);
+	T xi = V::sub(amci, bmdr);
+	r[1] = V::sub(V::mul(xr, w[0]), V::mul(xi, w[1]));
+	i[1] = V::add(V::mul(xr, w[1]), V::mul(xi, w[0]));
+
+	xr = V::sub(apcr, bpdr);
+	xi = V::sub(apci, bpdi);
+	r[2] = V::sub(V::mul(xr, w[2]), V::mul(xi, w[3]));
+	i[2] = V::add(V::mul(xr, w[3]), V::mul(xi, w[2]));
+
+	// (a - c) + j(b - d)
+	xr = V::sub(amcr, bmdi);
+	xi = V::add(amci, bmdr);
+	r[3] = V::sub(V::mul(xr, w[4]), V::mul(xi, w[5]));
+	i[3] = V::add(V::mul(xr, w[5]), V::mul(xi, w[4]));
+}
+
+template <class V>
+static void radix4Stage(const float* xr, const float* xi, float* yr, float* yi, int s, int m, const float* twiddles)
+{
+	typedef typename V::type T;
+
+	for(int p = 0; p < m; p++)
+	{
+		T w[6];
+
+		for(int k = 0; k < 6; k++)
+			w[k] = V::set(twiddles[k * m + p]);
+
+		for(int q = 0; q < s; q += V::width)
+		{
+			T r[4], i[4];
+
+			for(int k = 0; k < 4; k++)
+			{
+				r[k] = V::load(xr + q + s * (p + k * m));
+				i[k] = V::load(xi + q + s * (p + k * m));
+			}
+
+			butterfly<V>(r, i, w);
+
+			for(int k = 0; k < 4; k++)
+			{
+				V::store(yr + q + s * (4 * p + k), r[k]);
+				V::store(yi + q + s * (4 * p + k), i[k]);
+			}
+		}
+	}
+}
+
+#if defined(AUD_FFT_SSE) || defined(AUD_FFT_NEON)
+static void radix4FirstStage(const float* xr, const float* xi, float* yr, float* yi, int m, const float* twiddles)
+{
+	typedef Vector4::type T;
+
+	for(int p = 0; p < m; p += 4)
+	{
+		T r[4], i[4], w[6];
+
+		for(int k = 0; k < 6; k++)
+			w[k] = Vector4::load(twiddles + k * m + p);
+
+		for(int k = 0; k < 4; k++)
+		{
+			r[k] = Vector4::load(xr + p + k * m);
+			i[k] = Vector4::load(xi + p + k * m);
+		}
+
+		butterfly<Vector4>(r, i, w);
+
+		// the outputs of butterfly p + k are stored next to each other
+		Vector4::transpose(r[0], r[1], r[2], r[3]);
+		Vector4::transpose(i[0], i[1], i[2], i[3]);
+
+		for(int k = 0; k < 4; k++)
+		{
+			Vector4::store(yr + 4 * (p + k), r[k]);
+			Vector4::store(yi + 4 * (p + k), i[k]);
+		}
+	}
+}
+#endif
+
+template <class V>
+static void radix2Stage(const float* xr, const float* xi, float* yr, float* yi, int s)
+{
+	typedef typename V::type T;
+
+	for(int q = 0; q < s; q += V::width)
+	{
+		T ar = V::load(xr + q);
+		T ai = V::load(xi + q);
+		T br = V::load(xr + q + s);
+		T bi = V::load(xi + q + s);
+
+		V::store(yr + q, V::add(ar, br));
+		V::store(yi + q, V::add(ai, bi));
+		V::store(yr + q + s, V::sub(ar, br));
+		V::store(yi + q + s, V::sub(ai, bi));
+	}
+}
+
+static inline void radix4(const float* xr, const float* xi, float* yr, float* yi, int s, int m, const float* twiddles)
+{
+#ifdef AUD_FFT_AVX
+	if(s >= Vector8::width)
+		return radix4Stage<Vector8>(xr, xi, yr, yi, s, m, twiddles);
+#endif
+#if defined(AUD_FFT_SSE) || defined(AUD_FFT_NEON)
+	if(s >= Vector4::width)
+		return radix4Stage<Vector4>(xr, xi, yr, yi, s, m, twiddles);
+	if(m >= Vector4::width)
+		return radix4FirstStage(xr, xi, yr, yi, m, twiddles);
+#endif
+	radix4Stage<ScalarVector>(xr, xi, yr, yi, s, m, twiddles);
+}
+
+static inline void radix2(const float* xr, const float* xi, float* yr, float* yi, int s)
+{
+#ifdef AUD_FFT_AVX
+	if(s >= Vector8::width)
+		return radix2Stage<Vector8>(xr, xi, yr, yi, s);
+#endif
+#if defined(AUD_FFT_SSE) || defined(AUD_FFT_NEON)
+	if(s >= Vector4::width)
+		return radix2Stage<Vector4>(xr, xi, yr, yi, s);
+#endif
+	radix2Stage<ScalarVector>(xr, xi, yr, yi, s);
+}
+
+/**
+* Calculates the complex FFT of x, using y as second buffer.
+* The buffers contain n real parts followed by n imaginary parts.
+* \return The buffer with the result.
+*/
+static float* transform(float* x, float* y, int n, const float* twiddles)
+{
+	int s = 1;
+	int size = n;
+
+	for(; size >= 4; size /= 4, s *= 4)
+	{
+		int m = size / 4;
+
+		radix4(x, x + n, y, y + n, s, m, twiddles);
+		twiddles += 6 * m;
+		std::swap(x, y);
+	}
+
+	if(size == 2)
+	{
+		radix2(x, x + n, y, y + n, s);
+		std::swap(x, y);
+	}
+
+	return x;
+}
+
+static inline float* getScratch(int size)
+{
+	thread_local std::vector<float> scratch;
+
+	if(scratch.size() < (unsigned int) size)
+		scratch.resize(size);
+
+	return scratch.data();
+}
+
+FFTPlan::FFTPlan(int n, [[maybe_unused]] double measureTime) :
+	m_N(n), m_bufferSize(((n/2)+1)*2*sizeof(fftwf_complex))
+{
+	if(n < 2 || (n & (n - 1)))
+		AUD_THROW(StateException, "The built-in FFT only supports sizes that are a power of two.");
+
+	int half = n / 2;
+
+	for(int size = half; size >= 4; size /= 4)
+	{
+		int m = size / 4;
+
+		for(int k = 1; k < 4; k++)
+			for(int part = 0; part < 2; part++)
+				for(int p = 0; p < m; p++)
+				{
+					double angle = -2.0 * M_PI * k * p / size;
+					m_twiddles.push_back(part ? std::sin(angle) : std::cos(angle));
+				}
+	}
+
+	m_realTwiddles.resize(2 * (half + 1));
+
+	for(int k = 0; k <= half; k++)
+	{
+		double angle = -2.0 * M_PI * k / n;
+		m_realTwiddles[k] = std::cos(angle);
+		m_realTwiddles[half + 1 + k] = std::sin(angle);
+	}
+}
+
+FFTPlan::~FFTPlan()
+{
+}
+
+void FFTPlan::FFT(void* buffer)
+{
+	int n = m_N / 2;
+	float* data = (float*)buffer;
+	float* x = getScratch(4 * n);
+
+	// the even samples are the real and the odd ones the imaginary part
+	for(int j = 0; j < n; j++)
+	{
+		x[j] = data[2 * j];
+		x[n + j] = data[2 * j + 1];
+	}
+
+	const float* zr = transform(x, x + 2 * n, n, m_twiddles.data());
+	const float* zi = zr + n;
+	const float* wr = m_realTwiddles.data();
+	const float* wi = wr + n + 1;
+
+	data[0] = zr[0] + zi[0];
+	data[1] = 0;
+	data[2 * n] = zr[0] - zi[0];
+	data[2 * n + 1] = 0;
+
+	for(int k = 1; k < n; k++)
+	{
+		// even part (Z[k] + conj(Z[n-k])) / 2, odd part (Z[k] - conj(Z[n-k])) / 2j
+		float er = (zr[k] + zr[n - k]) * 0.5f;
+		float ei = (zi[k] - zi[n - k]) * 0.5f;
+		float or_ = (zi[k] + zi[n - k]) * 0.5f;
+		float oi = (zr[n - k] - zr[k]) * 0.5f;
+
+		data[2 * k] = er + wr[k] * or_ - wi[k] * oi;
+		data[2 * k + 1] = ei + wr[k] * oi + wi[k] * or_;
+	}
+}
+
+void FFTPlan::IFFT(void* buffer)
+{
+	int n = m_N / 2;
+	float* data = (float*)buffer;
+	float* x = getScratch(4 * n);
+	const float* wr = m_realTwiddles.data();
+	const float* wi = wr + n + 1;
+
+	for(int k = 0; k < n; k++)
+	{
+		float ar = data[2 * k];
+		float ai = data[2 * k + 1];
+		float br = data[2 * (n - k)];
+		float bi = -data[2 * (n - k) + 1];
+
+		// twice the even part and twice the odd part rotated back
+		float er = ar + br;
+		float ei = ai + bi;
+		float dr = ar - br;
+		float di = ai - bi;
+		float or_ = dr * wr[k] + di * wi[k];
+		float oi = di * wr[k] - dr * wi[k];
+
+		// the inverse FFT is done with the forward one by swapping real and imaginary parts
+		x[k] = ei + or_;
+		x[n + k] = er - oi;
+	}
+
+	const float* zi = transform(x, x + 2 * n, n, m_twiddles.data());
+	const float* zr = zi + n;
+
+	for(int j = 0; j < n; j++)
+	{
+		data[2 * j] = zr[j];
+		data[2 * j + 1] = zi[j];
+	}
+}
+
+void* FFTPlan::getBuffer()
+{
+	return std::malloc(m_bufferSize);
+}
+
+void FFTPlan::freeBuffer(void* buffer)
+{
+	std::free(buffer);
+}
+
+bool FFTPlan::importWisdom([[maybe_unused]] const std::string& filename)
+{
+	return false;
+}
+
+bool FFTPlan::exportWisdom([[maybe_unused]] const std::string& filename)
+{
+	return false;
+}
+
+AUD_NAMESPACE_END
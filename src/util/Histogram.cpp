@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "util/Histogram.h"
+
+#include <algorithm>
+#include <limits>
+
+AUD_NAMESPACE_BEGIN
+
+Histogram::Histogram()
+{
+	reset();
+}
+
+void Histogram::add(uint64_t value)
+{
+	m_bins[getBin(value)].fetch_add(1, std::memory_order_relaxed);
+	m_count.fetch_add(1, std::memory_order_relaxed);
+	m_sum.fetch_add(value, std::memory_order_relaxed);
+
+	uint64_t current = m_min.load(std::memory_order_relaxed);
+	while(value < current && !m_min.compare_exchange_weak(current, value, std::memory_order_relaxed));
+
+	current = m_max.load(std::memory_order_relaxed);
+	while(value > current && !m_max.compare_exchange_weak(current, value, std::memory_order_relaxed));
+}
+
+void Histogram::reset()
+{
+	for(auto& bin : m_bins)
+		bin.store(0, std::memory_order_relaxed);
+
+	m_count = 0;
+	m_sum = 0;
+	m_min = std::numeric_limits<uint64_t>::max();
+	m_max = 0;
+}
+
+uint64_t Histogram::getCount() const
+{
+	return m_count.load(std::memory_order_relaxed);
+}
+
+double Histogram::getMean() const
+{
+	uint64_t count = getCount();
+
+	return count ? double(m_sum.load(std::memory_order_relaxed)) / count : 0;
+}
+
+uint64_t Histogram::getMinimum() const
+{
+	return getCount() ? m_min.load(std::memory_order_relaxed) : 0;
+}
+
+uint64_t Histogram::getMaximum() const
+{
+	return m_max.load(std::memory_order_relaxed);
+}
+
+uint64_t Histogram::getPercentile(double percentile) const
+{
+	uint64_t count = getCount();
+
+	if(!count)
+		return 0;
+
+	uint64_t rank = std::max(uint64_t(1), uint64_t(std::min(std::max(percentile, 0.0), 1.0) * count + 0.5));
+	uint64_t sum = 0;
+
+	for(int bin = 0; bin < BINS - 1; bin++)
+	{
+		sum += getBinCount(bin);
+
+		if(sum >= rank)
+			return std::min(getBinStart(bin + 1) - 1, getMaximum());
+	}
+
+	return getMaximum();
+}
+
+int Histogram::getBin(uint64_t value)
+{
+	if(value < 4)
+		return int(value);
+
+	int exponent = 2;
+
+	while(value >> (exponent + 1))
+		exponent++;
+
+	// the two bits after the leading one select the bin within the power of two
+	return 4 * (exponent - 1) + int((value >> (exponent - 2)) & 3);
+}
+
+uint64_t Histogram::getBinStart(int bin)
+{
+	if(bin < 4)
+		return uint64_t(bin);
+
+	return uint64_t(4 + bin % 4) << (bin / 4 - 1);
+}
+
+uint64_t Histogram::getBinCount(int bin) const
+{
+	return m_bins[bin].load(std::memory_order_relaxed);
+}
+
+AUD_NAMESPACE_END
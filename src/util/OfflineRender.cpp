@@ -0,0 +1,41 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "util/OfflineRender.h"
+
+AUD_NAMESPACE_BEGIN
+
+static thread_local int offline_render_depth = 0;
+
+OfflineRender::OfflineRender(bool active) :
+	m_active(active)
+{
+	if(m_active)
+		offline_render_depth++;
+}
+
+OfflineRender::~OfflineRender()
+{
+	if(m_active)
+		offline_render_depth--;
+}
+
+bool OfflineRender::isActive()
+{
+	return offline_render_depth > 0;
+}
+
+AUD_NAMESPACE_END
@@ -0,0 +1,124 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "util/PlanarBuffer.h"
+
+#include "IPlanarReader.h"
+#include "IReader.h"
+
+#include <algorithm>
+
+AUD_NAMESPACE_BEGIN
+
+PlanarBuffer::PlanarBuffer(int length, int channels) :
+	m_length(0)
+{
+	assureSize(length, channels);
+}
+
+sample_t* const* PlanarBuffer::getChannels() const
+{
+	return m_channels.data();
+}
+
+sample_t* PlanarBuffer::getChannel(int channel) const
+{
+	return m_channels[channel];
+}
+
+int PlanarBuffer::getChannelCount() const
+{
+	return m_channels.size();
+}
+
+int PlanarBuffer::getLength() const
+{
+	return m_length;
+}
+
+void PlanarBuffer::assureSize(int length, int channels)
+{
+	if(length <= m_length && channels == int(m_channels.size()))
+		return;
+
+	m_length = std::max(length, m_length);
+	m_buffer.assureSize(m_length * channels * sizeof(sample_t));
+	m_channels.resize(channels);
+
+	for(int channel = 0; channel < channels; channel++)
+		m_channels[channel] = m_buffer.getBuffer() + channel * m_length;
+}
+
+void PlanarBuffer::read(IReader& reader, int& length, bool& eos)
+{
+	assureSize(length, reader.getSpecs().channels);
+	read(reader, length, eos, m_channels.data(), m_interleaved);
+}
+
+void PlanarBuffer::read(IReader& reader, int& length, bool& eos, sample_t* const* buffers, Buffer& interleaved)
+{
+	IPlanarReader* planar = dynamic_cast<IPlanarReader*>(&reader);
+
+	if(planar)
+	{
+		planar->readPlanar(length, eos, buffers);
+		return;
+	}
+
+	Specs specs = reader.getSpecs();
+
+	interleaved.assureSize(length * AUD_SAMPLE_SIZE(specs));
+	reader.read(length, eos, interleaved.getBuffer());
+	deinterleave(interleaved.getBuffer(), buffers, length, specs.channels);
+}
+
+void PlanarBuffer::deinterleave(const sample_t* source, sample_t* const* buffers, int length, int channels)
+{
+	if(channels == 1)
+	{
+		if(buffers[0] != source)
+			std::copy(source, source + length, buffers[0]);
+		return;
+	}
+
+	for(int channel = 0; channel < channels; channel++)
+	{
+		sample_t* buffer = buffers[channel];
+
+		for(int i = 0; i < length; i++)
+			buffer[i] = source[i * channels + channel];
+	}
+}
+
+void PlanarBuffer::interleave(const sample_t* const* buffers, sample_t* target, int length, int channels)
+{
+	if(channels == 1)
+	{
+		if(buffers[0] != target)
+			std::copy(buffers[0], buffers[0] + length, target);
+		return;
+	}
+
+	for(int channel = 0; channel < channels; channel++)
+	{
+		const sample_t* buffer = buffers[channel];
+
+		for(int i = 0; i < length; i++)
+			target[i * channels + channel] = buffer[i];
+	}
+}
+
+AUD_NAMESPACE_END
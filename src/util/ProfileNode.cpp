@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "util/ProfileNode.h"
+
+AUD_NAMESPACE_BEGIN
+
+ProfileNode::ProfileNode(const std::string& name, std::shared_ptr<ProfileNode> type) :
+	m_name(name), m_type(type), m_calls(0), m_samples(0), m_time(0), m_selfTime(0), m_linked(false)
+{
+}
+
+void ProfileNode::record(uint64_t samples, uint64_t time, uint64_t selfTime)
+{
+	m_calls.fetch_add(1, std::memory_order_relaxed);
+	m_samples.fetch_add(samples, std::memory_order_relaxed);
+	m_time.fetch_add(time, std::memory_order_relaxed);
+	m_selfTime.fetch_add(selfTime, std::memory_order_relaxed);
+
+	if(m_type)
+		m_type->record(samples, time, selfTime);
+}
+
+void ProfileNode::link(const std::shared_ptr<ProfileNode>& child)
+{
+	if(!m_type || child->m_linked.exchange(true))
+		return;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_children.push_back(child);
+}
+
+void ProfileNode::reset()
+{
+	m_calls = 0;
+	m_samples = 0;
+	m_time = 0;
+	m_selfTime = 0;
+
+	for(auto& child : getChildren())
+		child->reset();
+}
+
+const std::string& ProfileNode::getName() const
+{
+	return m_name;
+}
+
+std::shared_ptr<ProfileNode> ProfileNode::getType() const
+{
+	return m_type;
+}
+
+uint64_t ProfileNode::getCalls() const
+{
+	return m_calls.load(std::memory_order_relaxed);
+}
+
+uint64_t ProfileNode::getSamples() const
+{
+	return m_samples.load(std::memory_order_relaxed);
+}
+
+double ProfileNode::getTime() const
+{
+	return m_time.load(std::memory_order_relaxed) * 1e-9;
+}
+
+double ProfileNode::getSelfTime() const
+{
+	return m_selfTime.load(std::memory_order_relaxed) * 1e-9;
+}
+
+std::vector<std::shared_ptr<ProfileNode>> ProfileNode::getChildren() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_children;
+}
+
+AUD_NAMESPACE_END
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "util/ProfileScope.h"
+
+AUD_NAMESPACE_BEGIN
+
+static thread_local ProfileScope* current_profile_scope = nullptr;
+
+ProfileScope::ProfileScope(const std::shared_ptr<ProfileNode>& node, bool active) :
+	m_node(node), m_active(active && node), m_parent(nullptr), m_childTime(0), m_samples(0)
+{
+	if(!m_active)
+		return;
+
+	m_parent = current_profile_scope;
+	current_profile_scope = this;
+	m_start = Profiler::Clock::now();
+}
+
+ProfileScope::~ProfileScope()
+{
+	if(!m_active)
+		return;
+
+	auto end = Profiler::Clock::now();
+	uint64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_start).count();
+
+	current_profile_scope = m_parent;
+
+	m_node->record(m_samples, time, time > m_childTime ? time - m_childTime : 0);
+
+	if(m_parent)
+	{
+		m_parent->m_childTime += time;
+		m_parent->m_node->link(m_node);
+	}
+
+	if(Profiler::isTracing())
+		Profiler::trace(*m_node, m_start, end);
+}
+
+void ProfileScope::setSamples(int samples)
+{
+	m_samples = samples;
+}
+
+AUD_NAMESPACE_END
@@ -0,0 +1,249 @@
+/*******************************************************************************
+ * Copyright 2009-2026 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "util/Profiler.h"
+#include "fx/ProfileReader.h"
+#include "ISound.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+AUD_NAMESPACE_BEGIN
+
+namespace {
+
+struct TraceEvent
+{
+	const ProfileNode* node;
+	Profiler::Clock::time_point start;
+	Profiler::Clock::time_point end;
+	size_t thread;
+};
+
+struct ProfilerState
+{
+	std::atomic<bool> enabled{false};
+
+	std::mutex typeMutex;
+	std::map<std::string, std::shared_ptr<ProfileNode>> types;
+
+	std::atomic<bool> tracing{false};
+	std::mutex traceMutex;
+	std::vector<TraceEvent> events;
+	size_t eventCount{0};
+	Profiler::Clock::time_point traceStart;
+};
+
+ProfilerState& getState()
+{
+	static ProfilerState state;
+	return state;
+}
+
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+	getState().enabled = enabled;
+}
+
+bool Profiler::isEnabled()
+{
+	return getState().enabled.load(std::memory_order_relaxed);
+}
+
+std::shared_ptr<IReader> Profiler::createReader(std::shared_ptr<ISound> sound)
+{
+	std::shared_ptr<IReader> reader = sound->createReader();
+
+	if(!isEnabled() || !reader)
+		return reader;
+
+	const ISound& type = *sound;
+
+	return std::make_shared<ProfileReader>(reader, getTypeName(typeid(type)));
+}
+
+std::shared_ptr<ProfileNode> Profiler::getTypeNode(const std::string& name)
+{
+	ProfilerState& state = getState();
+
+	std::lock_guard<std::mutex> lock(state.typeMutex);
+
+	std::shared_ptr<ProfileNode>& node = state.types[name];
+
+	if(!node)
+		node = std::make_shared<ProfileNode>(name);
+
+	return node;
+}
+
+std::string Profiler::getTypeName(const std::type_info& type)
+{
+	std::string name = type.name();
+
+#ifdef __GNUG__
+	int status;
+	char* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+
+	if(demangled)
+	{
+		if(status == 0)
+			name = demangled;
+
+		std::free(demangled);
+	}
+#endif
+
+	// MSVC prefixes the names with the kind of type
+	for(const char* prefix : {"class ", "struct "})
+	{
+		if(name.compare(0, std::char_traits<char>::length(prefix), prefix) == 0)
+			name.erase(0, std::char_traits<char>::length(prefix));
+	}
+
+	size_t separator = name.rfind("::");
+
+	if(separator != std::string::npos)
+		name.erase(0, separator + 2);
+
+	return name;
+}
+
+std::vector<std::shared_ptr<ProfileNode>> Profiler::getProfile()
+{
+	ProfilerState& state = getState();
+
+	std::lock_guard<std::mutex> lock(state.typeMutex);
+
+	std::vector<std::shared_ptr<ProfileNode>> profile;
+
+	for(auto& type : state.types)
+	{
+		if(type.second->getCalls())
+			profile.push_back(type.second);
+	}
+
+	return profile;
+}
+
+void Profiler::reset()
+{
+	ProfilerState& state = getState();
+
+	std::lock_guard<std::mutex> lock(state.typeMutex);
+
+	// the nodes are kept since readers and traces refer to them
+	for(auto& type : state.types)
+		type.second->reset();
+}
+
+void Profiler::startTrace(int events)
+{
+	ProfilerState& state = getState();
+
+	std::lock_guard<std::mutex> lock(state.traceMutex);
+
+	state.events.resize(std::max(events, 0));
+	state.eventCount = 0;
+	state.traceStart = Clock::now();
+	state.tracing = true;
+}
+
+void Profiler::stopTrace()
+{
+	getState().tracing = false;
+}
+
+bool Profiler::isTracing()
+{
+	return getState().tracing.load(std::memory_order_relaxed);
+}
+
+void Profiler::trace(const ProfileNode& node, Clock::time_point start, Clock::time_point end)
+{
+	ProfilerState& state = getState();
+
+	// never block the mixing thread, the read is dropped instead
+	std::unique_lock<std::mutex> lock(state.traceMutex, std::try_to_lock);
+
+	if(!lock.owns_lock() || !state.tracing || state.eventCount >= state.events.size())
+		return;
+
+	// only type nodes live as long as the trace
+	std::shared_ptr<ProfileNode> type = node.getType();
+
+	TraceEvent& event = state.events[state.eventCount++];
+	event.node = type ? type.get() : &node;
+	event.start = start;
+	event.end = end;
+	event.thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+}
+
+void Profiler::writeTrace(std::ostream& stream)
+{
+	ProfilerState& state = getState();
+
+	std::lock_guard<std::mutex> lock(state.traceMutex);
+
+	std::map<size_t, int> threads;
+
+	std::ios_base::fmtflags flags = stream.flags();
+	std::streamsize precision = stream.precision();
+
+	stream << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+
+	for(size_t i = 0; i < state.eventCount; i++)
+	{
+		const TraceEvent& event = state.events[i];
+
+		auto thread = threads.insert(std::make_pair(event.thread, int(threads.size()) + 1)).first;
+
+		double start = std::chrono::duration<double, std::micro>(event.start - state.traceStart).count();
+		double duration = std::chrono::duration<double, std::micro>(event.end - event.start).count();
+
+		if(i)
+			stream << ",";
+
+		stream << "\n{\"name\":\"";
+
+		for(char c : event.node->getName())
+		{
+			if(c == '"' || c == '\\')
+				stream << '\\';
+			stream << c;
+		}
+
+		stream << "\",\"cat\":\"audaspace\",\"ph\":\"X\",\"ts\":" << start << ",\"dur\":" << duration << ",\"pid\":1,\"tid\":" << thread->second << "}";
+	}
+
+	stream << "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+	stream.flags(flags);
+	stream.precision(precision);
+}
+
+AUD_NAMESPACE_END